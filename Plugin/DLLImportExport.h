@@ -1,6 +1,8 @@
 #pragma once
 
-#if RLTT_EXPORTS // RL Training Timer exports
+#if !defined(_WIN32)
+	#define RLTT_IMPORT_EXPORT // Outside of Windows, the core library is linked statically (see CMakeLists.txt)
+#elif RLTT_EXPORTS // RL Training Timer exports
 	#define RLTT_IMPORT_EXPORT __declspec(dllexport) // Create a .lib and a .exp file when compiling RLTT
 #else
 	#define RLTT_IMPORT_EXPORT __declspec(dllimport) // Look for an existing .lib when using the DLL somewhere, e.g. in a unit test project
@@ -2,7 +2,13 @@
 #include "RLTrainingTimer.h"
 
 #include <training/control/TrainingProgramFlowControl.h>
+#include <training/control/GameWrapperAdapter.h>
+#include <training/control/CVarManagerAdapter.h>
 #include <configuration/control/TrainingProgramRepository.h>
+#include <history/SessionHistoryRecorder.h>
+#include <statistics/TrainingStatistics.h>
+#include <diagnostics/BackgroundLog.h>
+#include <diagnostics/PerformanceCounters.h>
 
 #include <external/BakkesModWiki/PersistentStorage.h>
 
@@ -19,7 +25,7 @@ void RLTrainingTimer::onLoad()
 	/* CONFIGURATION PART */
 
 	// Allow storing & restoring of training programs
-	auto trainingProgramRepository = std::make_shared<configuration::TrainingProgramRepository>(gameWrapper);
+	auto trainingProgramRepository = configuration::TrainingProgramRepository::createInDataFolder(gameWrapper->GetDataFolder());
 
 	// Allow manipulating the list of training programs
 	auto trainingProgramDataMap = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
@@ -29,8 +35,12 @@ void RLTrainingTimer::onLoad()
 	auto notificationFunc = [trainingProgramListControl]() { trainingProgramListControl->notifyReceivers(); };
 	auto singleTrainingProgramControl = std::make_shared<configuration::TrainingProgramConfigurationControl>(trainingProgramDataMap, notificationFunc);
 
+	// Keep track of available workshop maps in the background, so the UI can suggest maps and missing maps can be reported
+	auto workshopMapIndex = std::make_shared<configuration::WorkshopMapIndex>();
+	trainingProgramListControl->registerTrainingProgramListReceiver(workshopMapIndex); // Rescans whenever the workshop folder changes
+
 	// Initialize the plugin settings UI with those configuration objects
-	initConfigurationUi(gameWrapper, singleTrainingProgramControl, trainingProgramListControl);
+	initConfigurationUi(gameWrapper, singleTrainingProgramControl, trainingProgramListControl, workshopMapIndex);
 
 	/* TRAINING EXECUTION PART */
 
@@ -39,16 +49,111 @@ void RLTrainingTimer::onLoad()
 	auto gameWrapperAdapter = std::make_shared<GameWrapperAdapter>(gameWrapper);
 	auto timeProvider = std::make_shared<SteadyClockTimeProvider>(); // Same here. Unit tests will replace this by a fake
 	auto cvarmanagerAdapter = std::make_shared<CVarManagerAdapter>(cvarManager);
-	auto flowControl = std::make_shared<training::TrainingProgramFlowControl>(gameWrapperAdapter, timeProvider, cvarmanagerAdapter);
+	// The recorder sees every hooked event, but does not record anything unless a trace gets started
+	auto eventTraceRecorder = std::make_shared<training::EventTraceRecorder>(gameWrapperAdapter, timeProvider);
+	auto flowControl = std::make_shared<training::TrainingProgramFlowControl>(eventTraceRecorder, timeProvider, cvarmanagerAdapter);
+	flowControl->setEventTraceRecorder(eventTraceRecorder);
 	trainingProgramListControl->registerTrainingProgramListReceiver(flowControl); // Updates the flow control whenever any training program changes, gets added, gets deleted etc
 	flowControl->hookToEvents();
+	flowControl->setWorkshopMapCheck([workshopMapIndex](const std::string& workshopMapPath) {
+		return workshopMapIndex->containsMap(workshopMapPath).value_or(true); // Don't report anything while the index is still being built
+	});
+
+	// Keep a history of what happened in each session. Records are written in the background, so this does not slow down the game.
+	const auto sessionHistoryPath = gameWrapper->GetDataFolder() / "RLTrainingTimer" / "session_history.bin";
+	auto trainingStatistics = std::make_shared<statistics::TrainingStatistics>(gameWrapper->GetDataFolder() / "RLTrainingTimer" / "statistics.json", sessionHistoryPath);
+	auto sessionHistoryRecorder = std::make_shared<history::SessionHistoryRecorder>(sessionHistoryPath);
+	sessionHistoryRecorder->registerSessionRecordReceiver(trainingStatistics); // Keeps statistics up to date without reading the history again
+	flowControl->registerSessionEventReceiver(sessionHistoryRecorder);
+
+	// The statistics know how long training packs take, so the remaining time of steps which last until a pack is completed can be estimated
+	flowControl->setCompletionTimeEstimator(trainingStatistics);
+
+	cvarManager->registerNotifier("rltt_load_stats", [this, flowControl](const std::vector<std::string>&) {
+		auto counters = flowControl->getLoadCommandCounters();
+		cvarManager->log(fmt::format("Load commands: {} issued, {} suppressed since the map was loaded already", counters.IssuedCommands, counters.SuppressedCommands));
+	}, "Prints how many load commands were skipped because the map was loaded already", PERMISSION_ALL);
+
+	// Allow finding out where the plugin spends its time in the game
+	cvarManager->registerNotifier("rltt_perf_dump", [this](const std::vector<std::string>&) {
+		const auto lines = diagnostics::PerformanceCounters::format();
+		if (lines.empty())
+		{
+			cvarManager->log("No performance measurements since the last dump");
+		}
+		for (const auto& line : lines)
+		{
+			cvarManager->log(line);
+		}
+		diagnostics::PerformanceCounters::reset();
+	}, "Prints how often and how long the main paths of the plugin ran since the last dump, and resets the measurements", PERMISSION_ALL);
+
+	// Allow recording a session so it can be replayed by the unit tests, e.g. for reproducing a bug
+	cvarManager->registerNotifier("rltt_trace_start", [this, eventTraceRecorder, trainingProgramListControl, flowControl](const std::vector<std::string>&) {
+		const auto tracePath = gameWrapper->GetDataFolder() / "RLTrainingTimer" / "traces" / fmt::format("{}.trace", std::chrono::system_clock::now().time_since_epoch().count());
+		try
+		{
+			// The trace contains the training programs and the settings, since they are needed for replaying it.
+			// Take the list which is in memory: Reading the file would make the change detection miss the next change by a sync tool.
+			// Let the replay start where we are now. A program which is already running will be replayed from its start, though.
+			const auto trainingProgramList = trainingProgramListControl->getTrainingProgramList();
+			eventTraceRecorder->start(tracePath);
+			eventTraceRecorder->record(training::TraceEntryType::Command, training::TraceCommand::ReceiveListData, configuration::TrainingProgramRepository::serializeList(trainingProgramList));
+			flowControl->recordTraceHeader();
+			cvarManager->log(fmt::format("Recording event trace to {}", tracePath.string()));
+		}
+		catch (const std::exception& ex)
+		{
+			cvarManager->log(fmt::format("Could not start recording an event trace: {}", ex.what()));
+		}
+	}, "Starts recording everything which drives the training program flow into a trace file", PERMISSION_ALL);
+	cvarManager->registerNotifier("rltt_trace_stop", [this, eventTraceRecorder](const std::vector<std::string>&) {
+		eventTraceRecorder->stop();
+		cvarManager->log("Stopped recording the event trace");
+	}, "Stops recording the event trace", PERMISSION_ALL);
+
+	// Allow recording a timeline of what the plugin does, in order to find out what causes a hitch
+	cvarManager->registerNotifier("rltt_timeline_start", [this](const std::vector<std::string>&) {
+		const auto timelinePath = gameWrapper->GetDataFolder() / "RLTrainingTimer" / "timelines" / fmt::format("{}.json", std::chrono::system_clock::now().time_since_epoch().count());
+		try
+		{
+			diagnostics::TimelineRecorder::start(timelinePath);
+			cvarManager->log(fmt::format("Recording timeline to {}. Open it in chrome://tracing or https://ui.perfetto.dev", timelinePath.string()));
+		}
+		catch (const std::exception& ex)
+		{
+			cvarManager->log(fmt::format("Could not start recording a timeline: {}", ex.what()));
+		}
+	}, "Starts recording hooks, commands, map loads, file writes and UI frames into a Chrome trace event file", PERMISSION_ALL);
+	cvarManager->registerNotifier("rltt_timeline_stop", [this](const std::vector<std::string>&) {
+		diagnostics::TimelineRecorder::stop();
+		cvarManager->log(fmt::format("Stopped recording the timeline ({} events were dropped)", diagnostics::TimelineRecorder::droppedEvents()));
+	}, "Stops recording the timeline", PERMISSION_ALL);
 
 	// Create a plugin window for starting, stopping etc programs. This internally also creates an overlay which is displayed while training is being executed
-	initTrainingProgramFlowControlUi(gameWrapper, flowControl, cvarManager, _globalPersistentStorage);
+	initTrainingProgramFlowControlUi(gameWrapper, flowControl, cvarManager, _globalPersistentStorage, trainingStatistics);
 
 	// Restore any previously stored training program
 	trainingProgramListControl->restoreWholeTrainingProgramList();
 
+	// Pick up changes to the training program list which were made outside of the game, e.g. by a sync tool.
+	// Nobody notices if that takes half a second, so there is no need to ask the file system on every frame.
+	gameWrapper->HookEvent("Function Engine.GameViewportClient.Tick", [trainingProgramListControl, flowControl, workshopMapIndex, knownNumberOfScans = uint64_t(0), nextCheckTime = std::chrono::steady_clock::time_point()](const std::string&) mutable {
+		diagnostics::BackgroundLog::writeToConsole(); // Background threads must not use the console themselves
+
+		// Missing maps of the selected program were checked against an index which was incomplete or outdated
+		if (const auto numberOfScans = workshopMapIndex->numberOfCompletedScans(); numberOfScans != knownNumberOfScans)
+		{
+			knownNumberOfScans = numberOfScans;
+			flowControl->refreshMissingWorkshopMaps();
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now < nextCheckTime) { return; }
+		nextCheckTime = now + std::chrono::milliseconds(500);
+		trainingProgramListControl->mergeExternalChanges();
+	});
+
 	// Allow injection of training programs from other plugins (prejump plug in as a minimum)
 	_trainingProgramInjector = std::make_shared<injection::TrainingProgramInjector>(
 		cvarManager,
@@ -63,5 +168,6 @@ void RLTrainingTimer::onLoad()
 
 void RLTrainingTimer::onUnload()
 {
+	diagnostics::TimelineRecorder::stop(); // The writer thread must not outlive the plugin
 	cvarManager->log("Unloaded RLTrainingTimer plugin");
 }
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <pch.h>
+#include "CrashSafeFileStorage.h"
+#include "TrainingProgramHasher.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	const std::string BackupHeaderTag = "RLTT-BACKUP";
+
+	std::optional<std::string> readFile(const std::filesystem::path& path)
+	{
+		std::error_code errorCode;
+		const auto fileSize = std::filesystem::file_size(path, errorCode);
+		if (errorCode) { return {}; }
+
+		std::string contents;
+		contents.resize((size_t)fileSize);
+		std::ifstream is{ path, std::ios::binary };
+		is.read(contents.data(), (std::streamsize)contents.size());
+		if (!is) { return {}; }
+		return contents;
+	}
+
+	/** Creates the first line of a backup file, which allows detecting backups which were not written completely. */
+	std::string createBackupHeader(const std::string& contents)
+	{
+		return fmt::format("{} {:016x} {}\n", BackupHeaderTag, configuration::TrainingProgramHasher::hashText(contents), contents.size());
+	}
+
+	/** Makes sure the contents of the given file are on the disk rather than just in the cache of the operating system, so they survive a power loss. */
+	bool syncToDisk(const std::filesystem::path& path)
+	{
+#ifdef _WIN32
+		auto handle = CreateFileW(path.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handle == INVALID_HANDLE_VALUE) { return false; }
+		const auto success = FlushFileBuffers(handle) != FALSE;
+		CloseHandle(handle);
+		return success;
+#else
+		const auto descriptor = open(path.c_str(), O_RDONLY);
+		if (descriptor < 0) { return false; }
+		const auto success = fsync(descriptor) == 0;
+		close(descriptor);
+		return success;
+#endif
+	}
+}
+
+namespace configuration
+{
+	CrashSafeFileStorage::CrashSafeFileStorage(std::filesystem::path path, size_t numberOfBackups, std::chrono::steady_clock::duration backupInterval)
+		: _path(std::move(path))
+		, _numberOfBackups(numberOfBackups)
+		, _backupInterval(backupInterval)
+	{
+	}
+
+	void CrashSafeFileStorage::write(const std::string& contents)
+	{
+		const auto now = std::chrono::steady_clock::now();
+		if (_numberOfBackups > 0 && (!_lastBackupTime.has_value() || now - _lastBackupTime.value() >= _backupInterval))
+		{
+			// Back up what is about to be replaced, so a bad write can be undone
+			if (auto previousContents = readFile(_path); previousContents.has_value())
+			{
+				rotateBackups();
+				writeAtomically(backupPath(1), createBackupHeader(previousContents.value()) + previousContents.value());
+			}
+			_lastBackupTime = now;
+		}
+		writeAtomically(_path, contents);
+	}
+
+	std::optional<std::string> CrashSafeFileStorage::read(const std::function<bool(const std::string&)>& isValid) const
+	{
+		if (!std::filesystem::exists(_path)) { return {}; }
+
+		if (auto contents = readFile(_path); contents.has_value() && isValid(contents.value()))
+		{
+			return contents;
+		}
+
+		// Keep the broken file so nothing gets lost when the next write replaces it
+		LOG("WARNING: {} is damaged. Trying to recover from a backup", _path.string());
+		auto brokenFilePath = _path;
+		brokenFilePath += ".broken";
+		std::error_code errorCode;
+		std::filesystem::copy_file(_path, brokenFilePath, std::filesystem::copy_options::overwrite_existing, errorCode);
+
+		for (size_t backupNumber = 1; backupNumber <= _numberOfBackups; backupNumber++)
+		{
+			if (auto contents = readBackup(backupNumber); contents.has_value() && isValid(contents.value()))
+			{
+				LOG("Recovered {} from backup number {}", _path.string(), backupNumber);
+				return contents;
+			}
+		}
+
+		LOG("ERROR: Could not recover {} from any backup. The damaged file is available at {}", _path.string(), brokenFilePath.string());
+		return {};
+	}
+
+	void CrashSafeFileStorage::writeAtomically(const std::filesystem::path& path, const std::string& contents)
+	{
+		auto temporaryPath = path;
+		temporaryPath += ".tmp";
+		{
+			std::ofstream os{ temporaryPath, std::ios::binary | std::ios::trunc };
+			os.write(contents.data(), (std::streamsize)contents.size());
+			os.flush();
+			if (!os)
+			{
+				throw std::runtime_error(fmt::format("Could not write {}", temporaryPath.string()));
+			}
+		}
+		// Otherwise, a power loss right after renaming could leave an empty file behind
+		if (!syncToDisk(temporaryPath))
+		{
+			throw std::runtime_error(fmt::format("Could not flush {} to disk", temporaryPath.string()));
+		}
+
+		// Replacing a file by renaming is atomic, so the file will either have its old or its new contents, even if the game crashes right now
+		std::error_code errorCode;
+		std::filesystem::rename(temporaryPath, path, errorCode);
+		if (errorCode)
+		{
+			throw std::runtime_error(fmt::format("Could not replace {}: {}", path.string(), errorCode.message()));
+		}
+	}
+
+	std::filesystem::path CrashSafeFileStorage::backupPath(size_t backupNumber) const
+	{
+		auto path = _path;
+		path += fmt::format(".bak{}", backupNumber);
+		return path;
+	}
+
+	void CrashSafeFileStorage::rotateBackups() const
+	{
+		// Shift every backup by one, dropping the oldest one. Errors are ignored since a missing backup is not a reason for not storing data.
+		std::error_code errorCode;
+		std::filesystem::remove(backupPath(_numberOfBackups), errorCode);
+		for (auto backupNumber = _numberOfBackups; backupNumber > 1; backupNumber--)
+		{
+			if (std::filesystem::exists(backupPath(backupNumber - 1)))
+			{
+				std::filesystem::rename(backupPath(backupNumber - 1), backupPath(backupNumber), errorCode);
+			}
+		}
+	}
+
+	std::optional<std::string> CrashSafeFileStorage::readBackup(size_t backupNumber) const
+	{
+		auto backup = readFile(backupPath(backupNumber));
+		if (!backup.has_value()) { return {}; }
+
+		const auto headerEnd = backup->find('\n');
+		if (headerEnd == std::string::npos) { return {}; }
+
+		auto contents = backup->substr(headerEnd + 1);
+		if (backup->compare(0, headerEnd + 1, createBackupHeader(contents)) != 0)
+		{
+			LOG("Backup number {} of {} has an invalid checksum", backupNumber, _path.string());
+			return {};
+		}
+		return contents;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace configuration
+{
+	/**
+	 * The job of this class is to store the contents of a single file in a way that neither a crash of the game nor a full disk can destroy it.
+	 *
+	 * - The file is never written in place: New contents go to a temporary file first, which gets flushed to disk and then replaces the original file.
+	 * - The first write, and the first write after every backup interval, additionally copies the file which is about to be replaced into a backup with a checksum.
+	 *   Only the newest few backups are kept.
+	 *   Backups therefore cover several sessions rather than the last few edits, and most writes only cost a single file.
+	 * - When reading, a file which is missing parts or can't be used by the caller is replaced by the newest valid backup.
+	 */
+	class RLTT_IMPORT_EXPORT CrashSafeFileStorage
+	{
+	public:
+		/** Constructor. */
+		explicit CrashSafeFileStorage(std::filesystem::path path, size_t numberOfBackups = 5, std::chrono::steady_clock::duration backupInterval = std::chrono::minutes(30));
+
+		/** Replaces the file by the given contents. If the backup interval has passed, the previous contents become the newest backup. Throws std::runtime_error if anything could not be written. */
+		void write(const std::string& contents);
+
+		/**
+		 * Reads the file. If the file is rejected by the validator, the newest backup which has a valid checksum and is accepted by the validator is returned instead.
+		 * In that case, a copy of the broken file is kept next to it for manual inspection.
+		 * Returns nothing if the file does not exist, or if neither the file nor any backup is valid.
+		 */
+		std::optional<std::string> read(const std::function<bool(const std::string&)>& isValid) const;
+
+		/** Writes the given contents to a temporary file, flushes it to disk and replaces the file at the given path with it. Throws std::runtime_error on failure. */
+		static void writeAtomically(const std::filesystem::path& path, const std::string& contents);
+
+		/** Retrieves the path of the file. */
+		inline const std::filesystem::path& path() const { return _path; }
+		/** Retrieves the path of the backup with the given number, where 1 is the newest backup. */
+		std::filesystem::path backupPath(size_t backupNumber) const;
+
+	private:
+		void rotateBackups() const;
+		std::optional<std::string> readBackup(size_t backupNumber) const;
+
+		std::filesystem::path _path;
+		size_t _numberOfBackups;
+		std::chrono::steady_clock::duration _backupInterval;
+		std::optional<std::chrono::steady_clock::time_point> _lastBackupTime; // Not set until the first write
+	};
+}
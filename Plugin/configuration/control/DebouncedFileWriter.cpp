@@ -0,0 +1,104 @@
+#include <pch.h>
+#include "DebouncedFileWriter.h"
+#include <diagnostics/BackgroundLog.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace configuration
+{
+	DebouncedFileWriter::DebouncedFileWriter(std::filesystem::path path, std::chrono::milliseconds quietPeriod)
+		: DebouncedFileWriter(CrashSafeFileStorage(std::move(path), 0), quietPeriod)
+	{
+	}
+
+	DebouncedFileWriter::DebouncedFileWriter(CrashSafeFileStorage storage, std::chrono::milliseconds quietPeriod)
+		: _quietPeriod(quietPeriod)
+		, _storage(std::move(storage))
+	{
+		// Writing what is in the file already would be pointless
+		if (std::ifstream existingFile{ _storage.path(), std::ios::binary }; existingFile)
+		{
+			std::ostringstream contents;
+			contents << existingFile.rdbuf();
+			_writtenContents = contents.str();
+		}
+		_writerThread = std::thread([this]() { runWriter(); });
+	}
+
+	DebouncedFileWriter::~DebouncedFileWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_writerShallStop = true; // The writer will still write pending contents before stopping
+		}
+		_writerCondition.notify_all();
+		_writerThread.join();
+	}
+
+	void DebouncedFileWriter::write(std::string contents)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_pendingContents = std::move(contents);
+			_lastChangeTime = std::chrono::steady_clock::now();
+		}
+		_writerCondition.notify_all();
+	}
+
+	void DebouncedFileWriter::flush()
+	{
+		std::unique_lock<std::mutex> lock(_writerMutex);
+		_flushIsRequested = true;
+		_writerCondition.notify_all();
+		_writerCondition.wait(lock, [this]() { return !_pendingContents.has_value() && !_writeIsInProgress; });
+		_flushIsRequested = false;
+	}
+
+	size_t DebouncedFileWriter::numberOfWrites() const
+	{
+		return _numberOfWrites;
+	}
+
+	void DebouncedFileWriter::runWriter()
+	{
+		std::unique_lock<std::mutex> lock(_writerMutex);
+		while (true)
+		{
+			_writerCondition.wait(lock, [this]() { return _pendingContents.has_value() || _writerShallStop; });
+			if (!_pendingContents.has_value())
+			{
+				return; // Stop was requested and there is nothing left to write
+			}
+
+			// Wait until the contents stop changing. Every change pushes the deadline back.
+			while (!_writerShallStop && !_flushIsRequested && std::chrono::steady_clock::now() < _lastChangeTime + _quietPeriod)
+			{
+				_writerCondition.wait_until(lock, _lastChangeTime + _quietPeriod);
+			}
+
+			auto contents = std::move(_pendingContents.value());
+			_pendingContents.reset();
+			_writeIsInProgress = true;
+			lock.unlock();
+
+			if (contents != _writtenContents)
+			{
+				try
+				{
+					_storage.write(contents);
+					_writtenContents = std::move(contents);
+					_numberOfWrites++;
+				}
+				catch (const std::exception& ex)
+				{
+					diagnostics::BackgroundLog::post(fmt::format("ERROR: Failed writing {}: {}", _storage.path().string(), ex.what()));
+				}
+			}
+
+			lock.lock();
+			_writeIsInProgress = false;
+			_writerCondition.notify_all();
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CrashSafeFileStorage.h"
+
+#include <DLLImportExport.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace configuration
+{
+	/**
+	 * The job of this class is to write a small file whose contents change in bursts, e.g. a cfg file while the player drags a slider.
+	 *
+	 * Contents are written by a background thread once no new contents have arrived for a quiet period, so a burst of changes causes a single write.
+	 * Contents which match what is in the file already are not written at all. The file is always replaced atomically.
+	 */
+	class RLTT_IMPORT_EXPORT DebouncedFileWriter
+	{
+	public:
+		/** Constructor. Writes to the given path once no new contents have arrived for the given quiet period. */
+		explicit DebouncedFileWriter(std::filesystem::path path, std::chrono::milliseconds quietPeriod = std::chrono::milliseconds(500));
+		/** Constructor. Writes through the given storage, which keeps backups, once no new contents have arrived for the given quiet period. */
+		explicit DebouncedFileWriter(CrashSafeFileStorage storage, std::chrono::milliseconds quietPeriod = std::chrono::milliseconds(500));
+		/** Destructor. Writes pending contents without waiting for the quiet period. */
+		~DebouncedFileWriter();
+
+		DebouncedFileWriter(const DebouncedFileWriter&) = delete;
+		DebouncedFileWriter& operator=(const DebouncedFileWriter&) = delete;
+
+		/** Replaces the contents which shall be written. Returns immediately, and replaces any contents which have not been written yet. */
+		void write(std::string contents);
+		/** Writes pending contents without waiting for the quiet period, and blocks until they are on disk. */
+		void flush();
+		/** Retrieves how often the file has actually been written. */
+		size_t numberOfWrites() const;
+
+	private:
+		void runWriter();
+
+		std::chrono::milliseconds _quietPeriod;
+		CrashSafeFileStorage _storage; // Only accessed by the writer thread after construction
+		std::string _writtenContents; // Only accessed by the writer thread after construction
+		std::atomic<size_t> _numberOfWrites = 0;
+
+		std::thread _writerThread;
+		std::mutex _writerMutex; // Protects everything below
+		std::condition_variable _writerCondition;
+		std::optional<std::string> _pendingContents;
+		std::chrono::steady_clock::time_point _lastChangeTime;
+		bool _writeIsInProgress = false;
+		bool _flushIsRequested = false;
+		bool _writerShallStop = false;
+	};
+}
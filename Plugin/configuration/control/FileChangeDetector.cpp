@@ -0,0 +1,52 @@
+#include <pch.h>
+#include "FileChangeDetector.h"
+#include "TrainingProgramHasher.h"
+
+namespace configuration
+{
+	FileChangeDetector::FileChangeDetector(std::filesystem::path path, std::shared_ptr<IFileChangeBackend> backend)
+		: _path(std::move(path))
+		, _backend(std::move(backend))
+	{
+	}
+
+	std::optional<std::string> FileChangeDetector::detectChange()
+	{
+		std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+		if (!lock.owns_lock()) { return {}; } // We are writing the file ourselves right now. Don't wait for that, just check again later
+		if (!_backend->mightHaveChanged()) { return {}; }
+
+		auto signature = _backend->getSignature(_path);
+		if (!signature.has_value() || signature == _knownSignature)
+		{
+			return {}; // A missing file will simply be created on the next write
+		}
+		_knownSignature = signature;
+
+		auto contents = _backend->readFile(_path);
+		if (!contents.has_value()) { return {}; }
+
+		auto contentHash = TrainingProgramHasher::hashText(contents.value());
+		if (contentHash == _knownContentHash)
+		{
+			return {}; // e.g. the file was only touched, or saved without changes
+		}
+		_knownContentHash = contentHash;
+		return contents;
+	}
+
+	void FileChangeDetector::acknowledge(const std::string& contents)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_knownContentHash = TrainingProgramHasher::hashText(contents);
+		_knownSignature = _backend->getSignature(_path);
+	}
+
+	void FileChangeDetector::writeOwnChange(const std::string& contents, const std::function<void()>& write)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_knownContentHash = TrainingProgramHasher::hashText(contents);
+		write();
+		_knownSignature = _backend->getSignature(_path);
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "IFileChangeBackend.h"
+
+#include <DLLImportExport.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace configuration
+{
+	/**
+	 * The job of this class is to detect when a file was changed by someone else, e.g. by a sync tool or by a user editing it manually.
+	 *
+	 * The file is only read if the backend reports activity and its size or modification time changed. Changes which
+	 * don't change the contents (or which restore what we wrote ourselves) are detected by a content hash and ignored.
+	 */
+	class RLTT_IMPORT_EXPORT FileChangeDetector
+	{
+	public:
+		/** Constructor. */
+		FileChangeDetector(std::filesystem::path path, std::shared_ptr<IFileChangeBackend> backend);
+
+		/** Returns the new contents of the file if they changed since the last call of this method or of acknowledge(). Returns nothing while writeOwnChange() is in progress. */
+		std::optional<std::string> detectChange();
+
+		/** Remembers the given contents as the current state of the file. Call this after reading the file yourself. */
+		void acknowledge(const std::string& contents);
+
+		/**
+		 * Calls the given function, which must write the given contents to the file, and remembers them as the current state of the file.
+		 * The contents are acknowledged before writing, and detectChange() can't run in between, so our own write can never be mistaken for an external change.
+		 */
+		void writeOwnChange(const std::string& contents, const std::function<void()>& write);
+
+	private:
+		std::filesystem::path _path;
+		std::shared_ptr<IFileChangeBackend> _backend;
+		std::optional<FileSignature> _knownSignature;
+		uint64_t _knownContentHash = 0; // 0 = unknown
+		std::mutex _mutex; // Files get written on a different thread than the one which checks for changes
+	};
+}
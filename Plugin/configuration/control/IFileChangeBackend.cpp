@@ -0,0 +1,109 @@
+#include <pch.h>
+#include "IFileChangeBackend.h"
+
+#include <fstream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace configuration
+{
+	PollingFileChangeBackend::PollingFileChangeBackend(std::chrono::milliseconds pollingInterval)
+		: _pollingInterval(pollingInterval)
+	{
+	}
+
+	bool PollingFileChangeBackend::mightHaveChanged()
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (now < _nextPollingTime) { return false; }
+
+		_nextPollingTime = now + _pollingInterval;
+		return true;
+	}
+
+	std::optional<FileSignature> PollingFileChangeBackend::getSignature(const std::filesystem::path& path) const
+	{
+		std::error_code errorCode;
+		FileSignature signature;
+		signature.LastWriteTime = std::filesystem::last_write_time(path, errorCode);
+		if (errorCode) { return {}; }
+		signature.Size = std::filesystem::file_size(path, errorCode);
+		if (errorCode) { return {}; }
+		return signature;
+	}
+
+	std::optional<std::string> PollingFileChangeBackend::readFile(const std::filesystem::path& path) const
+	{
+		std::ifstream is{ path, std::ios::binary };
+		if (!is) { return {}; }
+		return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+	}
+
+	DirectoryNotificationFileChangeBackend::DirectoryNotificationFileChangeBackend(const std::filesystem::path& folderPath)
+		: PollingFileChangeBackend()
+	{
+#ifdef _WIN32
+		auto handle = FindFirstChangeNotificationW(folderPath.wstring().c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME);
+		if (handle == INVALID_HANDLE_VALUE)
+		{
+			LOG("Could not watch {} for changes. Falling back to polling", folderPath.string());
+			return;
+		}
+		_notificationHandle = handle;
+#elif defined(__linux__)
+		_notificationDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_notificationDescriptor < 0 || inotify_add_watch(_notificationDescriptor, folderPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0)
+		{
+			LOG("Could not watch {} for changes. Falling back to polling", folderPath.string());
+			if (_notificationDescriptor >= 0) { close(_notificationDescriptor); }
+			_notificationDescriptor = -1;
+		}
+#else
+		LOG("Watching {} for changes is not supported on this platform. Falling back to polling", folderPath.string());
+#endif
+	}
+
+	DirectoryNotificationFileChangeBackend::~DirectoryNotificationFileChangeBackend()
+	{
+#ifdef _WIN32
+		if (_notificationHandle != nullptr)
+		{
+			FindCloseChangeNotification(_notificationHandle);
+		}
+#elif defined(__linux__)
+		if (_notificationDescriptor >= 0)
+		{
+			close(_notificationDescriptor);
+		}
+#endif
+	}
+
+	bool DirectoryNotificationFileChangeBackend::mightHaveChanged()
+	{
+#ifdef _WIN32
+		if (_notificationHandle != nullptr)
+		{
+			// Don't wait, just check if the notification was signaled, and rearm it in that case
+			if (WaitForSingleObject(_notificationHandle, 0) != WAIT_OBJECT_0) { return false; }
+			FindNextChangeNotification(_notificationHandle);
+			return true;
+		}
+#elif defined(__linux__)
+		if (_notificationDescriptor >= 0)
+		{
+			// Don't wait, just drain all pending events. Any event means something in the folder changed
+			alignas(inotify_event) char events[4096];
+			auto anythingChanged = false;
+			while (read(_notificationDescriptor, events, sizeof(events)) > 0)
+			{
+				anythingChanged = true;
+			}
+			return anythingChanged;
+		}
+#endif
+		return PollingFileChangeBackend::mightHaveChanged();
+	}
+}
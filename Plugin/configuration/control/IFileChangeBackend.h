@@ -0,0 +1,67 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace configuration
+{
+	/** The properties of a file which can be retrieved without reading it. */
+	struct FileSignature
+	{
+		std::filesystem::file_time_type LastWriteTime;
+		uintmax_t Size = 0;
+
+		bool operator==(const FileSignature& other) const { return LastWriteTime == other.LastWriteTime && Size == other.Size; }
+		bool operator!=(const FileSignature& other) const { return !(*this == other); }
+	};
+
+	/** This interface allows detecting changes to files in different ways, and allows faking the file system in unit tests. */
+	class IFileChangeBackend
+	{
+	protected:
+		IFileChangeBackend() = default;
+
+	public:
+		virtual ~IFileChangeBackend() = default;
+
+		/** Returns false if nothing in the watched folder can have changed since the last call. This gets called very often, so it must be cheap. */
+		virtual bool mightHaveChanged() = 0;
+		/** Retrieves the size and modification time of the given file, or nothing if it does not exist. */
+		virtual std::optional<FileSignature> getSignature(const std::filesystem::path& path) const = 0;
+		/** Reads the whole file, or returns nothing if it could not be read. */
+		virtual std::optional<std::string> readFile(const std::filesystem::path& path) const = 0;
+	};
+
+	/** Checks the file system at a fixed interval. Works everywhere, but notices changes with a delay. */
+	class RLTT_IMPORT_EXPORT PollingFileChangeBackend : public IFileChangeBackend
+	{
+	public:
+		explicit PollingFileChangeBackend(std::chrono::milliseconds pollingInterval = std::chrono::seconds(2));
+
+		bool mightHaveChanged() override;
+		std::optional<FileSignature> getSignature(const std::filesystem::path& path) const override;
+		std::optional<std::string> readFile(const std::filesystem::path& path) const override;
+
+	private:
+		std::chrono::milliseconds _pollingInterval;
+		std::chrono::steady_clock::time_point _nextPollingTime = {};
+	};
+
+	/** Lets the operating system tell us when anything in the folder changed. Falls back to polling if the folder can't be watched. */
+	class RLTT_IMPORT_EXPORT DirectoryNotificationFileChangeBackend : public PollingFileChangeBackend
+	{
+	public:
+		explicit DirectoryNotificationFileChangeBackend(const std::filesystem::path& folderPath);
+		~DirectoryNotificationFileChangeBackend();
+
+		bool mightHaveChanged() override;
+
+	private:
+		void* _notificationHandle = nullptr; // A HANDLE, but we don't want to include Windows.h here
+		int _notificationDescriptor = -1; // An inotify file descriptor on Linux, where tests and benchmarks run
+	};
+}
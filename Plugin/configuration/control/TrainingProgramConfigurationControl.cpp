@@ -1,5 +1,6 @@
 #include <pch.h>
 #include "TrainingProgramConfigurationControl.h"
+#include "TrainingProgramHasher.h"
 
 template <typename T>
 void remove(std::vector<T>& vec, size_t pos)
@@ -28,7 +29,7 @@ namespace configuration
             data->Duration += entry.Duration;
         }
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::removeEntry(const std::string& trainingProgramId, int position)
@@ -43,7 +44,7 @@ namespace configuration
         }
         remove(data->Entries, position);
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::renameEntry(const std::string& trainingProgramId, int position, const std::string& newName)
@@ -53,7 +54,7 @@ namespace configuration
 
         data->Entries.at(position).Name = newName;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::changeEntryDuration(const std::string& trainingProgramId, int position, const std::chrono::milliseconds& newDuration)
@@ -70,7 +71,7 @@ namespace configuration
         // Store the duration in either case, in case the time mode is changed back to Timed
         affectedEntry.Duration = newDuration;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::swapEntries(const std::string& trainingProgramId, int firstPosition, int secondPosition)
@@ -82,7 +83,7 @@ namespace configuration
         std::swap(data->Entries[firstPosition], data->Entries[secondPosition]);
         // Duration will stay identical, no need to update it
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::changeEntryType(const std::string& trainingProgramId, int position, TrainingProgramEntryType type)
@@ -98,7 +99,7 @@ namespace configuration
         auto& affectedEntry = data->Entries.at(position);
         affectedEntry.Type = type;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::changeEntryCompletionMode(const std::string& trainingProgramId, int position, TrainingProgramCompletionMode CompletionMode)
@@ -119,7 +120,7 @@ namespace configuration
         }
         affectedEntry.TimeMode = CompletionMode;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::changeTrainingPackCode(const std::string& trainingProgramId, int position, const std::string& trainingPackCode)
@@ -129,7 +130,7 @@ namespace configuration
 
         data->Entries.at(position).TrainingPackCode = trainingPackCode;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::changeWorkshopMapPath(const std::string& trainingProgramId, int position, const std::string& workshopMapPath)
@@ -139,7 +140,7 @@ namespace configuration
 
         data->Entries.at(position).WorkshopMapPath = workshopMapPath;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     void TrainingProgramConfigurationControl::renameProgram(const std::string& trainingProgramId, const std::string& newName)
@@ -147,7 +148,7 @@ namespace configuration
         auto data = internalData(trainingProgramId);
         data->Name = newName;
 
-        _changeNotificationCallback();
+        notifyIfChanged(data);
     }
 
     TrainingProgramData TrainingProgramConfigurationControl::getData(const std::string& trainingProgramId) const
@@ -155,6 +156,15 @@ namespace configuration
         return *internalData(trainingProgramId);
     }
 
+    std::optional<uint64_t> TrainingProgramConfigurationControl::getContentHash(const std::string& trainingProgramId) const
+    {
+        if (auto iter = _trainingProgramData->find(trainingProgramId); iter != _trainingProgramData->end())
+        {
+            return iter->second.ContentHash;
+        }
+        return {};
+    }
+
     TrainingProgramData* TrainingProgramConfigurationControl::internalData(const std::string& trainingProgramId) const
     {
         if (_trainingProgramData->count(trainingProgramId) == 0)
@@ -164,6 +174,18 @@ namespace configuration
         return &(*_trainingProgramData)[trainingProgramId];
     }
     
+    void TrainingProgramConfigurationControl::notifyIfChanged(TrainingProgramData* data)
+    {
+        const auto newHash = TrainingProgramHasher::hashProgram(*data);
+        if (newHash == data->ContentHash)
+        {
+            return; // e.g. the same value was selected again. There is no need to notify anyone or write anything.
+        }
+        data->ContentHash = newHash;
+
+        _changeNotificationCallback();
+    }
+
     void TrainingProgramConfigurationControl::validatePosition(const TrainingProgramData* const data, int position, const std::string& variableName) const
     {
         if (position < 0 || position >= data->Entries.size())
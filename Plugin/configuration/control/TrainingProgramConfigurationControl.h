@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <functional>
+#include <optional>
 
 #include <DLLImportExport.h>
 
@@ -56,12 +57,18 @@ namespace configuration
 		/** Retrieves a copy of the training program data for the given ID. */
 		TrainingProgramData getData(const std::string& trainingProgramId) const;
 
+		/** Retrieves the content hash of the given training program, or nothing if the training program does not exist (anymore). */
+		std::optional<uint64_t> getContentHash(const std::string& trainingProgramId) const;
+
 	private:
 
 		TrainingProgramData* internalData(const std::string& trainingProgramId) const;
 
 		void validatePosition(const TrainingProgramData* const data, int position, const std::string& variableName) const;
 
+		/** Updates the content hash of the training program and notifies about the change, unless the content did not actually change. */
+		void notifyIfChanged(TrainingProgramData* data);
+
 		std::shared_ptr<std::map<std::string, TrainingProgramData>> _trainingProgramData;
 		std::function<void()> _changeNotificationCallback;
 
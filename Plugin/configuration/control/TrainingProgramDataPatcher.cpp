@@ -38,13 +38,15 @@ namespace configuration
 		auto& trainingProgramListData = deserialized["TrainingProgramData"];
 
 		std::unordered_map<uint64_t, std::string> oldToNewIdMap;
+		const auto newIds = uuid_generator::generate(trainingProgramListData.size());
+		auto nextNewId = newIds.begin();
 
 		for (auto& trainingProgram : trainingProgramListData) {
 			LOG("Reading training program data");
 			auto& trainingProgramData = trainingProgram.at(1);
 			LOG("Replacing ID by uuid");
 			auto oldId = trainingProgramData["Id"].get<uint64_t>();
-			auto newId = uuid_generator::generateUUID();
+			auto newId = uuids::to_string(*nextNewId++);
 			trainingProgramData["Id"] = newId;
 			trainingProgram.at(0) = newId;
 
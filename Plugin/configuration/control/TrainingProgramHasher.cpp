@@ -0,0 +1,116 @@
+#include <pch.h>
+#include "TrainingProgramHasher.h"
+
+namespace
+{
+	// 64 bit FNV-1a (see http://www.isthe.com/chongo/tech/comp/fnv/)
+	constexpr uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+	constexpr uint64_t FnvPrime = 1099511628211ULL;
+
+	/** Feeds values into an FNV-1a hash. Strings are prefixed with their length so adjacent fields can't be confused with each other. */
+	class HashBuilder
+	{
+	public:
+		HashBuilder& add(const void* data, size_t size)
+		{
+			const auto bytes = static_cast<const unsigned char*>(data);
+			for (size_t index = 0; index < size; index++)
+			{
+				_hash ^= bytes[index];
+				_hash *= FnvPrime;
+			}
+			return *this;
+		}
+		HashBuilder& add(uint64_t value)
+		{
+			unsigned char bytes[8];
+			for (auto index = 0; index < 8; index++)
+			{
+				bytes[index] = (unsigned char)(value >> (index * 8)); // Little endian independent of the platform
+			}
+			return add(bytes, sizeof(bytes));
+		}
+		HashBuilder& add(const std::string& value)
+		{
+			add((uint64_t)value.size());
+			return add(value.data(), value.size());
+		}
+
+		uint64_t result() const { return _hash == 0 ? 1 : _hash; } // Zero is reserved for "unknown"
+
+	private:
+		uint64_t _hash = FnvOffsetBasis;
+	};
+}
+
+namespace configuration
+{
+	uint64_t TrainingProgramHasher::hashEntry(const TrainingProgramEntry& entry)
+	{
+		const auto& variance = entry.Variance;
+		return HashBuilder()
+			.add(entry.Name)
+			.add((uint64_t)entry.Type)
+			.add(entry.TrainingPackCode)
+			.add(entry.WorkshopMapPath)
+			.add((uint64_t)entry.TimeMode)
+			.add((uint64_t)entry.Duration.count())
+			.add(entry.Notes)
+			.add((uint64_t)variance.UseDefaultSettings)
+			.add(variance.EnableTraining)
+			.add(variance.LimitBoost)
+			.add(variance.AllowMirror)
+			.add(variance.PlayerVelocity)
+			.add(variance.VarSpeed)
+			.add(variance.VarLoc)
+			.add(variance.VarLocZ)
+			.add(variance.Shuffle)
+			.add(variance.VarCarLoc)
+			.add(variance.VarCarRot)
+			.add(variance.VarSpin)
+			.add(variance.VarRot)
+			.result();
+	}
+
+	uint64_t TrainingProgramHasher::hashProgram(const TrainingProgramData& data)
+	{
+		auto builder = HashBuilder();
+		builder
+			.add(data.Id)
+			.add(data.Name)
+			.add(data.Description)
+			.add((uint64_t)data.Duration.count())
+			.add((uint64_t)data.ReadOnly)
+			.add((uint64_t)data.Entries.size());
+		for (const auto& entry : data.Entries)
+		{
+			builder.add(hashEntry(entry));
+		}
+		return builder.result();
+	}
+
+	uint64_t TrainingProgramHasher::hashList(
+		const std::vector<std::string>& trainingProgramOrder,
+		const std::string& workshopFolderLocation,
+		const std::map<std::string, TrainingProgramData>& trainingProgramData)
+	{
+		auto builder = HashBuilder();
+		builder
+			.add(workshopFolderLocation)
+			.add((uint64_t)trainingProgramOrder.size());
+		for (const auto& trainingProgramId : trainingProgramOrder)
+		{
+			builder.add(trainingProgramId);
+			if (auto iter = trainingProgramData.find(trainingProgramId); iter != trainingProgramData.end())
+			{
+				builder.add(iter->second.ContentHash);
+			}
+		}
+		return builder.result();
+	}
+
+	uint64_t TrainingProgramHasher::hashText(const std::string& text)
+	{
+		return HashBuilder().add(text).result();
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../data/TrainingProgramData.h"
+
+#include <map>
+#include <cstdint>
+
+#include <DLLImportExport.h>
+
+namespace configuration
+{
+	/**
+	 * The job of this class is to calculate content hashes of training programs. The hashes are stable across sessions and machines,
+	 * so they can be used for detecting changes, but also for finding duplicates or comparing local and remote training programs.
+	 *
+	 * A hash value of zero is never produced and can therefore be used for "unknown".
+	 */
+	class RLTT_IMPORT_EXPORT TrainingProgramHasher
+	{
+	public:
+		/** Calculates the hash of a single training program entry. */
+		static uint64_t hashEntry(const TrainingProgramEntry& entry);
+
+		/** Calculates the hash of a whole training program, including all of its entries. The ContentHash member is not part of the hash. */
+		static uint64_t hashProgram(const TrainingProgramData& data);
+
+		/** Calculates the hash of a training program list. This relies on the ContentHash members of the training programs being up to date. */
+		static uint64_t hashList(
+			const std::vector<std::string>& trainingProgramOrder,
+			const std::string& workshopFolderLocation,
+			const std::map<std::string, TrainingProgramData>& trainingProgramData);
+
+		/** Calculates the hash of arbitrary text, e.g. for checksums of stored files. */
+		static uint64_t hashText(const std::string& text);
+	};
+}
@@ -3,6 +3,8 @@
 #include <pch.h>
 #include "TrainingProgramListConfigurationControl.h"
 #include "uuid_generator.h"
+#include "TrainingProgramHasher.h"
+#include <diagnostics/PerformanceCounters.h>
 
 
 template <typename T>
@@ -30,6 +32,7 @@ namespace configuration
     void TrainingProgramListConfigurationControl::registerTrainingProgramListReceiver(std::shared_ptr<ITrainingProgramListReceiver> receiver)
     {
         _receivers.push_back(receiver);
+        _lastNotifiedListHash.reset(); // Make sure the new receiver gets data on the next notification
     }
 
     std::string TrainingProgramListConfigurationControl::addTrainingProgram()
@@ -38,6 +41,7 @@ namespace configuration
         data.Id = uuid_generator::generateUUID();
         data.Name = "New Training Program";
         data.Duration = std::chrono::milliseconds(0);
+        data.ContentHash = TrainingProgramHasher::hashProgram(data);
 
         _trainingProgramData->emplace(data.Id, data);
         _trainingProgramOrder.push_back(data.Id);
@@ -85,10 +89,50 @@ namespace configuration
 
     void TrainingProgramListConfigurationControl::injectTrainingProgram(const TrainingProgramData& data)
     {
+        if (injectWithoutNotification(data) == InjectionResult::Unchanged)
+        {
+            return;
+        }
+        notifyReceivers();
+
+        LOG("Successfully injected/updated training program");
+    }
+
+    std::vector<InjectionResult> TrainingProgramListConfigurationControl::injectTrainingPrograms(const std::vector<TrainingProgramData>& data)
+    {
+        // Inject in reverse order so the programs end up at the top of the list in the order they were supplied
+        std::vector<InjectionResult> results(data.size());
+        auto anyProgramChanged = false;
+        for (auto index = data.size(); index-- > 0;)
+        {
+            results[index] = injectWithoutNotification(data[index]);
+            anyProgramChanged |= results[index] != InjectionResult::Unchanged;
+        }
+        if (!anyProgramChanged)
+        {
+            return results;
+        }
+        notifyReceivers();
+
+        LOG("Successfully injected/updated {} training programs", data.size());
+        return results;
+    }
+
+    InjectionResult TrainingProgramListConfigurationControl::injectWithoutNotification(const TrainingProgramData& data)
+    {
+        const auto contentHash = TrainingProgramHasher::hashProgram(data);
+        if (auto iter = _trainingProgramData->find(data.Id); iter != _trainingProgramData->end() && iter->second.ContentHash == contentHash)
+        {
+            LOG("Training program with uuid {} is already up to date", data.Id);
+            return InjectionResult::Unchanged;
+        }
+
+        auto result = InjectionResult::Added;
         if (_trainingProgramData->count(data.Id) > 0)
         {
             LOG("Replacing existing training program with uuid {}", data.Id);
             _trainingProgramData->erase(data.Id);
+            result = InjectionResult::Replaced;
             // We can keep the training program order, because we'll add the program right back.
         }
         else
@@ -96,10 +140,9 @@ namespace configuration
             LOG("Injecting new training program with uuid {}", data.Id);
             _trainingProgramOrder.insert(_trainingProgramOrder.begin(), data.Id);
         }
-        _trainingProgramData->try_emplace(data.Id, data);
-        notifyReceivers();
-
-        LOG("Successfully injected/updated training program");
+        auto iter = _trainingProgramData->try_emplace(data.Id, data).first;
+        iter->second.ContentHash = contentHash;
+        return result;
     }
 
     /** Provides a copy of the training program list data (e.g. for display). */
@@ -125,8 +168,6 @@ namespace configuration
     void TrainingProgramListConfigurationControl::restoreWholeTrainingProgramList(const std::string& location)
     {
         LOG("Importing training program list");
-        _trainingProgramData->clear();
-        _trainingProgramOrder.clear();
 
         // Read data from the repo
 		TrainingProgramListData data;
@@ -136,21 +177,75 @@ namespace configuration
         }
         else
         {
-            data = _repository->restoreData(location);
+            try
+            {
+                data = _repository->restoreData(location);
+            }
+            catch (const std::runtime_error& ex)
+            {
+                LOG("ERROR: Could not import the training program list. The current training programs were kept. {}", ex.what());
+                return;
+            }
         }
 
         // Convert to internal data structure
+        _trainingProgramData->clear();
+        _trainingProgramOrder.clear();
         _trainingProgramOrder = data.TrainingProgramOrder;
         for (auto [id, programData] : data.TrainingProgramData)
         {
+            programData.ContentHash = TrainingProgramHasher::hashProgram(programData);
             _trainingProgramData->emplace(id, programData);
         }
         _workshopFolderLocation = data.WorkshopFolderLocation;
 
+        if (location.empty())
+        {
+            // This is exactly what is stored at the default location, so there is no need to write it back
+            _lastStoredListHash = TrainingProgramHasher::hashList(_trainingProgramOrder, _workshopFolderLocation, *_trainingProgramData);
+        }
+
         // Notify receivers, but do not write the file (would be kinda pointless right here)
         notifyReceivers(true);
     }
 
+    void TrainingProgramListConfigurationControl::mergeExternalChanges()
+    {
+        auto changedData = _repository->restoreDataIfChangedExternally();
+        if (!changedData.has_value())
+        {
+            return;
+        }
+
+        // Remove training programs which no longer exist
+        for (auto iter = _trainingProgramData->begin(); iter != _trainingProgramData->end();)
+        {
+            iter = changedData->TrainingProgramData.count(iter->first) == 0 ? _trainingProgramData->erase(iter) : std::next(iter);
+        }
+
+        // Replace only training programs which changed. Unchanged ones keep their data (and their address)
+        auto numberOfChangedPrograms = 0;
+        for (const auto& [id, programData] : changedData->TrainingProgramData)
+        {
+            const auto contentHash = TrainingProgramHasher::hashProgram(programData);
+            if (auto iter = _trainingProgramData->find(id); iter != _trainingProgramData->end() && iter->second.ContentHash == contentHash)
+            {
+                continue;
+            }
+            auto& storedData = (*_trainingProgramData)[id];
+            storedData = programData;
+            storedData.ContentHash = contentHash;
+            numberOfChangedPrograms++;
+        }
+        _trainingProgramOrder = changedData->TrainingProgramOrder;
+        _workshopFolderLocation = changedData->WorkshopFolderLocation;
+        LOG("Merged {} changed training programs", numberOfChangedPrograms);
+
+        // This is what is stored already, so there is no need to write it back
+        _lastStoredListHash = TrainingProgramHasher::hashList(_trainingProgramOrder, _workshopFolderLocation, *_trainingProgramData);
+        notifyReceivers();
+    }
+
     void TrainingProgramListConfigurationControl::storeWholeTrainingProgramList(const std::string& location) const
     {
         LOG("Exporting whole training program list");
@@ -176,17 +271,58 @@ namespace configuration
         _repository->exportSingleTrainingProgram(trainingProgram, location);
     }
 
+    void TrainingProgramListConfigurationControl::exportTrainingPrograms(const std::vector<std::string>& trainingProgramIds, const std::string& location, BulkExportFormat format) const
+    {
+        LOG("Exporting {} training programs..", trainingProgramIds.size());
+        std::vector<TrainingProgramData> trainingPrograms;
+        trainingPrograms.reserve(trainingProgramIds.size());
+        for (const auto& trainingProgramId : trainingProgramIds)
+        {
+            ensureIdIsKnown(trainingProgramId, "training program ID");
+            trainingPrograms.push_back(_trainingProgramData->at(trainingProgramId));
+        }
+        _repository->exportTrainingPrograms(trainingPrograms, location, format);
+    }
+
+    void TrainingProgramListConfigurationControl::importTrainingProgramBundle(const std::string& location)
+    {
+        LOG("Importing training program bundle..");
+        auto trainingPrograms = _repository->importTrainingProgramBundle(location);
+        trainingPrograms.erase(
+            std::remove_if(trainingPrograms.begin(), trainingPrograms.end(), [](const auto& trainingProgram) { return trainingProgram.Id.empty(); }),
+            trainingPrograms.end());
+        if (!trainingPrograms.empty())
+        {
+            injectTrainingPrograms(trainingPrograms);
+        }
+    }
+
     void TrainingProgramListConfigurationControl::notifyReceivers(bool currentlyRestoringData)
     {
+        RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::NotifyReceivers);
+        // Skip anything which would not change anything, e.g. when the same value was entered again
+        const auto listHash = TrainingProgramHasher::hashList(_trainingProgramOrder, _workshopFolderLocation, *_trainingProgramData);
+        const auto receiversAreUpToDate = _lastNotifiedListHash == listHash;
+        const auto storageIsUpToDate = currentlyRestoringData || _lastStoredListHash == listHash;
+        if (receiversAreUpToDate && storageIsUpToDate)
+        {
+            return;
+        }
+
         auto listData = getTrainingProgramList();
-        for (const auto& receiver : _receivers)
+        if (!receiversAreUpToDate)
         {
-            receiver->receiveListData(listData);
+            for (const auto& receiver : _receivers)
+            {
+                receiver->receiveListData(listData);
+            }
+            _lastNotifiedListHash = listHash;
         }
 
-        if (!currentlyRestoringData)
+        if (!storageIsUpToDate)
         {
             _repository->storeData(listData);
+            _lastStoredListHash = listHash;
         }
     }
 
@@ -6,11 +6,20 @@
 #include <memory>
 #include <functional>
 #include <filesystem>
+#include <optional>
 
 #include <DLLImportExport.h>
 
 namespace configuration
 {
+	/** What happened to a training program which was supplied from an external source. */
+	enum class InjectionResult
+	{
+		Added,
+		Replaced,
+		Unchanged // The program exists with the same contents already
+	};
+
 	/**
 	 * The job of this class is to make sure that the list of training programs is always consistent (i.e. no double entries etc).
 	 * It also does error checking of parameters, so rather than checking that everywhere, just place your UI layout function into a try catch block.
@@ -42,6 +51,9 @@ namespace configuration
 		/** Creates or replaces a training program, supplied from an external source. */
 		void injectTrainingProgram(const TrainingProgramData& data);
 
+		/** Creates or replaces several training programs at once. Receivers get notified only once. Returns what happened to each program, in the order of the data. */
+		std::vector<InjectionResult> injectTrainingPrograms(const std::vector<TrainingProgramData>& data);
+
 		/** Checks if a training program exists. */
 		inline bool hasTrainingProgram(const std::string& uuid) const { return _trainingProgramData->count(uuid) > 0; }
 
@@ -51,9 +63,12 @@ namespace configuration
 		/** Provides a copy of data of a single training program (e.g. for display). */
 		TrainingProgramData getTrainingProgramData(std::string trainingProgramId) const;
 
-		/** Restores data from the repository. */
+		/** Restores data from the repository. If the data can't be restored from the given location, the current data is kept. */
 		void restoreWholeTrainingProgramList(const std::string& location = "");
 
+		/** Checks whether the training program list was changed outside of the game and merges only the training programs which changed. Call this regularly. */
+		void mergeExternalChanges();
+
 		/** Stores the current data to the repository. */
 		void storeWholeTrainingProgramList(const std::string& location = "") const;
 
@@ -63,17 +78,26 @@ namespace configuration
 		/** Stores a single training program to the repository. */
 		void exportSingleTrainingProgram(std::string trainingProgramId, const std::string& location) const;
 
+		/** Stores the given training programs to the repository, either as separate files in a folder, or as a single bundle file. */
+		void exportTrainingPrograms(const std::vector<std::string>& trainingProgramIds, const std::string& location, BulkExportFormat format) const;
+
+		/** Imports all training programs from a bundle file and adds them to the list. */
+		void importTrainingProgramBundle(const std::string& location);
+
 		/** Notifies any receiver about a change in the training program list. */
 		void notifyReceivers(bool currentlyRestoringData = false);
 
 	private:
 		void ensureIdDoesntExist(std::string trainingProgramId) const;
 		void ensureIdIsKnown(std::string trainingProgramId, const std::string& parameterName) const;
+		InjectionResult injectWithoutNotification(const TrainingProgramData& data);
 		
 		std::string _workshopFolderLocation = ""; // The location of the workshop maps folder
 		std::vector<std::string> _trainingProgramOrder; // The order of training programs
 		std::shared_ptr<std::map<std::string, TrainingProgramData>> _trainingProgramData; // The training programs
 		std::vector<std::shared_ptr<ITrainingProgramListReceiver>> _receivers;
 		std::shared_ptr<ITrainingProgramRepository> _repository; // Allows storing training programs.
+		std::optional<uint64_t> _lastNotifiedListHash; // The hash of the list which was last sent to the receivers
+		std::optional<uint64_t> _lastStoredListHash; // The hash of the list which was last written to (or read from) the default location of the repository
 	};
 }
\ No newline at end of file
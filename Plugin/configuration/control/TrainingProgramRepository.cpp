@@ -1,9 +1,15 @@
 #include <pch.h>
 #include "TrainingProgramRepository.h"
+#include "TrainingProgramHasher.h"
+#include <diagnostics/BackgroundLog.h>
+#include <diagnostics/PerformanceCounters.h>
 #include <external/nlohmann/json.hpp>
 
 #include <ostream>
 #include <fstream>
+#include <algorithm>
+#include <future>
+#include <thread>
 
 using json = nlohmann::json;
 
@@ -24,38 +30,181 @@ namespace configuration
 	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(TrainingProgramData, Id, Name, Duration, Entries, ReadOnly);
 	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(TrainingProgramListData, Version, TrainingProgramData, TrainingProgramOrder, WorkshopFolderLocation);
 
-	TrainingProgramRepository::TrainingProgramRepository(const std::shared_ptr<GameWrapper>& gameWrapper)
+	/** An entry in the index at the start of a bundle file. Offset and length refer to the payload which follows the index line. */
+	struct BundleIndexEntry
 	{
-		auto configurationFolderPath = gameWrapper->GetDataFolder() / "RLTrainingTimer";
-		_storagePath = configurationFolderPath / "trainingprogramlist.json";
-		if (!std::filesystem::exists(configurationFolderPath))
+		std::string Id;
+		std::string Name;
+		size_t Offset = 0;
+		size_t Length = 0;
+	};
+	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BundleIndexEntry, Id, Name, Offset, Length);
+
+	const std::string BundleFormatName = "rltt-bundle";
+
+	std::optional<TrainingProgramListData> tryDeserializeList(const std::string& contents)
+	{
+		try
+		{
+			return json::parse(contents).get<TrainingProgramListData>();
+		}
+		catch (const json::exception& ex)
+		{
+			LOG("Failed restoring data for RLTrainingTimer: {}", ex.what());
+			return {};
+		}
+	}
+
+	/** Creates a file name which contains the name of the training program (for humans) and its uuid (for uniqueness). */
+	std::string createExportFileName(const TrainingProgramData& data)
+	{
+		auto name = data.Name.substr(0, 50);
+		std::replace_if(name.begin(), name.end(), [](char c) { return !std::isalnum((unsigned char)c) && c != ' ' && c != '-' && c != '_'; }, '_');
+		return fmt::format("{}_{}.json", name, data.Id);
+	}
+
+	std::filesystem::path createConfigurationFolder(const std::filesystem::path& storagePath)
+	{
+		auto configurationFolderPath = storagePath.parent_path();
+		if (!configurationFolderPath.empty() && !std::filesystem::exists(configurationFolderPath))
 		{
 			std::filesystem::create_directories(configurationFolderPath);
 		}
+		return configurationFolderPath;
+	}
+
+	std::shared_ptr<TrainingProgramRepository> TrainingProgramRepository::createInDataFolder(const std::filesystem::path& dataFolder)
+	{
+		const auto storagePath = dataFolder / "RLTrainingTimer" / "trainingprogramlist.json";
+		return std::make_shared<TrainingProgramRepository>(
+			storagePath,
+			std::make_shared<DirectoryNotificationFileChangeBackend>(createConfigurationFolder(storagePath)) // The folder must exist before it can be watched
+		);
+	}
+
+	TrainingProgramRepository::TrainingProgramRepository(const std::filesystem::path& storagePath, std::shared_ptr<IFileChangeBackend> changeBackend)
+		: _storagePath(storagePath)
+		, _storage(storagePath)
+		, _changeDetector(storagePath, changeBackend ? std::move(changeBackend) : std::make_shared<PollingFileChangeBackend>())
+	{
+		createConfigurationFolder(_storagePath);
+		_writerThread = std::thread([this]() { runWriter(); });
+	}
+
+	TrainingProgramRepository::~TrainingProgramRepository()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_writerShallStop = true; // The writer will still write pending data before stopping
+		}
+		_writerCondition.notify_all();
+		_writerThread.join();
 	}
 
 	void TrainingProgramRepository::storeData(const TrainingProgramListData& data)
 	{
-		storeDataImpl(data, _storagePath);
+		{
+			std::lock_guard<std::mutex> lock(_writerMutex);
+			_pendingData = data;
+		}
+		_writerCondition.notify_all();
 	}
 
 	void TrainingProgramRepository::storeData(const TrainingProgramListData& data, const std::string& location)
 	{
-		storeDataImpl(data, std::filesystem::path(location));
+		if (location.empty()) { return; } // e.g. the file dialog was cancelled
+
+		try
+		{
+			storeDataImpl(data, std::filesystem::path(location));
+		}
+		catch (const std::runtime_error& ex)
+		{
+			LOG("ERROR: {}", ex.what());
+		}
 	}
 
 	void TrainingProgramRepository::storeDataImpl(const TrainingProgramListData& data, const std::filesystem::path& path)
 	{
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::RepositoryStore);
 		json serialized = data;
-		std::ofstream os{ path };
-		os << serialized.dump(2);
-		os.flush();
+		CrashSafeFileStorage::writeAtomically(path, serialized.dump(2));
+	}
+
+	std::string TrainingProgramRepository::serializeList(const TrainingProgramListData& data)
+	{
+		return json(data).dump(); // Without indentation, control characters within strings are escaped, so there are no line breaks or tabs
+	}
+
+	std::optional<TrainingProgramListData> TrainingProgramRepository::deserializeList(const std::string& serialized)
+	{
+		return tryDeserializeList(serialized);
+	}
+
+	void TrainingProgramRepository::flush() const
+	{
+		std::unique_lock<std::mutex> lock(_writerMutex);
+		_writerCondition.wait(lock, [this]() { return !_pendingData.has_value() && !_writeIsInProgress; });
 	}
 
+	void TrainingProgramRepository::runWriter()
+	{
+		std::unique_lock<std::mutex> lock(_writerMutex);
+		while (true)
+		{
+			_writerCondition.wait(lock, [this]() { return _pendingData.has_value() || _writerShallStop; });
+			if (!_pendingData.has_value())
+			{
+				return; // Stop was requested and there is nothing left to write
+			}
+
+			auto data = std::move(_pendingData.value());
+			_pendingData.reset();
+			_writeIsInProgress = true;
+			lock.unlock();
+
+			try
+			{
+				RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::RepositoryStore);
+				json serialized = data;
+				auto contents = serialized.dump(2);
+				_changeDetector.writeOwnChange(contents, [this, &contents]() { _storage.write(contents); }); // This is not an external change
+			}
+			catch (const std::exception& ex)
+			{
+				diagnostics::BackgroundLog::post(fmt::format("ERROR: Failed storing data for RLTrainingTimer: {}", ex.what()));
+			}
+
+			lock.lock();
+			_writeIsInProgress = false;
+			_writerCondition.notify_all();
+		}
+	}
 
 	TrainingProgramListData TrainingProgramRepository::restoreData() const
 	{
-		return restoreDataImpl(_storagePath);
+		flush(); // Make sure we read what was stored last
+
+		std::optional<TrainingProgramListData> restoredData;
+		auto contents = _storage.read([&restoredData](const std::string& contents) {
+			restoredData = tryDeserializeList(contents);
+			return restoredData.has_value();
+		});
+		if (contents.has_value())
+		{
+			_changeDetector.acknowledge(contents.value());
+		}
+		return restoredData.value_or(TrainingProgramListData());
+	}
+
+	std::optional<TrainingProgramListData> TrainingProgramRepository::restoreDataIfChangedExternally()
+	{
+		auto contents = _changeDetector.detectChange();
+		if (!contents.has_value()) { return {}; }
+
+		// Note: If the file can't be parsed, the user might still be editing it, so we just wait for the next change
+		LOG("{} was changed externally", _storagePath.string());
+		return tryDeserializeList(contents.value());
 	}
 
 	TrainingProgramListData TrainingProgramRepository::restoreData(const std::string& location) const
@@ -65,23 +214,25 @@ namespace configuration
 
 	TrainingProgramListData TrainingProgramRepository::restoreDataImpl(const std::filesystem::path& path) const
 	{
-		if (!std::filesystem::exists(path)) { return {}; }
-
-		std::ifstream is{ path };
-		json deserialized;
-		is >> deserialized;
-		is.close();
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::RepositoryRestore);
+		if (!std::filesystem::exists(path))
+		{
+			throw std::runtime_error(fmt::format("{} does not exist", path.string()));
+		}
 
 		try
 		{
+			std::ifstream is{ path };
+			json deserialized;
+			is >> deserialized;
 			return deserialized.get<TrainingProgramListData>();
 		}
-		catch (json::type_error& err)
+		catch (const json::exception& ex)
 		{
-			LOG("Failed restoring data for RLTrainingTimer: {}", err.what());
-			return TrainingProgramListData();
+			throw std::runtime_error(fmt::format("{} does not contain a valid training program list: {}", path.string(), ex.what()));
 		}
 	}
+
 	void TrainingProgramRepository::exportSingleTrainingProgram(const TrainingProgramData& data, const std::string& location)
 	{
 		LOG("Save Training program {}..", data.Id);
@@ -121,7 +272,7 @@ namespace configuration
 		{
 			jsonData = json::parse(serialized);
 		}
-		catch (json::exception ex)
+		catch (const json::exception& ex)
 		{
 			LOG("Could not parse JSON Data: {}", ex.what());
 			LOG("ERROR: Data in file was: {}", serialized);
@@ -133,11 +284,155 @@ namespace configuration
 		{
 			return jsonData.get<configuration::TrainingProgramData>();
 		}
-		catch (json::exception ex)
+		catch (const json::exception& ex)
 		{
 			LOG("JSON Data does not match training program structure: {}", ex.what());
 			LOG("ERROR: JSON Data was: {}", jsonData.dump(2));
 			return {};
 		}
 	}
+
+	void TrainingProgramRepository::exportTrainingPrograms(const std::vector<TrainingProgramData>& data, const std::string& location, BulkExportFormat format)
+	{
+		LOG("Exporting {} training programs..", data.size());
+		const auto serializedPrograms = serializeInParallel(data);
+		const auto path = std::filesystem::path(location);
+
+		if (format == BulkExportFormat::Folder)
+		{
+			std::filesystem::create_directories(path);
+			for (size_t index = 0; index < data.size(); index++)
+			{
+				std::ofstream os{ path / createExportFileName(data[index]), std::ios::binary };
+				os << serializedPrograms[index];
+			}
+			return;
+		}
+
+		// Bundle: A single line with a compact index, followed by all serialized training programs
+		json bundleIndex;
+		bundleIndex["Format"] = BundleFormatName;
+		bundleIndex["Version"] = TrainingProgramListData().Version;
+		auto indexEntries = std::vector<BundleIndexEntry>();
+		indexEntries.reserve(data.size());
+		size_t offset = 0;
+		for (size_t index = 0; index < data.size(); index++)
+		{
+			indexEntries.push_back({ data[index].Id, data[index].Name, offset, serializedPrograms[index].size() });
+			offset += serializedPrograms[index].size() + 1; // +1 for the line break
+		}
+		bundleIndex["Programs"] = indexEntries;
+
+		std::ofstream os{ path, std::ios::binary };
+		os << bundleIndex.dump() << '\n';
+		for (const auto& serializedProgram : serializedPrograms)
+		{
+			os << serializedProgram << '\n';
+		}
+		os.flush();
+	}
+
+	std::vector<TrainingProgramData> TrainingProgramRepository::importTrainingProgramBundle(const std::string& location) const
+	{
+		LOG("Load training program bundle..");
+
+		auto path = std::filesystem::path(location);
+		if (!std::filesystem::exists(path)) {
+			LOG("File does not exist");
+			return {};
+		}
+
+		// Read the whole file at once, then parse the index and every training program from that buffer
+		std::string contents;
+		{
+			std::ifstream is{ path, std::ios::binary };
+			contents.resize((size_t)std::filesystem::file_size(path));
+			is.read(contents.data(), (std::streamsize)contents.size());
+		}
+
+		const auto indexEnd = contents.find('\n');
+		if (indexEnd == std::string::npos)
+		{
+			LOG("ERROR: File is not a training program bundle");
+			return {};
+		}
+		const auto payloadStart = indexEnd + 1;
+
+		std::vector<TrainingProgramData> result;
+		try
+		{
+			auto bundleIndex = json::parse(contents.begin(), contents.begin() + indexEnd);
+			if (bundleIndex.value("Format", "") != BundleFormatName)
+			{
+				LOG("ERROR: File is not a training program bundle");
+				return {};
+			}
+
+			auto indexEntries = bundleIndex.at("Programs").get<std::vector<BundleIndexEntry>>();
+			result.reserve(indexEntries.size());
+			for (const auto& indexEntry : indexEntries)
+			{
+				if (payloadStart + indexEntry.Offset + indexEntry.Length > contents.size())
+				{
+					LOG("ERROR: Training program {} is outside of the bundle. The file is probably incomplete.", indexEntry.Id);
+					continue;
+				}
+				auto begin = contents.begin() + payloadStart + indexEntry.Offset;
+				result.push_back(json::parse(begin, begin + indexEntry.Length).get<TrainingProgramData>());
+			}
+		}
+		catch (const json::exception& ex)
+		{
+			LOG("Could not read training program bundle: {}", ex.what());
+			return {};
+		}
+
+		LOG("Read {} training programs from the bundle", result.size());
+		return result;
+	}
+
+	std::vector<std::string> TrainingProgramRepository::serializeInParallel(const std::vector<TrainingProgramData>& data)
+	{
+		auto result = std::vector<std::string>(data.size());
+
+		// Split the programs into one chunk per hardware thread. Every chunk writes to a distinct range of the result vector.
+		const auto numberOfChunks = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)data.size()));
+		const auto chunkSize = (data.size() + numberOfChunks - 1) / numberOfChunks;
+		std::vector<std::future<void>> futures;
+		for (size_t chunkStart = 0; chunkStart < data.size(); chunkStart += chunkSize)
+		{
+			const auto chunkEnd = std::min(chunkStart + chunkSize, data.size());
+			futures.push_back(std::async(std::launch::async, [this, &data, &result, chunkStart, chunkEnd]() {
+				for (auto index = chunkStart; index < chunkEnd; index++)
+				{
+					result[index] = serializeOrReuse(data[index]);
+				}
+			}));
+		}
+		for (auto& future : futures)
+		{
+			future.get(); // Rethrows any exception which occurred while serializing
+		}
+		return result;
+	}
+
+	std::string TrainingProgramRepository::serializeOrReuse(const TrainingProgramData& data)
+	{
+		const auto contentHash = TrainingProgramHasher::hashProgram(data);
+		{
+			std::lock_guard<std::mutex> lock(_serializationCacheMutex);
+			if (auto iter = _serializationCache.find(data.Id);
+				iter != _serializationCache.end() && iter->second.ContentHash == contentHash)
+			{
+				return iter->second.Serialized;
+			}
+		}
+
+		json jsonData = data;
+		auto serialized = jsonData.dump();
+
+		std::lock_guard<std::mutex> lock(_serializationCacheMutex);
+		_serializationCache.insert_or_assign(data.Id, CachedSerialization{ contentHash, serialized });
+		return serialized;
+	}
 }
\ No newline at end of file
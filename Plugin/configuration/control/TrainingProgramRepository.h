@@ -1,34 +1,88 @@
 #pragma once
 
 #include "../data/TrainingProgramData.h"
+#include "CrashSafeFileStorage.h"
+#include "FileChangeDetector.h"
 
 #include <DLLImportExport.h>
 
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <optional>
+
 namespace configuration
 {
-	/** The job of this class is to write training program data to the file system and read it back from there. */
+	/**
+	 * The job of this class is to write training program data to the file system and read it back from there.
+	 *
+	 * Data for the default location is written by a background thread, so the render thread never has to wait for the file system.
+	 * It is written crash-safe, and restored from a backup if the file was damaged anyway.
+	 */
 	class RLTT_IMPORT_EXPORT TrainingProgramRepository : public ITrainingProgramRepository
 	{
 	public:
-		TrainingProgramRepository(const std::shared_ptr<GameWrapper>& gameWrapper);
+		/** Creates a repository which stores data in the given data folder of bakkesmod, and lets the operating system report external changes. */
+		static std::shared_ptr<TrainingProgramRepository> createInDataFolder(const std::filesystem::path& dataFolder);
+		/** Constructor. Stores data at the given path. External changes to the file are detected using the given backend, or by polling if there is none. */
+		explicit TrainingProgramRepository(const std::filesystem::path& storagePath, std::shared_ptr<IFileChangeBackend> changeBackend = nullptr);
+		/** Destructor. Finishes any pending write. */
+		~TrainingProgramRepository();
 
-		/** Stores the given training program list at the default location in the file system. */
+		/** Stores the given training program list at the default location in the file system. This happens in the background. */
 		void storeData(const TrainingProgramListData& data) override;
 		/** Stores the given training program list at the specified location in the file system. */
 		virtual void storeData(const TrainingProgramListData& data, const std::string& location) override;
 		/** Restores the training program list from the default location in the file system. */
 		TrainingProgramListData restoreData() const override;
-		/** Restores the training program list from the specified location in the file system. */
+		/** Restores the training program list from the specified location in the file system. Throws std::runtime_error if the file can't be read or parsed. */
 		virtual TrainingProgramListData restoreData(const std::string& location) const override;
+		/** Restores the training program list from the default location if the file was changed by another program or manually. */
+		std::optional<TrainingProgramListData> restoreDataIfChangedExternally() override;
 		/** Exports a single training program to the specified location on the file system. */
 		virtual void exportSingleTrainingProgram(const TrainingProgramData& data, const std::string& location) override;
 		/** Imports a single training program from the specified location on the file system. */
 		virtual TrainingProgramData importSingleTrainingProgram(const std::string& location) const override;
+		/** Exports several training programs at once. Programs get serialized in parallel, and serializations of unchanged programs are reused. */
+		virtual void exportTrainingPrograms(const std::vector<TrainingProgramData>& data, const std::string& location, BulkExportFormat format) override;
+		/** Imports all training programs from the bundle file at the specified location in a single pass. */
+		virtual std::vector<TrainingProgramData> importTrainingProgramBundle(const std::string& location) const override;
+
+		/** Blocks until all data which was passed to storeData() has been written to the default location. */
+		void flush() const;
+
+		/** Serializes the given training program list into a single line, e.g. for an event trace. */
+		static std::string serializeList(const TrainingProgramListData& data);
+		/** Restores a training program list which was serialized by serializeList(), or returns nothing if the text is not a valid list. */
+		static std::optional<TrainingProgramListData> deserializeList(const std::string& serialized);
 
 	private:
+		/** The serialized form of a training program, so the serialization can be reused as long as the content hash does not change. */
+		struct CachedSerialization
+		{
+			uint64_t ContentHash;
+			std::string Serialized;
+		};
+
 		std::filesystem::path _storagePath;
+		CrashSafeFileStorage _storage;
+		mutable FileChangeDetector _changeDetector;
+
+		// Background writer. Only the newest pending data will be written, since it replaces any older data anyway.
+		std::thread _writerThread;
+		mutable std::mutex _writerMutex;
+		mutable std::condition_variable _writerCondition;
+		std::optional<TrainingProgramListData> _pendingData;
+		bool _writeIsInProgress = false;
+		bool _writerShallStop = false;
+
+		std::unordered_map<std::string, CachedSerialization> _serializationCache; // Compact serializations of previously exported training programs, by training program ID
+		std::mutex _serializationCacheMutex;
 
 		TrainingProgramListData restoreDataImpl(const std::filesystem::path& path) const;
 		void storeDataImpl(const TrainingProgramListData& data, const std::filesystem::path& path);
+		void runWriter();
+		std::vector<std::string> serializeInParallel(const std::vector<TrainingProgramData>& data);
+		std::string serializeOrReuse(const TrainingProgramData& data);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include <pch.h>
+#include "WorkshopMapIndex.h"
+#include <diagnostics/BackgroundLog.h>
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+	/** Converts a path into a form which can be compared regardless of letter case and the kind of slashes. */
+	std::string createLookupKey(const std::string& path)
+	{
+		auto key = path;
+		std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return c == '\\' ? '/' : (char)std::tolower(c); });
+		return key;
+	}
+
+	bool isMapFile(const std::filesystem::path& path)
+	{
+		auto extension = createLookupKey(path.extension().string());
+		return extension == ".udk" || extension == ".upk";
+	}
+
+	bool isWordStart(const std::string& text, size_t position)
+	{
+		return position == 0 || std::string("/_- .").find(text[position - 1]) != std::string::npos;
+	}
+
+	/**
+	 * Rates how well the text matches the lookup key, or returns nothing if the characters of the text don't appear in the key in the same order.
+	 * Consecutive characters and characters at the start of words are rated higher, gaps are rated lower.
+	 */
+	std::optional<int> rateMatch(const std::string& lowercaseText, const std::string& lookupKey)
+	{
+		auto score = 0;
+		size_t keyPosition = 0;
+		std::optional<size_t> previousMatchPosition;
+		for (auto character : lowercaseText)
+		{
+			auto matchPosition = lookupKey.find(character, keyPosition);
+			if (matchPosition == std::string::npos) { return {}; }
+
+			score += 1;
+			if (previousMatchPosition.has_value() && matchPosition == previousMatchPosition.value() + 1) { score += 5; }
+			if (isWordStart(lookupKey, matchPosition)) { score += 8; }
+			score -= (int)std::min<size_t>(matchPosition - keyPosition, 3);
+
+			previousMatchPosition = matchPosition;
+			keyPosition = matchPosition + 1;
+		}
+		return score;
+	}
+}
+
+namespace configuration
+{
+	WorkshopMapIndex::WorkshopMapIndex()
+	{
+		_scannerThread = std::thread([this]() { runScanner(); });
+	}
+
+	WorkshopMapIndex::~WorkshopMapIndex()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_scannerShallStop = true;
+			_pendingFolder.reset(); // No need to finish scans nobody will look at
+		}
+		_condition.notify_all();
+		_scannerThread.join();
+	}
+
+	void WorkshopMapIndex::receiveListData(const TrainingProgramListData& data)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_lastRequestedFolder == data.WorkshopFolderLocation) { return; }
+		}
+		requestScan(data.WorkshopFolderLocation);
+	}
+
+	void WorkshopMapIndex::requestScan(const std::string& workshopFolderLocation)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_lastRequestedFolder = workshopFolderLocation;
+			_pendingFolder = workshopFolderLocation;
+		}
+		_condition.notify_all();
+	}
+
+	void WorkshopMapIndex::requestRescan()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_lastRequestedFolder.has_value()) { return; }
+			_pendingFolder = _lastRequestedFolder;
+		}
+		_condition.notify_all();
+	}
+
+	void WorkshopMapIndex::waitForScans() const
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_condition.wait(lock, [this]() { return !_pendingFolder.has_value() && !_scanIsInProgress; });
+	}
+
+	std::optional<bool> WorkshopMapIndex::containsMap(const std::string& workshopMapPath) const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_snapshot == nullptr || _snapshot->WorkshopFolderLocation != _lastRequestedFolder)
+		{
+			return {}; // The index is still being built, or it was built for a different folder
+		}
+		return _snapshot->LookupKeys.count(createLookupKey(workshopMapPath)) > 0;
+	}
+
+	std::vector<std::string> WorkshopMapIndex::findMatches(const std::string& text, size_t maxNumberOfMatches) const
+	{
+		auto snapshot = currentSnapshot();
+		if (snapshot == nullptr) { return {}; }
+
+		const auto lowercaseText = createLookupKey(text);
+		std::vector<std::pair<int, const IndexedMap*>> ratedMaps;
+		for (const auto& map : snapshot->Maps)
+		{
+			if (auto rating = rateMatch(lowercaseText, map.LookupKey); rating.has_value())
+			{
+				ratedMaps.emplace_back(rating.value(), &map);
+			}
+		}
+
+		// Best rating first, shorter paths first for equal ratings
+		const auto numberOfMatches = std::min(maxNumberOfMatches, ratedMaps.size());
+		std::partial_sort(ratedMaps.begin(), ratedMaps.begin() + numberOfMatches, ratedMaps.end(), [](const auto& first, const auto& second) {
+			if (first.first != second.first) { return first.first > second.first; }
+			return first.second->RelativePath.size() < second.second->RelativePath.size();
+		});
+
+		std::vector<std::string> result;
+		result.reserve(numberOfMatches);
+		for (size_t index = 0; index < numberOfMatches; index++)
+		{
+			result.push_back(ratedMaps[index].second->RelativePath);
+		}
+		return result;
+	}
+
+	size_t WorkshopMapIndex::numberOfMaps() const
+	{
+		auto snapshot = currentSnapshot();
+		return snapshot == nullptr ? 0 : snapshot->Maps.size();
+	}
+
+	uint64_t WorkshopMapIndex::numberOfCompletedScans() const
+	{
+		return _numberOfCompletedScans.load(std::memory_order_acquire);
+	}
+
+	std::shared_ptr<const WorkshopMapIndex::Snapshot> WorkshopMapIndex::currentSnapshot() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _snapshot;
+	}
+
+	void WorkshopMapIndex::runScanner()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true)
+		{
+			_condition.wait(lock, [this]() { return _pendingFolder.has_value() || _scannerShallStop; });
+			if (_scannerShallStop) { return; }
+
+			auto workshopFolderLocation = std::move(_pendingFolder.value());
+			_pendingFolder.reset();
+			_scanIsInProgress = true;
+			lock.unlock();
+
+			auto snapshot = scan(workshopFolderLocation);
+
+			lock.lock();
+			_snapshot = std::move(snapshot);
+			_numberOfCompletedScans.fetch_add(1, std::memory_order_release);
+			_scanIsInProgress = false;
+			_condition.notify_all();
+		}
+	}
+
+	std::shared_ptr<const WorkshopMapIndex::Snapshot> WorkshopMapIndex::scan(const std::string& workshopFolderLocation)
+	{
+		auto snapshot = std::make_shared<Snapshot>();
+		snapshot->WorkshopFolderLocation = workshopFolderLocation;
+
+		const auto workshopFolder = std::filesystem::path(workshopFolderLocation);
+		std::unordered_map<std::string, CachedDirectory> newCache;
+		std::error_code errorCode;
+		if (!workshopFolderLocation.empty() && std::filesystem::is_directory(workshopFolder, errorCode))
+		{
+			scanDirectory(workshopFolder, workshopFolder, newCache, snapshot->Maps);
+		}
+		_directoryCache = std::move(newCache); // Directories which no longer exist are dropped this way
+
+		std::sort(snapshot->Maps.begin(), snapshot->Maps.end(), [](const IndexedMap& first, const IndexedMap& second) { return first.LookupKey < second.LookupKey; });
+		for (const auto& map : snapshot->Maps)
+		{
+			snapshot->LookupKeys.insert(map.LookupKey);
+		}
+		diagnostics::BackgroundLog::post(fmt::format("Found {} workshop maps in {}", snapshot->Maps.size(), workshopFolderLocation));
+		return snapshot;
+	}
+
+	void WorkshopMapIndex::scanDirectory(
+		const std::filesystem::path& directory,
+		const std::filesystem::path& workshopFolder,
+		std::unordered_map<std::string, CachedDirectory>& newCache,
+		std::vector<IndexedMap>& maps) const
+	{
+		std::error_code errorCode;
+		const auto lastWriteTime = std::filesystem::last_write_time(directory, errorCode);
+		if (errorCode) { return; }
+
+		// Adding, removing or renaming a file changes the modification time of its directory, so unchanged directories don't need to be listed again
+		auto cacheKey = directory.string();
+		auto cachedDirectory = CachedDirectory();
+		if (auto iter = _directoryCache.find(cacheKey); iter != _directoryCache.end() && iter->second.LastWriteTime == lastWriteTime)
+		{
+			cachedDirectory = iter->second;
+		}
+		else
+		{
+			cachedDirectory.LastWriteTime = lastWriteTime;
+			for (const auto& directoryEntry : std::filesystem::directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, errorCode))
+			{
+				if (directoryEntry.is_directory(errorCode))
+				{
+					cachedDirectory.Subdirectories.push_back(directoryEntry.path());
+				}
+				else if (isMapFile(directoryEntry.path()))
+				{
+					cachedDirectory.MapFiles.push_back(std::filesystem::relative(directoryEntry.path(), workshopFolder, errorCode).string());
+				}
+			}
+		}
+
+		for (const auto& mapFile : cachedDirectory.MapFiles)
+		{
+			maps.push_back({ mapFile, createLookupKey(mapFile) });
+		}
+		for (const auto& subdirectory : cachedDirectory.Subdirectories)
+		{
+			scanDirectory(subdirectory, workshopFolder, newCache, maps);
+		}
+		newCache.emplace(std::move(cacheKey), std::move(cachedDirectory));
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../data/TrainingProgramData.h"
+
+#include <DLLImportExport.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace configuration
+{
+	/**
+	 * The job of this class is to know which workshop maps (.udk and .upk files) exist in the workshop folder.
+	 *
+	 * The folder gets scanned on a background thread. Directories which did not change since the previous scan are not listed again,
+	 * so rescans are cheap and can be requested whenever the index might be outdated.
+	 * Lookups never touch the file system and can be done on every frame.
+	 */
+	class RLTT_IMPORT_EXPORT WorkshopMapIndex : public ITrainingProgramListReceiver
+	{
+	public:
+		/** Constructor. */
+		WorkshopMapIndex();
+		/** Destructor. Aborts waiting for pending scans. */
+		~WorkshopMapIndex();
+
+		/** Scans the workshop folder of the new list in case it changed. */
+		void receiveListData(const TrainingProgramListData& data) override;
+
+		/** Requests a scan of the given workshop folder in the background. */
+		void requestScan(const std::string& workshopFolderLocation);
+		/** Requests a rescan of the last scanned folder, e.g. because maps might have been downloaded in the meantime. */
+		void requestRescan();
+		/** Blocks until there is no scan in progress or pending. */
+		void waitForScans() const;
+
+		/**
+		 * Checks whether the given path (relative to the workshop folder) is a known map. Letter case and the kind of slashes don't matter.
+		 * Returns nothing if the index does not know yet, e.g. because the initial scan is still in progress.
+		 */
+		std::optional<bool> containsMap(const std::string& workshopMapPath) const;
+
+		/** Finds the maps which match the given text best, where the characters of the text may be spread across the path (e.g. "lthrngs" matches "LethamyrRings.udk"). */
+		std::vector<std::string> findMatches(const std::string& text, size_t maxNumberOfMatches) const;
+
+		/** Retrieves the number of known maps. */
+		size_t numberOfMaps() const;
+
+		/** Retrieves the number of scans which have finished so far. This changes whenever lookups might return different results, so anything derived from the index can be refreshed then. */
+		uint64_t numberOfCompletedScans() const;
+
+	private:
+		/** A map file with its lookup key, which is precomputed so lookups don't have to normalize every path again. */
+		struct IndexedMap
+		{
+			std::string RelativePath;
+			std::string LookupKey;
+		};
+
+		/** The result of a scan. This is never modified after being published, so readers can keep using it while the next scan is running. */
+		struct Snapshot
+		{
+			std::string WorkshopFolderLocation;
+			std::vector<IndexedMap> Maps;
+			std::unordered_set<std::string> LookupKeys;
+		};
+
+		/** What a directory contained at the time it was last listed. */
+		struct CachedDirectory
+		{
+			std::filesystem::file_time_type LastWriteTime;
+			std::vector<std::string> MapFiles; // Relative to the workshop folder
+			std::vector<std::filesystem::path> Subdirectories;
+		};
+
+		void runScanner();
+		std::shared_ptr<const Snapshot> scan(const std::string& workshopFolderLocation);
+		void scanDirectory(
+			const std::filesystem::path& directory,
+			const std::filesystem::path& workshopFolder,
+			std::unordered_map<std::string, CachedDirectory>& newCache,
+			std::vector<IndexedMap>& maps) const;
+		std::shared_ptr<const Snapshot> currentSnapshot() const;
+
+		std::unordered_map<std::string, CachedDirectory> _directoryCache; // Only accessed by the scanner thread
+
+		std::thread _scannerThread;
+		mutable std::mutex _mutex; // Protects all members below
+		std::shared_ptr<const Snapshot> _snapshot;
+		std::optional<std::string> _lastRequestedFolder;
+		mutable std::condition_variable _condition;
+		std::optional<std::string> _pendingFolder;
+		bool _scanIsInProgress = false;
+		bool _scannerShallStop = false;
+		std::atomic<uint64_t> _numberOfCompletedScans = 0; // Not protected by the mutex, since it gets checked on every frame
+	};
+}
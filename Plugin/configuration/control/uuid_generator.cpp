@@ -1,23 +1,62 @@
 #include <pch.h>
 #include "uuid_generator.h"
 #include <string>
+#include <algorithm>
 
-std::shared_ptr<uuids::uuid_system_generator> uuid_generator::_generator = nullptr;
+namespace
+{
+	/** Creates a random engine for the current thread. The whole state gets seeded, since a single seed would allow only 2^32 different sequences of IDs. */
+	std::mt19937_64 createRandomEngine()
+	{
+		std::random_device randomDevice;
+		auto seedData = std::array<std::random_device::result_type, std::mt19937_64::state_size * 2>{};
+		std::generate(std::begin(seedData), std::end(seedData), std::ref(randomDevice));
+		std::seed_seq seedSequence(std::begin(seedData), std::end(seedData));
+		return std::mt19937_64(seedSequence);
+	}
+
+	std::mt19937_64& randomEngine()
+	{
+		thread_local std::mt19937_64 engine = createRandomEngine();
+		return engine;
+	}
+
+	/** Turns 128 random bits into a version 4 UUID, as described in RFC 4122. */
+	uuids::uuid generateWith(std::mt19937_64& engine)
+	{
+		auto bytes = std::array<uuids::uuid::value_type, 16>();
+		for (size_t half = 0; half < 2; half++)
+		{
+			const auto randomBits = engine();
+			for (size_t byte = 0; byte < 8; byte++)
+			{
+				bytes[half * 8 + byte] = (uuids::uuid::value_type)(randomBits >> (byte * 8));
+			}
+		}
+		bytes[6] = (bytes[6] & 0x0F) | 0x40; // version must be 0100xxxx
+		bytes[8] = (bytes[8] & 0x3F) | 0x80; // variant must be 10xxxxxx
+		return uuids::uuid(bytes);
+	}
+}
 
 std::string uuid_generator::generateUUID()
 {
-	if (_generator == nullptr) { initialize(); }
-	uuids::uuid const id = (*_generator)();
-	return uuids::to_string(id);
+	return uuids::to_string(generate());
+}
+
+uuids::uuid uuid_generator::generate()
+{
+	return generateWith(randomEngine());
 }
 
-void uuid_generator::initialize()
+std::vector<uuids::uuid> uuid_generator::generate(size_t numberOfIds)
 {
-	/*std::random_device rd;
-	auto seed_data = std::array<int, std::mt19937::state_size> {};
-	std::generate(std::begin(seed_data), std::end(seed_data), std::ref(rd));
-	std::seed_seq seq(std::begin(seed_data), std::end(seed_data));
-	std::mt19937 generator(seq);
-	_generator = std::make_shared<uuids::uuid_random_generator>( generator );*/
-	_generator = std::make_shared<uuids::uuid_system_generator>();
+	auto& engine = randomEngine();
+	std::vector<uuids::uuid> ids;
+	ids.reserve(numberOfIds);
+	for (size_t index = 0; index < numberOfIds; index++)
+	{
+		ids.push_back(generateWith(engine));
+	}
+	return ids;
 }
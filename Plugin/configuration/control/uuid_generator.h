@@ -1,18 +1,28 @@
 #pragma once
 
+#include <DLLImportExport.h>
+
 #include <external/stduuid/uuid.h>
 
-/** This is a wrapper around stduuid (https://github.com/mariusbancila/stduuid) which generates random uuids with a default generator. */
-class uuid_generator
+#include <string>
+#include <vector>
+
+/**
+ * This is a wrapper around stduuid (https://github.com/mariusbancila/stduuid) which generates random (version 4) uuids.
+ *
+ * Every thread uses its own 64 bit Mersenne Twister, which gets seeded from std::random_device once. Generating an ID therefore neither locks
+ * nor asks the operating system for randomness, and IDs stay binary until they get formatted.
+ */
+class RLTT_IMPORT_EXPORT uuid_generator
 {
 public:
 
-	/** Generates a new UUID. */
+	/** Generates a new UUID, formatted as a string. */
 	static std::string generateUUID();
 
-private:
-	/** Initializes the generator with a random seed. */
-	static void initialize();
-	static std::shared_ptr<uuids::uuid_system_generator> _generator;
+	/** Generates a new UUID. Use uuids::to_string() when the text is actually needed. */
+	static uuids::uuid generate();
 
-};
\ No newline at end of file
+	/** Generates the given number of UUIDs at once, e.g. when many training programs need new IDs. */
+	static std::vector<uuids::uuid> generate(size_t numberOfIds);
+};
@@ -11,6 +11,7 @@
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
+#include <optional>
 
 namespace configuration
 {
@@ -24,6 +25,7 @@ namespace configuration
 		std::string Name;
 		std::string Description;
 		bool ReadOnly = false; // This is used so training programs from prejump can't be modified (but they can be copied and adapted, if desired)
+		uint64_t ContentHash = 0; // Not serialized. Maintained by the configuration controls so unchanged programs can be detected quickly. 0 = unknown.
 	};
 
 	/** POD struct for a list of training programs. */
@@ -33,7 +35,14 @@ namespace configuration
 		std::string Version = "1.5";
 		std::string WorkshopFolderLocation = "";
 		std::vector<std::string> TrainingProgramOrder;
-		std::unordered_map<std::string, TrainingProgramData> TrainingProgramData;
+		std::unordered_map<std::string, configuration::TrainingProgramData> TrainingProgramData; // Qualified, because GCC does not allow the member to change the meaning of the type name
+	};
+
+	/** Defines how several training programs shall be exported at once. */
+	enum class BulkExportFormat
+	{
+		Folder, // Every training program is written to a separate file in the given folder
+		Bundle, // All training programs are written to a single file, which starts with a compact index of the programs it contains
 	};
 
 	/** This interface decouples file system handling from the remainder of the code, allowing easy changes like switching storage to a REST service
@@ -53,13 +62,20 @@ namespace configuration
 		virtual void storeData(const TrainingProgramListData& data, const std::string& location) = 0;
 		/** Restores the training program list from the default persistent location. */
 		virtual TrainingProgramListData restoreData() const = 0;
-		/** Restores the training program list from the specified persistent location. */
+		/** Restores the training program list from the specified persistent location. Throws std::runtime_error if the file can't be read or parsed. */
 		virtual TrainingProgramListData restoreData(const std::string& location) const = 0;
+		/** Restores the training program list from the default persistent location, but only if it was changed by someone else since it was last stored or restored. */
+		virtual std::optional<TrainingProgramListData> restoreDataIfChangedExternally() = 0;
 
 		/** Exports a single training program persistently at the specified location in order to allow the user to share it with others. */
 		virtual void exportSingleTrainingProgram(const TrainingProgramData& data, const std::string& location) = 0;
 		/** Imports a single training program from the specified persistent location. */
 		virtual TrainingProgramData importSingleTrainingProgram(const std::string& location) const = 0;
+
+		/** Exports several training programs at once, either into a folder or into a single bundle file at the specified location. */
+		virtual void exportTrainingPrograms(const std::vector<TrainingProgramData>& data, const std::string& location, BulkExportFormat format) = 0;
+		/** Imports all training programs from a bundle file at the specified location. */
+		virtual std::vector<TrainingProgramData> importTrainingProgramBundle(const std::string& location) const = 0;
 	};
 
 	/** Simple interface for classes which consume training programs. */
@@ -56,7 +56,7 @@ namespace configuration
 		std::string TrainingPackCode; // Only set when Type = CustomTraining
 		std::string WorkshopMapPath; // Only set when Type = WorkshopMap. Contains just the end of the path; the base path is configurable in the UI
 		TrainingProgramCompletionMode TimeMode = TrainingProgramCompletionMode::Timed;
-		std::chrono::milliseconds Duration; // 0 if CompletionMode != Timed
+		std::chrono::milliseconds Duration = {}; // 0 if CompletionMode != Timed
 		std::string Notes; // Any kind of additional notes for this step.
 		VarianceSettings Variance;
 	};
@@ -2,13 +2,15 @@
 #include "ConfigurationUi.h"
 #include "TrainingProgramConfigurationUi.h"
 #include "TrainingProgramListConfigurationUi.h"
+#include <diagnostics/PerformanceCounters.h>
 
 namespace configuration
 {
     void ConfigurationUi::initConfigurationUi(
         std::shared_ptr<GameWrapper> gameWrapper,
         std::shared_ptr<TrainingProgramConfigurationControl> singleProgramControl, 
-        std::shared_ptr<TrainingProgramListConfigurationControl> programListControl)
+        std::shared_ptr<TrainingProgramListConfigurationControl> programListControl,
+        std::shared_ptr<WorkshopMapIndex> workshopMapIndex)
     {
         // Function to be called when pressing "Edit" on a training program
         auto switchToEditingFunc = [this](const std::string& trainingProgramId) {
@@ -19,12 +21,13 @@ namespace configuration
         // Function to be called when pressing "Back" on a training program
         auto returnToOverviewFunc = [this]() { _isEditing = false; };
 
-        _singleTrainingProgramUi = std::make_shared<TrainingProgramConfigurationUi>(singleProgramControl, returnToOverviewFunc);
+        _singleTrainingProgramUi = std::make_shared<TrainingProgramConfigurationUi>(singleProgramControl, workshopMapIndex, returnToOverviewFunc);
         _trainingProgramOverviewUi = std::make_shared<TrainingProgramListConfigurationUi>(gameWrapper, programListControl, singleProgramControl, switchToEditingFunc);
     }
 
     void ConfigurationUi::RenderSettings()
     {
+        RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::SettingsWindowRender);
         if (_isEditing)
         {
             _singleTrainingProgramUi->renderTrainingProgram();
@@ -6,20 +6,22 @@
 #include "../control/TrainingProgramListConfigurationControl.h"
 
 #include <bakkesmod/plugin/PluginSettingsWindow.h>
+#include <DLLImportExport.h>
 
 #include <IMGUI/imgui.h>
 
 namespace configuration
 {
 	/** This class alternates between rendering the list of training programs or a single training program as needed. */
-	class ConfigurationUi
+	class RLTT_IMPORT_EXPORT ConfigurationUi
 		: public BakkesMod::Plugin::PluginSettingsWindow
 	{
 	public:
 		void initConfigurationUi(
 			std::shared_ptr<GameWrapper> gameWrapper, 
 			std::shared_ptr<TrainingProgramConfigurationControl> singleProgramControl, 
-			std::shared_ptr<TrainingProgramListConfigurationControl> programListControl);
+			std::shared_ptr<TrainingProgramListConfigurationControl> programListControl,
+			std::shared_ptr<WorkshopMapIndex> workshopMapIndex);
 
 		// Inherited via PluginSettingsWindow
 		void RenderSettings() override;
@@ -9,8 +9,10 @@ namespace configuration
 {
 	TrainingProgramConfigurationUi::TrainingProgramConfigurationUi(
 		std::shared_ptr<TrainingProgramConfigurationControl> configurationControl,
+		std::shared_ptr<WorkshopMapIndex> workshopMapIndex,
 		std::function<void()> finishEditingCallback)
 		: _configurationControl{ configurationControl }
+		, _workshopMapIndex{ std::move(workshopMapIndex) }
 		, _finishEditingCallback{ std::move(finishEditingCallback) }
 	{
 
@@ -20,6 +22,7 @@ namespace configuration
 	{
 		_trainingProgramId = trainingProgramId;
 		updateCaches();
+		_workshopMapIndex->requestRescan(); // Maps might have been downloaded in the meantime. This is cheap if nothing changed.
 	}
 
 	void TrainingProgramConfigurationUi::updateCaches()
@@ -30,8 +33,10 @@ namespace configuration
 		_durationCache.clear();
 		_selectedTypeCache.clear();
 		_selectedCompletionModeCache.clear();
+		_workshopMapMatchesCache.clear();
 
 		auto trainingProgramData = _configurationControl->getData(_trainingProgramId);
+		_cachedContentHash = trainingProgramData.ContentHash;
 		_programNameCache = trainingProgramData.Name;
 		for (const auto& entry : trainingProgramData.Entries)
 		{
@@ -42,10 +47,23 @@ namespace configuration
 			_selectedTypeCache.push_back((int)entry.Type);
 			_selectedCompletionModeCache.push_back((int)entry.TimeMode);
 		}
+		_workshopMapMatchesCache.resize(trainingProgramData.Entries.size());
 	}
 
 	void TrainingProgramConfigurationUi::renderTrainingProgram()
 	{
+		// The training program might have been changed or removed outside of the game
+		auto contentHash = _configurationControl->getContentHash(_trainingProgramId);
+		if (!contentHash.has_value())
+		{
+			_finishEditingCallback();
+			return;
+		}
+		if (contentHash.value() != _cachedContentHash)
+		{
+			updateCaches();
+		}
+
 		bool trainingProgramChanged = false;
 
 		addBackButton();
@@ -334,6 +352,29 @@ namespace configuration
 				_configurationControl->changeWorkshopMapPath(_trainingProgramId, index, _workshopMapPathCache[index]);
 				changed = true;
 			}
+
+			// Suggest similar maps if the map does not exist
+			if (_workshopMapIndex->containsMap(_workshopMapPathCache[index]) == false)
+			{
+				ImGui::TextColored(ImVec4{ 0.9f, .7f, .1f, 1.0f }, "This map was not found in the workshop folder. Did you mean:");
+				auto& cachedMatches = _workshopMapMatchesCache[index];
+				const auto numberOfCompletedScans = _workshopMapIndex->numberOfCompletedScans();
+				if (cachedMatches.NumberOfCompletedScans != numberOfCompletedScans || cachedMatches.WorkshopMapPath != _workshopMapPathCache[index])
+				{
+					cachedMatches.WorkshopMapPath = _workshopMapPathCache[index];
+					cachedMatches.NumberOfCompletedScans = numberOfCompletedScans;
+					cachedMatches.Matches = _workshopMapIndex->findMatches(cachedMatches.WorkshopMapPath, 5);
+				}
+				for (const auto& match : cachedMatches.Matches)
+				{
+					if (ImGui::Selectable(fmt::format("{}##workshopmatch_{}", match, index).c_str()))
+					{
+						_workshopMapPathCache[index] = match;
+						_configurationControl->changeWorkshopMapPath(_trainingProgramId, index, match);
+						changed = true;
+					}
+				}
+			}
 			ImGui::PopItemWidth();
 		}
 		return changed;
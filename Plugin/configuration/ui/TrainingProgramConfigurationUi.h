@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../control/TrainingProgramConfigurationControl.h"
+#include "../control/WorkshopMapIndex.h"
 
 #include <memory>
 #include <functional>
@@ -15,6 +16,7 @@ namespace configuration
 		/** Constructor. Asks for a function to be called when editing has finished. */
 		explicit TrainingProgramConfigurationUi(
 			std::shared_ptr<TrainingProgramConfigurationControl> configurationControl,
+			std::shared_ptr<WorkshopMapIndex> workshopMapIndex,
 			std::function<void()> finishEditingCallback
 			);
 
@@ -48,6 +50,7 @@ namespace configuration
 		std::string _trainingProgramId = "";
 
 		// Caches required for editing in the UI
+		uint64_t _cachedContentHash = 0; // Allows detecting changes which were not made through this UI
 		std::string _programNameCache;
 		std::vector<std::string> _entryNameCache;
 		std::vector<std::string> _trainingPackCodeCache;
@@ -56,7 +59,17 @@ namespace configuration
 		std::vector<int> _selectedTypeCache;
 		std::vector<int> _selectedCompletionModeCache;
 
+		/** Suggestions for a workshop map path. They only get searched again when the path changes or the workshop folder was scanned again. */
+		struct WorkshopMapMatches
+		{
+			std::string WorkshopMapPath;
+			std::optional<uint64_t> NumberOfCompletedScans;
+			std::vector<std::string> Matches;
+		};
+		std::vector<WorkshopMapMatches> _workshopMapMatchesCache;
+
 		std::shared_ptr<TrainingProgramConfigurationControl> _configurationControl; 
+		std::shared_ptr<WorkshopMapIndex> _workshopMapIndex;
 		std::function<void()> _finishEditingCallback;
 	};
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <IMGUI/imgui_stdlib.h>
 #include <IMGUI/imgui_disable.h>
 
+#include <algorithm>
+
 namespace configuration
 {
     TrainingProgramListConfigurationUi::TrainingProgramListConfigurationUi(
@@ -28,6 +30,7 @@ namespace configuration
 
         ImGui::TextUnformatted("Backup");
 		addLoadSaveButtons();
+        addBulkExportButtons();
 
         ImGui::Separator();
 
@@ -59,6 +62,8 @@ namespace configuration
             const auto previousData = previousProgramId == nullptr ? nullptr : &data.TrainingProgramData.at(*previousProgramId);
             const auto nextData = nextProgramId == nullptr ? nullptr : &data.TrainingProgramData.at(*nextProgramId);
 
+            addExportSelectionCheckBox(index, trainingProgramInfo);
+            ImGui::SameLine();
             listHasChanged |= addProgramNameTextBox(index, trainingProgramInfo);
             ImGui::SameLine();
             addProgramDurationLabel(trainingProgramInfo);
@@ -115,6 +120,61 @@ namespace configuration
 		}
 	}
 
+    void TrainingProgramListConfigurationUi::addBulkExportButtons()
+    {
+        // Only collect the selected programs when they are actually needed, rather than copying the training program list every frame
+        const auto anythingIsSelected = std::any_of(_exportSelection.begin(), _exportSelection.end(), [](const auto& selection) { return selection.second; });
+        {
+            ImGui::Disable disable(!anythingIsSelected);
+            if (ImGui::Button("Export Selected to Folder") && anythingIsSelected)
+            {
+                auto path = file_dialogs::getFolderPath("Select a folder for the training programs");
+                if (auto selectedIds = getSelectedTrainingProgramIds(); !path.empty() && !selectedIds.empty())
+                {
+                    _listConfigurationControl->exportTrainingPrograms(selectedIds, path.string(), BulkExportFormat::Folder);
+                }
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Export Selected as Bundle") && anythingIsSelected)
+            {
+                auto path = file_dialogs::getSaveFilePath("", { "rlttbundle" });
+                if (auto selectedIds = getSelectedTrainingProgramIds(); !path.empty() && !selectedIds.empty())
+                {
+                    _listConfigurationControl->exportTrainingPrograms(selectedIds, path.string(), BulkExportFormat::Bundle);
+                }
+            }
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Import Bundle"))
+        {
+            auto path = file_dialogs::getOpenFilePath("", { "rlttbundle" });
+            if (!path.empty())
+            {
+                _listConfigurationControl->importTrainingProgramBundle(path.string());
+            }
+        }
+    }
+
+    std::vector<std::string> TrainingProgramListConfigurationUi::getSelectedTrainingProgramIds() const
+    {
+        // Keep the order of the training program list
+        std::vector<std::string> selectedIds;
+        for (const auto& trainingProgramId : _listConfigurationControl->getTrainingProgramList().TrainingProgramOrder)
+        {
+            if (auto iter = _exportSelection.find(trainingProgramId); iter != _exportSelection.end() && iter->second)
+            {
+                selectedIds.push_back(trainingProgramId);
+            }
+        }
+        return selectedIds;
+    }
+
+    void TrainingProgramListConfigurationUi::addExportSelectionCheckBox(uint16_t index, const TrainingProgramData& info)
+    {
+        ImGui::Checkbox(fmt::format("##select_{}", index).c_str(), &_exportSelection[info.Id]);
+    }
+
     bool TrainingProgramListConfigurationUi::addProgramNameTextBox(uint16_t index, const TrainingProgramData& info)
     {
         // Note: ## hides the label
@@ -171,6 +231,7 @@ namespace configuration
     {
         if (ImGui::Button(fmt::format("##delete_{}", index).c_str(), "Delete"))
         {
+            _exportSelection.erase(info.Id);
             _listConfigurationControl->removeTrainingProgram(info.Id);
             return true;
         }
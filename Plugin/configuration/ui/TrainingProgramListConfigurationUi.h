@@ -29,7 +29,10 @@ namespace configuration
 		void addWorkshopFolderLocationTextBos();
 		void addTrainingControlWindowButton();
 		void addLoadSaveButtons();
+		void addBulkExportButtons();
+		std::vector<std::string> getSelectedTrainingProgramIds() const;
 
+		void addExportSelectionCheckBox(uint16_t index, const TrainingProgramData& info);
 		bool addProgramNameTextBox(uint16_t index, const TrainingProgramData& info);
 		void addProgramDurationLabel(const TrainingProgramData& info);
 		bool addUpButton(
@@ -48,6 +51,7 @@ namespace configuration
 
 		// Caches requried for editing in the UI
 		std::unordered_map<std::string, std::string> _entryNameCache;
+		std::unordered_map<std::string, bool> _exportSelection; // Training programs which shall be exported with the "Export Selected" buttons
 		std::string _workshopFolderLocation;
 
 		bool _firstTime = true;
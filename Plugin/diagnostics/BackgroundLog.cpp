@@ -0,0 +1,48 @@
+#include <pch.h>
+#include "BackgroundLog.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace
+{
+	constexpr size_t MaximumNumberOfMessages = 256;
+
+	std::mutex MessagesMutex;
+	std::deque<std::string> Messages;
+	std::atomic<bool> HasMessages = false; // Allows checking for messages without locking, since that happens every frame
+}
+
+namespace diagnostics
+{
+	void BackgroundLog::post(std::string message)
+	{
+		std::lock_guard<std::mutex> lock(MessagesMutex);
+		if (Messages.size() == MaximumNumberOfMessages)
+		{
+			Messages.pop_front();
+		}
+		Messages.push_back(std::move(message));
+		HasMessages.store(true, std::memory_order_release);
+	}
+
+	void BackgroundLog::writeToConsole()
+	{
+		if (!HasMessages.load(std::memory_order_acquire)) { return; }
+
+		for (const auto& message : takeMessages())
+		{
+			LOG("{}", message);
+		}
+	}
+
+	std::vector<std::string> BackgroundLog::takeMessages()
+	{
+		std::lock_guard<std::mutex> lock(MessagesMutex);
+		auto messages = std::vector<std::string>(std::make_move_iterator(Messages.begin()), std::make_move_iterator(Messages.end()));
+		Messages.clear();
+		HasMessages.store(false, std::memory_order_release);
+		return messages;
+	}
+}
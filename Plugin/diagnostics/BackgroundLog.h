@@ -0,0 +1,26 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <string>
+#include <vector>
+
+namespace diagnostics
+{
+	/**
+	 * The job of this class is to get log messages from background threads to the console.
+	 * The console of bakkesmod must only be used on the game thread, so messages get queued here until the game thread writes them.
+	 * If nobody writes them for a long time, only the newest messages are kept.
+	 */
+	class RLTT_IMPORT_EXPORT BackgroundLog
+	{
+	public:
+		/** Queues a message. Can be called from any thread. */
+		static void post(std::string message);
+		/** Writes all queued messages to the console. Must be called on the game thread. Costs almost nothing if there are no messages. */
+		static void writeToConsole();
+		/** Removes all queued messages and returns them instead. */
+		static std::vector<std::string> takeMessages();
+	};
+}
+
@@ -0,0 +1,159 @@
+#include <pch.h>
+#include "PerformanceCounters.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+
+namespace
+{
+	constexpr size_t NumberOfBuckets = 65; // Bucket n contains durations of exactly n significant bits, i.e. [2^(n-1), 2^n)
+
+	struct Counter
+	{
+		std::atomic<uint64_t> TotalNanoseconds{ 0 };
+		std::atomic<uint64_t> MaximumNanoseconds{ 0 };
+		std::array<std::atomic<uint64_t>, NumberOfBuckets> Buckets{}; // The number of measurements is the sum of all buckets
+	};
+
+	std::array<Counter, (size_t)diagnostics::PerformanceCounter::NumberOfCounters> Counters;
+
+	/** Finds the upper bound of the bucket which contains the given share of all measurements. */
+	uint64_t percentile(const std::array<uint64_t, NumberOfBuckets>& buckets, uint64_t count, double share)
+	{
+		const auto threshold = (uint64_t)(share * (double)count);
+		uint64_t sum = 0;
+		for (size_t bucket = 0; bucket < NumberOfBuckets; bucket++)
+		{
+			sum += buckets[bucket];
+			if (sum > threshold)
+			{
+				return bucket == 0 ? 0 : (bucket >= 64 ? UINT64_MAX : (uint64_t(1) << bucket) - 1);
+			}
+		}
+		return 0;
+	}
+
+	/** Formats a duration with a unit which keeps the number short. */
+	std::string formatNanoseconds(uint64_t nanoseconds)
+	{
+		if (nanoseconds < 10'000) { return fmt::format("{}ns", nanoseconds); }
+		if (nanoseconds < 10'000'000) { return fmt::format("{:.1f}us", (double)nanoseconds / 1e3); }
+		return fmt::format("{:.1f}ms", (double)nanoseconds / 1e6);
+	}
+}
+
+namespace diagnostics
+{
+	void PerformanceCounters::record(PerformanceCounter counter, uint64_t nanoseconds)
+	{
+		auto& values = Counters[(size_t)counter];
+		values.TotalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+		values.Buckets[std::bit_width(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+		auto maximum = values.MaximumNanoseconds.load(std::memory_order_relaxed);
+		while (nanoseconds > maximum && !values.MaximumNanoseconds.compare_exchange_weak(maximum, nanoseconds, std::memory_order_relaxed))
+		{
+			// maximum has been updated by compare_exchange_weak, so just try again
+		}
+	}
+
+	std::vector<PerformanceCounterSnapshot> PerformanceCounters::snapshot()
+	{
+		std::vector<PerformanceCounterSnapshot> snapshots;
+		snapshots.reserve(Counters.size());
+		for (size_t counterIndex = 0; counterIndex < Counters.size(); counterIndex++)
+		{
+			const auto& values = Counters[counterIndex];
+			auto buckets = std::array<uint64_t, NumberOfBuckets>();
+			uint64_t count = 0;
+			for (size_t bucket = 0; bucket < NumberOfBuckets; bucket++)
+			{
+				buckets[bucket] = values.Buckets[bucket].load(std::memory_order_relaxed);
+				count += buckets[bucket]; // Consistent with the buckets, even if measurements are recorded right now
+			}
+
+			auto snapshot = PerformanceCounterSnapshot();
+			snapshot.Counter = (PerformanceCounter)counterIndex;
+			snapshot.Count = count;
+			snapshot.TotalNanoseconds = values.TotalNanoseconds.load(std::memory_order_relaxed);
+			snapshot.MaximumNanoseconds = values.MaximumNanoseconds.load(std::memory_order_relaxed);
+			snapshot.Percentile50Nanoseconds = std::min(percentile(buckets, count, 0.5), snapshot.MaximumNanoseconds);
+			snapshot.Percentile99Nanoseconds = std::min(percentile(buckets, count, 0.99), snapshot.MaximumNanoseconds);
+			snapshots.push_back(snapshot);
+		}
+		return snapshots;
+	}
+
+	std::vector<std::string> PerformanceCounters::format()
+	{
+		std::vector<std::string> lines;
+		for (const auto& snapshot : snapshot())
+		{
+			if (snapshot.Count == 0) { continue; }
+			lines.push_back(fmt::format("{}: {} calls, total {}, mean {}, p50 <= {}, p99 <= {}, max {}",
+				name(snapshot.Counter),
+				snapshot.Count,
+				formatNanoseconds(snapshot.TotalNanoseconds),
+				formatNanoseconds(snapshot.TotalNanoseconds / snapshot.Count),
+				formatNanoseconds(snapshot.Percentile50Nanoseconds),
+				formatNanoseconds(snapshot.Percentile99Nanoseconds),
+				formatNanoseconds(snapshot.MaximumNanoseconds)));
+		}
+		return lines;
+	}
+
+	void PerformanceCounters::reset()
+	{
+		for (auto& values : Counters)
+		{
+			values.TotalNanoseconds.store(0, std::memory_order_relaxed);
+			values.MaximumNanoseconds.store(0, std::memory_order_relaxed);
+			for (auto& bucket : values.Buckets)
+			{
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	const char* PerformanceCounters::name(PerformanceCounter counter)
+	{
+		switch (counter)
+		{
+		case PerformanceCounter::RepositoryStore: return "Repository store";
+		case PerformanceCounter::RepositoryRestore: return "Repository restore";
+		case PerformanceCounter::NotifyReceivers: return "Notify receivers";
+		case PerformanceCounter::ReceiveListData: return "Flow control receiveListData";
+		case PerformanceCounter::HandleTimerTick: return "Flow control timer tick";
+		case PerformanceCounter::BlueBarDisplayRender: return "Blue bar display";
+		case PerformanceCounter::MinimalDisplayRender: return "Minimal display";
+		case PerformanceCounter::TrainingWindowRender: return "Training window";
+		case PerformanceCounter::SettingsWindowRender: return "Settings window";
+		case PerformanceCounter::InjectionParsing: return "Injection parsing";
+		default: return "Unknown";
+		}
+	}
+
+	const char* PerformanceCounters::category(PerformanceCounter counter)
+	{
+		switch (counter)
+		{
+		case PerformanceCounter::RepositoryStore:
+		case PerformanceCounter::RepositoryRestore:
+			return "repository";
+		case PerformanceCounter::NotifyReceivers:
+		case PerformanceCounter::ReceiveListData:
+		case PerformanceCounter::HandleTimerTick:
+			return "control";
+		case PerformanceCounter::BlueBarDisplayRender:
+		case PerformanceCounter::MinimalDisplayRender:
+		case PerformanceCounter::TrainingWindowRender:
+		case PerformanceCounter::SettingsWindowRender:
+			return "ui";
+		case PerformanceCounter::InjectionParsing:
+			return "injection";
+		default: return "unknown";
+		}
+	}
+}
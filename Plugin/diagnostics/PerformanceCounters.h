@@ -0,0 +1,103 @@
+#pragma once
+
+#include "TimelineRecorder.h"
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Define RLTT_DISABLE_PERFORMANCE_COUNTERS in order to remove all measurements from the build.
+#ifndef RLTT_DISABLE_PERFORMANCE_COUNTERS
+	#define RLTT_PERFORMANCE_SCOPE_NAME_IMPL(line) rlttPerformanceScope##line
+	#define RLTT_PERFORMANCE_SCOPE_NAME(line) RLTT_PERFORMANCE_SCOPE_NAME_IMPL(line)
+	/** Measures the time until the end of the current scope, and adds it to the given counter. */
+	#define RLTT_PERFORMANCE_SCOPE(counter) const diagnostics::PerformanceScope RLTT_PERFORMANCE_SCOPE_NAME(__LINE__){ counter }
+#else
+	#define RLTT_PERFORMANCE_SCOPE(counter)
+#endif
+
+namespace diagnostics
+{
+	/** The paths of the plugin which get measured. */
+	enum class PerformanceCounter
+	{
+		RepositoryStore,
+		RepositoryRestore,
+		NotifyReceivers,
+		ReceiveListData,
+		HandleTimerTick,
+		BlueBarDisplayRender,
+		MinimalDisplayRender,
+		TrainingWindowRender,
+		SettingsWindowRender,
+		InjectionParsing,
+		NumberOfCounters // Must stay the last entry
+	};
+
+	/** A snapshot of a single counter. Durations are in nanoseconds. Percentiles are upper bounds, since durations are only stored as powers of two. */
+	struct PerformanceCounterSnapshot
+	{
+	public:
+		PerformanceCounter Counter = PerformanceCounter::NumberOfCounters;
+		uint64_t Count = 0;
+		uint64_t TotalNanoseconds = 0;
+		uint64_t MaximumNanoseconds = 0;
+		uint64_t Percentile50Nanoseconds = 0;
+		uint64_t Percentile99Nanoseconds = 0;
+	};
+
+	/**
+	 * The job of this class is to collect how often and how long the main paths of the plugin run, so it can be seen where the plugin spends time in the game.
+	 *
+	 * Counters are always on: recording is a few relaxed atomic operations and never locks or allocates, so any thread may record at any time.
+	 * Use RLTT_PERFORMANCE_SCOPE rather than calling record() directly, so the measurements can be compiled out.
+	 */
+	class RLTT_IMPORT_EXPORT PerformanceCounters
+	{
+	public:
+		/** Adds a single measurement to the given counter. */
+		static void record(PerformanceCounter counter, uint64_t nanoseconds);
+
+		/** Retrieves the current values of all counters, in the order of the enum. */
+		static std::vector<PerformanceCounterSnapshot> snapshot();
+
+		/** Retrieves one line of text per counter which has been recorded at least once. */
+		static std::vector<std::string> format();
+
+		/** Sets all counters back to zero. Measurements which happen at the same time may be partially lost. */
+		static void reset();
+
+		/** Retrieves the name of the given counter, as used by format(). */
+		static const char* name(PerformanceCounter counter);
+		/** Retrieves the timeline category of the given counter. */
+		static const char* category(PerformanceCounter counter);
+	};
+
+	/** Measures the lifetime of an instance and records it in a counter, and in the timeline if one is being recorded. */
+	class PerformanceScope
+	{
+	public:
+		explicit PerformanceScope(PerformanceCounter counter)
+			: _counter{ counter }
+			, _start{ std::chrono::steady_clock::now() }
+		{
+		}
+		~PerformanceScope()
+		{
+			const auto end = std::chrono::steady_clock::now();
+			PerformanceCounters::record(_counter, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - _start).count());
+			TimelineRecorder::recordSpan(PerformanceCounters::category(_counter), PerformanceCounters::name(_counter), _start, end);
+		}
+
+		PerformanceScope(const PerformanceScope&) = delete;
+		PerformanceScope& operator=(const PerformanceScope&) = delete;
+
+	private:
+		PerformanceCounter _counter;
+		std::chrono::steady_clock::time_point _start;
+	};
+}
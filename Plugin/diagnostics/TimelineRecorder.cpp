@@ -0,0 +1,268 @@
+#include <pch.h>
+#include "TimelineRecorder.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+	constexpr size_t EventsPerThread = 8192; // Several seconds of events, even with a high frame rate
+	constexpr size_t MaximumNameLength = 95;
+	constexpr auto WriteInterval = std::chrono::milliseconds(50);
+
+	/** A single timeline event. Only holds plain values, so recording one never allocates. */
+	struct TimelineEvent
+	{
+		char Phase = 'X'; // 'X' is a complete span, 'B' and 'E' are the begin and end of a span
+		const char* Category = "";
+		std::array<char, MaximumNameLength + 1> Name{};
+		std::chrono::steady_clock::time_point Start;
+		std::chrono::steady_clock::duration Duration{};
+	};
+
+	/** The events of a single thread. The thread is the only producer, and the writer is the only consumer, so no locks are needed. */
+	class ThreadEventBuffer
+	{
+	public:
+		explicit ThreadEventBuffer(uint32_t threadId)
+			: ThreadId{ threadId }
+		{
+		}
+
+		/** Adds an event. Fails if the writer did not keep up. Must only be called by the thread which owns the buffer. */
+		bool tryPush(const TimelineEvent& event)
+		{
+			const auto writeIndex = _writeIndex.load(std::memory_order_relaxed);
+			if (writeIndex - _readIndex.load(std::memory_order_acquire) >= EventsPerThread)
+			{
+				return false;
+			}
+			_events[writeIndex % EventsPerThread] = event;
+			_writeIndex.store(writeIndex + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** Hands every available event to the given function and removes it. Must only be called by one thread at a time. */
+		template <typename Function>
+		void drain(Function&& function)
+		{
+			const auto readIndex = _readIndex.load(std::memory_order_relaxed);
+			const auto writeIndex = _writeIndex.load(std::memory_order_acquire);
+			for (auto index = readIndex; index < writeIndex; index++)
+			{
+				function(_events[index % EventsPerThread]);
+			}
+			_readIndex.store(writeIndex, std::memory_order_release);
+		}
+
+		const uint32_t ThreadId;
+
+	private:
+		std::array<TimelineEvent, EventsPerThread> _events;
+		std::atomic<uint64_t> _writeIndex = 0;
+		std::atomic<uint64_t> _readIndex = 0;
+	};
+
+	std::atomic<bool> IsRecording = false; // Checked before anything else, so recording costs nothing while no timeline is being recorded
+	std::atomic<uint64_t> DroppedEvents = 0;
+
+	/** Everything apart from the flags above. */
+	struct TimelineState
+	{
+		~TimelineState()
+		{
+			diagnostics::TimelineRecorder::stop(); // Must not leave the writer running
+		}
+
+		std::mutex BuffersMutex; // Protects Buffers. Locked once per thread, and whenever the writer collects the buffers
+		std::vector<std::shared_ptr<ThreadEventBuffer>> Buffers;
+		uint32_t NextThreadId = 1;
+
+		std::mutex ControlMutex; // Serializes start() and stop()
+		std::thread Writer;
+		std::mutex WakeUpMutex; // Protects StopRequested
+		std::condition_variable WakeUp;
+		bool StopRequested = false;
+
+		// Only used by the writer while it is running, and by start() and stop() otherwise
+		std::ofstream TimelineFile;
+		std::chrono::steady_clock::time_point StartTime;
+	};
+
+	TimelineState& state()
+	{
+		static TimelineState instance;
+		return instance;
+	}
+
+	/** Retrieves the buffer of the current thread, and creates it on first use. */
+	ThreadEventBuffer& currentThreadBuffer()
+	{
+		thread_local std::shared_ptr<ThreadEventBuffer> buffer = []() {
+			auto& timeline = state();
+			std::lock_guard<std::mutex> lock(timeline.BuffersMutex);
+			auto newBuffer = std::make_shared<ThreadEventBuffer>(timeline.NextThreadId++);
+			timeline.Buffers.push_back(newBuffer); // Stays alive after the thread ended, so the writer can still write its events
+			return newBuffer;
+		}();
+		return *buffer;
+	}
+
+	void push(char phase, const char* category, std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::duration duration)
+	{
+		auto event = TimelineEvent();
+		event.Phase = phase;
+		event.Category = category;
+		const auto nameLength = std::min(name.size(), MaximumNameLength);
+		std::memcpy(event.Name.data(), name.data(), nameLength);
+		event.Name[nameLength] = '\0';
+		event.Start = start;
+		event.Duration = duration;
+		if (!currentThreadBuffer().tryPush(event))
+		{
+			DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	/** Adds the given text to the buffer as a JSON string, with quotes. */
+	void appendJsonString(fmt::memory_buffer& buffer, const char* text)
+	{
+		buffer.push_back('"');
+		for (; *text != '\0'; text++)
+		{
+			const auto character = *text;
+			if (character == '"' || character == '\\')
+			{
+				buffer.push_back('\\');
+				buffer.push_back(character);
+			}
+			else if ((unsigned char)character < 0x20)
+			{
+				fmt::format_to(buffer, "\\u{:04x}", (int)character);
+			}
+			else
+			{
+				buffer.push_back(character);
+			}
+		}
+		buffer.push_back('"');
+	}
+
+	/** Writes the events of all threads to the file. */
+	void writePendingEvents(TimelineState& timeline)
+	{
+		std::vector<std::shared_ptr<ThreadEventBuffer>> buffers;
+		{
+			std::lock_guard<std::mutex> lock(timeline.BuffersMutex);
+			buffers = timeline.Buffers;
+		}
+
+		fmt::memory_buffer text;
+		for (const auto& buffer : buffers)
+		{
+			buffer->drain([&timeline, &text, threadId = buffer->ThreadId](const TimelineEvent& event) {
+				if (event.Start < timeline.StartTime) { return; } // Recorded while the previous recording got stopped
+
+				// The file starts with a metadata event, so every event can be preceded by a comma
+				const auto timestamp = std::chrono::duration<double, std::micro>(event.Start - timeline.StartTime).count();
+				fmt::format_to(text, ",\n{{\"ph\":\"{}\",\"cat\":\"{}\",\"name\":", event.Phase, event.Category);
+				appendJsonString(text, event.Name.data());
+				fmt::format_to(text, ",\"pid\":1,\"tid\":{},\"ts\":{:.3f}", threadId, timestamp);
+				if (event.Phase == 'X')
+				{
+					fmt::format_to(text, ",\"dur\":{:.3f}", std::chrono::duration<double, std::micro>(event.Duration).count());
+				}
+				text.push_back('}');
+			});
+		}
+		timeline.TimelineFile.write(text.data(), (std::streamsize)text.size());
+		timeline.TimelineFile.flush(); // Keeps as much as possible if the game crashes
+	}
+}
+
+namespace diagnostics
+{
+	void TimelineRecorder::start(const std::filesystem::path& timelinePath)
+	{
+		stop();
+
+		auto& timeline = state();
+		std::lock_guard<std::mutex> lock(timeline.ControlMutex);
+		if (timelinePath.has_parent_path())
+		{
+			std::filesystem::create_directories(timelinePath.parent_path());
+		}
+		timeline.TimelineFile.open(timelinePath, std::ios::trunc);
+		if (!timeline.TimelineFile)
+		{
+			throw std::runtime_error(fmt::format("Could not create timeline {}", timelinePath.string()));
+		}
+		timeline.TimelineFile << "[\n{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"RLTrainingTimer\"}}";
+
+		timeline.StartTime = std::chrono::steady_clock::now();
+		DroppedEvents = 0;
+		timeline.StopRequested = false;
+		IsRecording = true;
+		timeline.Writer = std::thread([&timeline]() {
+			std::unique_lock<std::mutex> wakeUpLock(timeline.WakeUpMutex);
+			while (!timeline.WakeUp.wait_for(wakeUpLock, WriteInterval, [&timeline]() { return timeline.StopRequested; }))
+			{
+				wakeUpLock.unlock();
+				writePendingEvents(timeline);
+				wakeUpLock.lock();
+			}
+		});
+	}
+
+	void TimelineRecorder::stop()
+	{
+		auto& timeline = state();
+		std::lock_guard<std::mutex> lock(timeline.ControlMutex);
+		if (!timeline.Writer.joinable()) { return; }
+
+		IsRecording = false;
+		{
+			std::lock_guard<std::mutex> wakeUpLock(timeline.WakeUpMutex);
+			timeline.StopRequested = true;
+		}
+		timeline.WakeUp.notify_all();
+		timeline.Writer.join();
+
+		writePendingEvents(timeline);
+		timeline.TimelineFile << "\n]\n";
+		timeline.TimelineFile.close();
+	}
+
+	bool TimelineRecorder::isRecording()
+	{
+		return IsRecording.load(std::memory_order_relaxed);
+	}
+
+	uint64_t TimelineRecorder::droppedEvents()
+	{
+		return DroppedEvents.load(std::memory_order_relaxed);
+	}
+
+	void TimelineRecorder::recordSpan(const char* category, std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+	{
+		if (!isRecording()) { return; }
+		push('X', category, name, start, end - start);
+	}
+
+	void TimelineRecorder::recordBegin(const char* category, std::string_view name)
+	{
+		if (!isRecording()) { return; }
+		push('B', category, name, std::chrono::steady_clock::now(), {});
+	}
+
+	void TimelineRecorder::recordEnd(const char* category, std::string_view name)
+	{
+		if (!isRecording()) { return; }
+		push('E', category, name, std::chrono::steady_clock::now(), {});
+	}
+}
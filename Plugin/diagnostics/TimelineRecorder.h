@@ -0,0 +1,75 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// Timeline scopes get removed from the build along with the performance counters.
+#ifndef RLTT_DISABLE_PERFORMANCE_COUNTERS
+	#define RLTT_TIMELINE_SCOPE_NAME_IMPL(line) rlttTimelineScope##line
+	#define RLTT_TIMELINE_SCOPE_NAME(line) RLTT_TIMELINE_SCOPE_NAME_IMPL(line)
+	/** Adds a span from here until the end of the current scope to the timeline, if a timeline is being recorded. The category must be a string literal. */
+	#define RLTT_TIMELINE_SCOPE(category, name) const diagnostics::TimelineScope RLTT_TIMELINE_SCOPE_NAME(__LINE__){ category, name }
+#else
+	#define RLTT_TIMELINE_SCOPE(category, name)
+#endif
+
+namespace diagnostics
+{
+	/**
+	 * The job of this class is to record what the plugin does and when, into a file in the Chrome trace event format.
+	 * The file can be opened in chrome://tracing or https://ui.perfetto.dev in order to see what lines up with a hitch.
+	 *
+	 * Nothing gets recorded until start() gets called. Every thread records into its own lock free ring buffer, which a background thread
+	 * writes to the file regularly, so recording a span does not lock, allocate or wait for the disk. If a buffer runs full, events get dropped.
+	 * Categories must be string literals; names get copied (and cut off after 95 characters).
+	 */
+	class RLTT_IMPORT_EXPORT TimelineRecorder
+	{
+	public:
+		/** Starts recording into the file at the given path. Any previous recording gets stopped. Throws std::runtime_error if the file can't be created. */
+		static void start(const std::filesystem::path& timelinePath);
+		/** Stops recording, and writes the remaining events. Does nothing if no recording is in progress. */
+		static void stop();
+		/** Checks whether a recording is in progress. */
+		static bool isRecording();
+		/** Retrieves the number of events which got dropped since the recording was started, because the writer could not keep up. */
+		static uint64_t droppedEvents();
+
+		/** Adds a span which has already ended. Use RLTT_TIMELINE_SCOPE rather than calling this directly. */
+		static void recordSpan(const char* category, std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+		/** Adds the start of a span which ends in a different scope, e.g. a map load. The end must be recorded on the same thread. */
+		static void recordBegin(const char* category, std::string_view name);
+		/** Adds the end of a span started by recordBegin(). */
+		static void recordEnd(const char* category, std::string_view name);
+	};
+
+	/** Measures the lifetime of an instance and adds it to the timeline. Does not even read the clock while nothing is being recorded. */
+	class TimelineScope
+	{
+	public:
+		TimelineScope(const char* category, std::string_view name)
+			: _category{ category }
+			, _name{ name }
+			, _isActive{ TimelineRecorder::isRecording() }
+		{
+			if (_isActive) { _start = std::chrono::steady_clock::now(); }
+		}
+		~TimelineScope()
+		{
+			if (_isActive) { TimelineRecorder::recordSpan(_category, _name, _start, std::chrono::steady_clock::now()); }
+		}
+
+		TimelineScope(const TimelineScope&) = delete;
+		TimelineScope& operator=(const TimelineScope&) = delete;
+
+	private:
+		const char* _category;
+		std::string_view _name;
+		bool _isActive;
+		std::chrono::steady_clock::time_point _start;
+	};
+}
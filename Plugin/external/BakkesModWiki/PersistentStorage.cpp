@@ -5,13 +5,14 @@
 */
 #include "pch.h"
 #include "PersistentStorage.h"
-#include <fstream>
+#include <configuration/control/DebouncedFileWriter.h>
 
 
 PersistentStorage::PersistentStorage(BakkesMod::Plugin::BakkesModPlugin* plugin, const std::string& storage_file_name,
                                      const bool auto_write, bool auto_load):
 	cv_(plugin->cvarManager),
 	storage_file_(GetStorageFilePath(plugin->gameWrapper, storage_file_name)),
+	writer_(std::make_unique<configuration::DebouncedFileWriter>(storage_file_)),
 	auto_write_(auto_write)
 
 {
@@ -19,6 +20,7 @@ PersistentStorage::PersistentStorage(BakkesMod::Plugin::BakkesModPlugin* plugin,
 	cv_->registerNotifier("writeconfig", [this](...)
 	{
 		WritePersistentStorage();
+		writer_->flush();
 	}, "", 0);
 	if (auto_load)
 	{
@@ -31,17 +33,17 @@ PersistentStorage::PersistentStorage(BakkesMod::Plugin::BakkesModPlugin* plugin,
 
 PersistentStorage::~PersistentStorage()
 {
-	WritePersistentStorage();
+	WritePersistentStorage(); // The writer writes this right away when it gets destroyed
 }
 
 void PersistentStorage::WritePersistentStorage()
 {
-	std::ofstream out(storage_file_);
-	//LOG("PersistentStorage: Writing to file");
+	std::string contents;
 	for (const auto& [cvar, cvar_cache_item] : cvar_cache_)
 	{
-		out << fmt::format("{} \"{}\" //{}\n", cvar, cvar_cache_item.value, cvar_cache_item.description);
+		contents += fmt::format("{} \"{}\" //{}\n", cvar, cvar_cache_item.value, cvar_cache_item.description);
 	}
+	writer_->write(std::move(contents)); // Skips the write if nothing changed
 }
 
 void PersistentStorage::Load()
@@ -101,7 +103,12 @@ void PersistentStorage::OnPersistentCvarChanged(const std::string& old, CVarWrap
 	const auto cvar_name = changed_cvar.getCVarName();
 	if (auto it = cvar_cache_.find(cvar_name); it != cvar_cache_.end())
 	{
-		it->second = CvarCacheItem{changed_cvar};
+		auto changed_item = CvarCacheItem{changed_cvar};
+		if (changed_item.value == it->second.value && changed_item.description == it->second.description)
+		{
+			return; // e.g. a slider which got dragged back and forth
+		}
+		it->second = std::move(changed_item);
 	}
 	// If you Write to file before the file has been loaded. You will loose the data there.
 	if (auto_write_ && loaded_)
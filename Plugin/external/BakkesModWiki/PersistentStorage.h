@@ -6,6 +6,9 @@
 #pragma once
 #include <filesystem>
 #include <map>
+#include <memory>
+
+namespace configuration { class DebouncedFileWriter; }
 
 
 class PersistentStorage
@@ -28,7 +31,7 @@ public:
     ~PersistentStorage();
 
     /// <summary>
-    /// Writes the cvar values to disk
+    /// Writes the cvar values to disk. This happens in the background, once the values stopped changing for a moment.
     /// </summary>
     void WritePersistentStorage();
 
@@ -80,6 +83,7 @@ public:
 private:
 	std::shared_ptr<CVarManagerWrapper> cv_;
     std::filesystem::path storage_file_{ "" };
+    std::unique_ptr<configuration::DebouncedFileWriter> writer_; // Turns a burst of changes (e.g. dragging a slider) into a single file write
     bool auto_write_ = false;
 	bool loaded_ = false;
 
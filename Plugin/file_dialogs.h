@@ -5,6 +5,7 @@
 #include <stringapiset.h>
 #include <winerror.h>
 #include <commdlg.h>
+#include <shlobj.h>
 
 class file_dialogs 
 {
@@ -123,4 +124,24 @@ public:
 	{
 		return getOpenOrSaveFilePath(initialPath, extensions, true);
 	}
+
+	static std::filesystem::path getFolderPath( const std::string &title )
+	{
+		auto wideTitle = toWideString( title );
+		BROWSEINFOW bi;
+		::ZeroMemory( &bi, sizeof(bi) );
+		bi.lpszTitle = wideTitle.c_str();
+		bi.ulFlags = BIF_RETURNONLYFSDIRS | BIF_NEWDIALOGSTYLE;
+
+		// Display the folder selection dialog
+		auto idList = ::SHBrowseForFolderW( &bi );
+		if( idList == NULL ) {
+			return std::filesystem::path();
+		}
+
+		wchar_t szFolder[MAX_PATH];
+		auto success = ::SHGetPathFromIDListW( idList, szFolder );
+		::CoTaskMemFree( idList );
+		return success ? std::filesystem::path( szFolder ) : std::filesystem::path();
+	}
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <pch.h>
+#include "SessionHistoryReader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace history
+{
+	SessionHistoryReader::SessionHistoryReader(std::filesystem::path path, size_t numberOfRotatedFiles)
+		: _path(std::move(path))
+		, _numberOfRotatedFiles(numberOfRotatedFiles)
+	{
+	}
+
+	std::vector<SessionRecord> SessionHistoryReader::readAll() const
+	{
+		std::vector<SessionRecord> records;
+		for (auto rotationNumber = _numberOfRotatedFiles; rotationNumber > 0; rotationNumber--)
+		{
+			auto rotatedRecords = readFile(rotatedHistoryPath(_path, rotationNumber));
+			records.insert(records.end(), rotatedRecords.begin(), rotatedRecords.end());
+		}
+		auto currentRecords = readFile(_path);
+		records.insert(records.end(), currentRecords.begin(), currentRecords.end());
+		return records;
+	}
+
+	std::vector<SessionRecord> SessionHistoryReader::readAfter(uint64_t sequenceNumber) const
+	{
+		// Read the newest file first and stop at the first file which starts early enough
+		std::vector<std::vector<SessionRecord>> newestFirst;
+		for (size_t rotationNumber = 0; rotationNumber <= _numberOfRotatedFiles; rotationNumber++)
+		{
+			auto fileRecords = readFile(rotationNumber == 0 ? _path : rotatedHistoryPath(_path, rotationNumber));
+			// A missing rotated file means there are no older ones, while the current file may simply not have been written yet
+			const auto fileStartsEarlyEnough = fileRecords.empty() ? rotationNumber > 0 : fileRecords.front().SequenceNumber <= sequenceNumber;
+			newestFirst.push_back(std::move(fileRecords));
+			if (fileStartsEarlyEnough) { break; }
+		}
+
+		std::vector<SessionRecord> records;
+		for (auto iter = newestFirst.rbegin(); iter != newestFirst.rend(); iter++)
+		{
+			std::copy_if(iter->begin(), iter->end(), std::back_inserter(records), [sequenceNumber](const SessionRecord& record) { return record.SequenceNumber > sequenceNumber; });
+		}
+		return records;
+	}
+
+	std::optional<SessionRecord> SessionHistoryReader::readLastRecord() const
+	{
+		for (size_t rotationNumber = 0; rotationNumber <= _numberOfRotatedFiles; rotationNumber++)
+		{
+			const auto path = rotationNumber == 0 ? _path : rotatedHistoryPath(_path, rotationNumber);
+			std::error_code errorCode;
+			const auto fileSize = std::filesystem::file_size(path, errorCode);
+			if (errorCode || fileSize < SessionHistoryFileMagic.size() + sizeof(SessionRecord))
+			{
+				// The current file may simply not have been written yet, while a missing rotated file means there are no older ones
+				if (rotationNumber == 0) { continue; }
+				return {};
+			}
+
+			std::ifstream is{ path, std::ios::binary };
+			auto magic = decltype(SessionHistoryFileMagic)();
+			is.read(magic.data(), (std::streamsize)magic.size());
+			if (!is || magic != SessionHistoryFileMagic) { return {}; }
+
+			// Skip everything but the last complete record, so this does not depend on the size of the history
+			const auto numberOfRecords = (fileSize - magic.size()) / sizeof(SessionRecord);
+			auto record = SessionRecord();
+			is.seekg((std::streamoff)(magic.size() + (numberOfRecords - 1) * sizeof(SessionRecord)));
+			is.read(reinterpret_cast<char*>(&record), (std::streamsize)sizeof(SessionRecord));
+			if (is) { return record; }
+		}
+		return {};
+	}
+
+	std::vector<SessionRecord> SessionHistoryReader::readFile(const std::filesystem::path& path)
+	{
+		std::error_code errorCode;
+		const auto fileSize = std::filesystem::file_size(path, errorCode);
+		if (errorCode || fileSize < SessionHistoryFileMagic.size()) { return {}; }
+
+		std::ifstream is{ path, std::ios::binary };
+		auto magic = decltype(SessionHistoryFileMagic)();
+		is.read(magic.data(), (std::streamsize)magic.size());
+		if (!is || magic != SessionHistoryFileMagic)
+		{
+			LOG("Ignoring {} since it is not a session history file", path.string());
+			return {};
+		}
+
+		std::vector<SessionRecord> records((size_t)(fileSize - magic.size()) / sizeof(SessionRecord));
+		is.read(reinterpret_cast<char*>(records.data()), (std::streamsize)(records.size() * sizeof(SessionRecord)));
+		records.resize((size_t)is.gcount() / sizeof(SessionRecord));
+		return records;
+	}
+}
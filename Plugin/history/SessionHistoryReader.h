@@ -0,0 +1,33 @@
+#pragma once
+
+#include "SessionRecord.h"
+
+#include <DLLImportExport.h>
+
+#include <optional>
+#include <vector>
+
+namespace history
+{
+	/** The job of this class is to read what was written by the SessionHistoryWriter. */
+	class RLTT_IMPORT_EXPORT SessionHistoryReader
+	{
+	public:
+		/** Constructor. The number of rotated files must match the one of the writer. */
+		explicit SessionHistoryReader(std::filesystem::path path, size_t numberOfRotatedFiles = 3);
+
+		/** Reads the records of all history files, oldest first. */
+		std::vector<SessionRecord> readAll() const;
+		/** Reads the records which come after the given sequence number, oldest first. Rotated files are only read if they can contain such records. */
+		std::vector<SessionRecord> readAfter(uint64_t sequenceNumber) const;
+		/** Reads only the newest record, or nothing if there is no history. */
+		std::optional<SessionRecord> readLastRecord() const;
+
+		/** Reads the records of a single file. A record at the end which was not written completely gets ignored, as does a file which is not a session history. */
+		static std::vector<SessionRecord> readFile(const std::filesystem::path& path);
+
+	private:
+		std::filesystem::path _path;
+		size_t _numberOfRotatedFiles;
+	};
+}
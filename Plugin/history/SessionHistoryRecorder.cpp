@@ -0,0 +1,50 @@
+#include <pch.h>
+#include "SessionHistoryRecorder.h"
+#include "SessionHistoryReader.h"
+
+#include "../configuration/control/TrainingProgramHasher.h"
+
+namespace history
+{
+	SessionHistoryRecorder::SessionHistoryRecorder(std::filesystem::path path, uint64_t maxFileSize, size_t numberOfRotatedFiles)
+		: _writer(path, maxFileSize, numberOfRotatedFiles)
+	{
+		if (auto lastRecord = SessionHistoryReader(std::move(path), numberOfRotatedFiles).readLastRecord(); lastRecord.has_value())
+		{
+			_lastSequenceNumber = lastRecord->SequenceNumber;
+		}
+	}
+
+	void SessionHistoryRecorder::receiveSessionEvent(const training::SessionEvent& sessionEvent)
+	{
+		if (sessionEvent.TrainingProgramId != _lastTrainingProgramId)
+		{
+			_lastTrainingProgramId = std::string(sessionEvent.TrainingProgramId);
+			_lastTrainingProgramIdHash = configuration::TrainingProgramHasher::hashText(_lastTrainingProgramId);
+		}
+
+		auto record = SessionRecord();
+		record.Timestamp = sessionEvent.Timestamp;
+		record.SequenceNumber = ++_lastSequenceNumber;
+		record.TrainingProgramIdHash = _lastTrainingProgramIdHash;
+		record.DurationInMilliseconds = (uint32_t)std::max<long long>(0, sessionEvent.Duration.count());
+		record.StepNumber = sessionEvent.StepNumber;
+		record.EventType = (uint8_t)sessionEvent.Type;
+		_writer.append(record);
+
+		for (const auto& sessionRecordReceiver : _sessionRecordReceivers)
+		{
+			sessionRecordReceiver->receiveSessionRecord(record);
+		}
+	}
+
+	void SessionHistoryRecorder::registerSessionRecordReceiver(std::shared_ptr<ISessionRecordReceiver> sessionRecordReceiver)
+	{
+		_sessionRecordReceivers.push_back(std::move(sessionRecordReceiver));
+	}
+
+	void SessionHistoryRecorder::flush()
+	{
+		_writer.flush();
+	}
+}
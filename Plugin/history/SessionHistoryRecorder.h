@@ -0,0 +1,41 @@
+#pragma once
+
+#include "SessionHistoryWriter.h"
+#include "../training/data/SessionEvent.h"
+
+#include <DLLImportExport.h>
+
+#include <memory>
+#include <vector>
+
+namespace history
+{
+	/**
+	 * The job of this class is to turn the events of the training program flow into records of the session history.
+	 *
+	 * Every record gets the next sequence number, continuing after the last record which is already in the history. Receivers which are registered
+	 * here get the very same records, so they can tell exactly which part of the history they have processed.
+	 */
+	class RLTT_IMPORT_EXPORT SessionHistoryRecorder : public training::ISessionEventReceiver
+	{
+	public:
+		/** Constructor. */
+		explicit SessionHistoryRecorder(std::filesystem::path path, uint64_t maxFileSize = 1024 * 1024, size_t numberOfRotatedFiles = 3);
+
+		/** Queues a record for the event and forwards it to the record receivers. This never waits for file I/O. */
+		void receiveSessionEvent(const training::SessionEvent& sessionEvent) override;
+
+		/** Registers a receiver which will be notified about every record which gets recorded. */
+		void registerSessionRecordReceiver(std::shared_ptr<ISessionRecordReceiver> sessionRecordReceiver);
+
+		/** Blocks until every event which was received so far has been written. */
+		void flush();
+
+	private:
+		SessionHistoryWriter _writer;
+		std::vector<std::shared_ptr<ISessionRecordReceiver>> _sessionRecordReceivers;
+		uint64_t _lastSequenceNumber = 0;
+		std::string _lastTrainingProgramId;
+		uint64_t _lastTrainingProgramIdHash = 0; // Events of one program arrive in a row, so the hash rarely needs to be calculated
+	};
+}
@@ -0,0 +1,173 @@
+#include <pch.h>
+#include "SessionHistoryWriter.h"
+#include <diagnostics/BackgroundLog.h>
+
+#include <fstream>
+
+namespace
+{
+	// Writing this many records at once is cheap, while nothing is lost for more than a second if the game crashes
+	constexpr size_t RecordsPerWrite = 64;
+	constexpr auto MaxWriteDelay = std::chrono::seconds(1);
+}
+
+namespace history
+{
+	SessionHistoryWriter::SessionHistoryWriter(std::filesystem::path path, uint64_t maxFileSize, size_t numberOfRotatedFiles)
+		: _path(std::move(path))
+		, _maxFileSize(maxFileSize)
+		, _numberOfRotatedFiles(numberOfRotatedFiles)
+	{
+		_pendingRecords.reserve(RecordsPerWrite);
+		_writerThread = std::thread([this]() { runWriter(); });
+	}
+
+	SessionHistoryWriter::~SessionHistoryWriter()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_writerShallStop = true; // Pending records will still be written
+		}
+		_condition.notify_all();
+		_writerThread.join();
+	}
+
+	void SessionHistoryWriter::append(const SessionRecord& record)
+	{
+		bool writerShallWake = false;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_pendingRecords.push_back(record);
+			writerShallWake = _pendingRecords.size() >= RecordsPerWrite;
+		}
+		if (writerShallWake)
+		{
+			_condition.notify_all();
+		}
+	}
+
+	void SessionHistoryWriter::flush()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_flushIsRequested = true;
+		_condition.notify_all();
+		_condition.wait(lock, [this]() { return _pendingRecords.empty() && !_writeIsInProgress; });
+	}
+
+	void SessionHistoryWriter::runWriter()
+	{
+		std::vector<SessionRecord> recordsToBeWritten;
+		recordsToBeWritten.reserve(RecordsPerWrite);
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true)
+		{
+			_condition.wait_for(lock, MaxWriteDelay, [this]() {
+				return _pendingRecords.size() >= RecordsPerWrite || _flushIsRequested || _writerShallStop;
+			});
+			if (_pendingRecords.empty())
+			{
+				_flushIsRequested = false;
+				_condition.notify_all();
+				if (_writerShallStop) { return; }
+				continue;
+			}
+
+			// Swap the buffers so appending can continue while the records are being written
+			recordsToBeWritten.swap(_pendingRecords);
+			_flushIsRequested = false;
+			_writeIsInProgress = true;
+			lock.unlock();
+
+			try
+			{
+				writeRecords(recordsToBeWritten);
+			}
+			catch (const std::exception& ex)
+			{
+				diagnostics::BackgroundLog::post(fmt::format("Could not write the session history: {}", ex.what()));
+			}
+			recordsToBeWritten.clear();
+
+			lock.lock();
+			_writeIsInProgress = false;
+			_condition.notify_all();
+		}
+	}
+
+	void SessionHistoryWriter::writeRecords(const std::vector<SessionRecord>& records)
+	{
+		const auto numberOfBytes = records.size() * sizeof(SessionRecord);
+		std::error_code errorCode;
+		auto fileSize = std::filesystem::file_size(_path, errorCode);
+		if (errorCode)
+		{
+			fileSize = 0;
+			std::filesystem::create_directories(_path.parent_path(), errorCode);
+		}
+		else if (!_formatWasChecked && fileSize >= SessionHistoryFileMagic.size() && !fileHasCurrentFormat())
+		{
+			// Keep the old file around, but start a new one in the current format. Readers ignore files in a different format.
+			rotateFiles();
+			fileSize = 0;
+		}
+		else
+		{
+			fileSize = truncateIncompleteRecord(fileSize);
+		}
+		_formatWasChecked = true;
+		if (fileSize > SessionHistoryFileMagic.size() && fileSize + numberOfBytes > _maxFileSize)
+		{
+			rotateFiles();
+			fileSize = 0;
+		}
+
+		std::ofstream os{ _path, std::ios::binary | std::ios::app };
+		if (fileSize == 0)
+		{
+			os.write(SessionHistoryFileMagic.data(), (std::streamsize)SessionHistoryFileMagic.size());
+		}
+		os.write(reinterpret_cast<const char*>(records.data()), (std::streamsize)numberOfBytes);
+		os.flush();
+		if (!os)
+		{
+			throw std::runtime_error(fmt::format("Could not append to {}", _path.string()));
+		}
+	}
+
+	uint64_t SessionHistoryWriter::truncateIncompleteRecord(uint64_t fileSize) const
+	{
+		// A crash in the middle of a write can leave part of a record behind. Appending after it would shift every following record
+		const auto headerSize = SessionHistoryFileMagic.size();
+		auto completeFileSize = fileSize < headerSize ? 0 : fileSize - (fileSize - headerSize) % sizeof(SessionRecord);
+		if (completeFileSize != fileSize)
+		{
+			std::filesystem::resize_file(_path, completeFileSize);
+		}
+		return completeFileSize;
+	}
+
+	bool SessionHistoryWriter::fileHasCurrentFormat() const
+	{
+		std::ifstream is{ _path, std::ios::binary };
+		auto magic = decltype(SessionHistoryFileMagic)();
+		is.read(magic.data(), (std::streamsize)magic.size());
+		return is && magic == SessionHistoryFileMagic;
+	}
+
+	void SessionHistoryWriter::rotateFiles() const
+	{
+		std::error_code errorCode;
+		if (_numberOfRotatedFiles == 0)
+		{
+			std::filesystem::remove(_path, errorCode);
+			return;
+		}
+		std::filesystem::remove(rotatedHistoryPath(_path, _numberOfRotatedFiles), errorCode);
+		for (auto rotationNumber = _numberOfRotatedFiles; rotationNumber > 1; rotationNumber--)
+		{
+			std::filesystem::rename(rotatedHistoryPath(_path, rotationNumber - 1), rotatedHistoryPath(_path, rotationNumber), errorCode);
+		}
+		std::filesystem::rename(_path, rotatedHistoryPath(_path, 1), errorCode);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "SessionRecord.h"
+
+#include <DLLImportExport.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace history
+{
+	/**
+	 * The job of this class is to append session records to the history file without ever blocking the caller on file I/O.
+	 *
+	 * Records are collected in memory and written by a background thread, either once enough of them are pending or after a second at the latest.
+	 * Once the file would grow beyond the maximum size, it gets rotated: The current file becomes "<name>.1", "<name>.1" becomes "<name>.2" and so on.
+	 */
+	class RLTT_IMPORT_EXPORT SessionHistoryWriter
+	{
+	public:
+		/** Constructor. */
+		explicit SessionHistoryWriter(std::filesystem::path path, uint64_t maxFileSize = 1024 * 1024, size_t numberOfRotatedFiles = 3);
+		/** Destructor. Writes any pending records. */
+		~SessionHistoryWriter();
+
+		/** Queues the record for being written. */
+		void append(const SessionRecord& record);
+		/** Blocks until every record which was appended so far has been written. */
+		void flush();
+
+	private:
+		void runWriter();
+		void writeRecords(const std::vector<SessionRecord>& records);
+		/** Cuts off a partially written record at the end of the file and returns the new file size. */
+		uint64_t truncateIncompleteRecord(uint64_t fileSize) const;
+		/** Checks whether the file starts with the magic of the current file format, so records of a different size are never appended to it. */
+		bool fileHasCurrentFormat() const;
+		void rotateFiles() const;
+
+		std::filesystem::path _path;
+		uint64_t _maxFileSize;
+		size_t _numberOfRotatedFiles;
+		bool _formatWasChecked = false; // Only accessed by the writer thread
+
+		std::thread _writerThread;
+		std::mutex _mutex; // Protects all members below
+		std::condition_variable _condition;
+		std::vector<SessionRecord> _pendingRecords;
+		bool _flushIsRequested = false;
+		bool _writeIsInProgress = false;
+		bool _writerShallStop = false;
+	};
+}
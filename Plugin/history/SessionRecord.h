@@ -0,0 +1,55 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+
+namespace history
+{
+	/**
+	 * A single entry of the session history file, as it is stored on disk.
+	 *
+	 * Every record has the same size, so files can be read without parsing and a record which was only written partially can be detected easily.
+	 */
+	struct SessionRecord
+	{
+	public:
+		int64_t Timestamp = 0; // Milliseconds since 1970-01-01 (UTC)
+		uint64_t SequenceNumber = 0; // Increases by one with every record, across rotated files. Unlike timestamps, this never repeats or goes back.
+		uint64_t TrainingProgramIdHash = 0; // Allows telling programs apart without storing their IDs in every record
+		uint32_t DurationInMilliseconds = 0; // See training::SessionEventType for which events provide a duration
+		uint16_t StepNumber = 0;
+		uint8_t EventType = 0; // A training::SessionEventType
+		uint8_t Reserved = 0;
+	};
+	static_assert(sizeof(SessionRecord) == 32, "The size of a session record must not change since it is part of the file format");
+	static_assert(std::is_trivially_copyable_v<SessionRecord>, "Session records are written to disk as they are");
+
+	/** The first bytes of every session history file. The last character is the version of the file format. Version 1 did not have sequence numbers. */
+	constexpr std::array<char, 8> SessionHistoryFileMagic = { 'R', 'L', 'T', 'T', 'H', 'I', 'S', '2' };
+
+	/** Retrieves the path of a rotated history file, where 1 is the newest one. */
+	inline std::filesystem::path rotatedHistoryPath(const std::filesystem::path& path, size_t rotationNumber)
+	{
+		auto rotatedPath = path;
+		rotatedPath += "." + std::to_string(rotationNumber);
+		return rotatedPath;
+	}
+
+	/** Interface for classes which want to process session records right after they have been recorded. */
+	class RLTT_IMPORT_EXPORT ISessionRecordReceiver
+	{
+	protected:
+		ISessionRecordReceiver() = default;
+
+	public:
+		virtual ~ISessionRecordReceiver() = default;
+
+		/** Gets called on the thread which drives the training program flow, so implementations must return quickly. */
+		virtual void receiveSessionRecord(const SessionRecord& record) = 0;
+	};
+}
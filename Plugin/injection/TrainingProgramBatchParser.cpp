@@ -0,0 +1,103 @@
+#include <pch.h>
+#include "TrainingProgramBatchParser.h"
+#include <external/nlohmann/json.hpp>
+
+#include <map>
+#include <sstream>
+
+using json = nlohmann::json;
+
+// Allow serialization of std::chrono::milliseconds
+namespace nlohmann {
+	template <>
+	struct adl_serializer<std::chrono::milliseconds> {
+		static void to_json(json& j, const std::chrono::milliseconds& ms) { j = ms.count(); }
+		static void from_json(const json& j, std::chrono::milliseconds& ms) { ms = std::chrono::milliseconds(j); }
+	};
+}
+
+namespace configuration
+{
+	// Allow serialization of training programs
+	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(configuration::TrainingProgramEntry, Name, Duration, Type, TrainingPackCode, WorkshopMapPath);
+	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(configuration::TrainingProgramData, Id, Name, Duration, Entries, ReadOnly);
+}
+
+namespace
+{
+	injection::ParsedTrainingProgram parseTrainingProgram(const json& jsonData)
+	{
+		auto result = injection::ParsedTrainingProgram();
+		try
+		{
+			result.Data = jsonData.get<configuration::TrainingProgramData>();
+		}
+		catch (const json::exception& ex)
+		{
+			result.Error = fmt::format("does not match training program structure: {}", ex.what());
+			return result;
+		}
+		if (result.Data->Id.empty())
+		{
+			result.Data.reset();
+			result.Error = "has no Id";
+		}
+		return result;
+	}
+}
+
+namespace injection
+{
+	std::vector<ParsedTrainingProgram> TrainingProgramBatchParser::parse(const std::string& text)
+	{
+		std::vector<ParsedTrainingProgram> results;
+		const auto firstCharacter = text.find_first_not_of(" \t\r\n");
+		if (firstCharacter != std::string::npos && text[firstCharacter] == '[')
+		{
+			auto jsonData = json::parse(text);
+			results.reserve(jsonData.size());
+			for (const auto& programJson : jsonData)
+			{
+				results.push_back(parseTrainingProgram(programJson));
+			}
+		}
+		else
+		{
+			std::istringstream lines(text);
+			std::string line;
+			while (std::getline(lines, line))
+			{
+				if (line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+				try
+				{
+					results.push_back(parseTrainingProgram(json::parse(line)));
+				}
+				catch (const json::exception& ex)
+				{
+					results.push_back({ std::nullopt, std::nullopt, fmt::format("could not be parsed: {}", ex.what()) });
+				}
+			}
+		}
+
+		std::map<std::string, size_t> lastIndexPerId;
+		for (size_t index = 0; index < results.size(); index++)
+		{
+			if (results[index].Data.has_value())
+			{
+				lastIndexPerId[results[index].Data->Id] = index;
+			}
+		}
+		for (size_t index = 0; index < results.size(); index++)
+		{
+			auto& result = results[index];
+			if (!result.Data.has_value()) { continue; }
+			const auto lastIndex = lastIndexPerId[result.Data->Id];
+			if (lastIndex != index)
+			{
+				result.Data.reset();
+				result.SupersededBy = lastIndex;
+			}
+		}
+		return results;
+	}
+}
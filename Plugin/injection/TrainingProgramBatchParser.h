@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../configuration/data/TrainingProgramData.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <DLLImportExport.h>
+
+namespace injection
+{
+	/** The outcome of parsing a single training program of a batch. */
+	struct ParsedTrainingProgram
+	{
+	public:
+		std::optional<configuration::TrainingProgramData> Data; // Only set if the program shall be injected
+		std::optional<size_t> SupersededBy; // The index of a later program with the same Id, which replaces this one
+		std::string Error; // Only set if the program could not be parsed
+	};
+
+	/**
+	 * The job of this class is to parse a batch of training programs which was passed by another plugin.
+	 * A batch is either a JSON array or one JSON object per line. Programs which can't be parsed don't prevent the others from being injected.
+	 */
+	class RLTT_IMPORT_EXPORT TrainingProgramBatchParser
+	{
+	public:
+		/**
+		 * Parses every training program of the batch. Empty lines are skipped.
+		 * If a program is contained several times, the last one wins, just like when injecting them one by one. Earlier ones are marked as superseded.
+		 *
+		 * \throws	nlohmann::json::exception if the batch is a JSON array which can't be parsed.
+		 */
+		static std::vector<ParsedTrainingProgram> parse(const std::string& text);
+	};
+}
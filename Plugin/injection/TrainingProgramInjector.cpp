@@ -1,6 +1,8 @@
 #include <pch.h>
 #include "TrainingProgramInjector.h"
+#include "TrainingProgramBatchParser.h"
 #include <configuration/data/TrainingProgramData.h>
+#include <diagnostics/PerformanceCounters.h>
 #include <external/nlohmann/json.hpp>
 #include <algorithm>
 
@@ -24,12 +26,26 @@ namespace configuration
 	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(configuration::TrainingProgramData, Id, Name, Duration, Entries, ReadOnly);
 }
 
+namespace
+{
+	const char* describe(configuration::InjectionResult result)
+	{
+		switch (result)
+		{
+		case configuration::InjectionResult::Added: return "added";
+		case configuration::InjectionResult::Replaced: return "replaced";
+		default: return "unchanged";
+		}
+	}
+}
+
 namespace injection
 {
 
 	const std::string TrainingProgramInjector::InjectProgramNotifier = "rltt_inject_training_program";
 	const std::string TrainingProgramInjector::RunProgramNotifier = "rltt_run_training_program";
 	const std::string TrainingProgramInjector::InjectAndRunProgramNotifier = "rltt_inject_and_run_training_program";
+	const std::string TrainingProgramInjector::InjectProgramsNotifier = "rltt_inject_training_programs";
 
 	TrainingProgramInjector::TrainingProgramInjector(
 		std::shared_ptr<CVarManagerWrapper> cvarManager,
@@ -67,14 +83,9 @@ namespace injection
 			executeTrainingProgram(uuid);
 		}, "", PERMISSION_ALL);
 
-		_cvarManager->registerNotifier(InjectAndRunProgramNotifier, [this](const std::vector<std::string>& params) {
-			auto uuid = receiveTrainingProgram(params);
-			if (uuid.empty())
-			{
-				return; // Log message has already been shown
-			}
-			executeTrainingProgram(uuid);
-			}, "", PERMISSION_ALL);
+		_cvarManager->registerNotifier(InjectProgramsNotifier, [this](const std::vector<std::string>& params) {
+			receiveTrainingPrograms(params);
+		}, "", PERMISSION_ALL);
 	}
 
 	std::string TrainingProgramInjector::receiveTrainingProgram(const std::vector<std::string>& params)
@@ -87,32 +98,102 @@ namespace injection
 			return std::string();
 		}
 
-		json jsonData;
-		try
+		configuration::TrainingProgramData trainingProgramData;
 		{
-			jsonData = json::parse(params[1]);
+			RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::InjectionParsing);
+			json jsonData;
+			try
+			{
+				jsonData = json::parse(params[1]);
+			}
+			catch (const json::exception& ex)
+			{
+				_errorDisplay->displayErrorMessage("Could not parse JSON Data", ex.what());
+				return std::string();
+			}
+
+			try
+			{
+				trainingProgramData = jsonData.get<configuration::TrainingProgramData>();
+			}
+			catch (const json::exception& ex)
+			{
+				_errorDisplay->displayErrorMessage("JSON Data does not match training program structure", ex.what());
+				LOG("ERROR: JSON Data was: {}", jsonData.dump(2));
+				return std::string();
+			}
 		}
-		catch (json::exception ex)
+
+		LOG("Successfully deserialized training program. Trying to inject it.");
+		_programListControl->injectTrainingProgram(trainingProgramData);
+		return trainingProgramData.Id;
+	}
+
+	void TrainingProgramInjector::receiveTrainingPrograms(const std::vector<std::string>& params)
+	{
+		_errorDisplay->clearErrorMessages();
+
+		if (params.size() != 2)
 		{
-			_errorDisplay->displayErrorMessage("Could not parse JSON Data", ex.what());
-			return std::string();
+			_errorDisplay->displayErrorMessage("Invalid syntax", fmt::format("Syntax is : {} <json_array_or_one_json_object_per_line>", InjectProgramsNotifier));
+			return;
 		}
 
-		configuration::TrainingProgramData trainingProgramData;
-		try
+		std::vector<ParsedTrainingProgram> parsedPrograms;
 		{
-			trainingProgramData = jsonData.get<configuration::TrainingProgramData>();
+			RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::InjectionParsing);
+			try
+			{
+				parsedPrograms = TrainingProgramBatchParser::parse(params[1]);
+			}
+			catch (const json::exception& ex)
+			{
+				_errorDisplay->displayErrorMessage("Could not parse JSON Data", ex.what());
+				return;
+			}
 		}
-		catch (json::exception ex)
+
+		std::vector<configuration::TrainingProgramData> programsToInject;
+		for (const auto& parsedProgram : parsedPrograms)
 		{
-			_errorDisplay->displayErrorMessage("JSON Data does not match training program structure", ex.what());
-			LOG("ERROR: JSON Data was: {}", jsonData.dump(2));
-			return std::string();
+			if (parsedProgram.Data.has_value())
+			{
+				programsToInject.push_back(parsedProgram.Data.value());
+			}
 		}
 
-		LOG("Successfully deserialized training program. Trying to inject it.");
-		_programListControl->injectTrainingProgram(trainingProgramData);
-		return trainingProgramData.Id;
+		const auto injectionResults = _programListControl->injectTrainingPrograms(programsToInject);
+
+		size_t numberOfSupersededPrograms = 0;
+		size_t numberOfFailures = 0;
+		for (size_t index = 0, injectedIndex = 0; index < parsedPrograms.size(); index++)
+		{
+			const auto& parsedProgram = parsedPrograms[index];
+			if (parsedProgram.Data.has_value())
+			{
+				LOG("Training program #{} ({}): {}", index, parsedProgram.Data->Id, describe(injectionResults[injectedIndex]));
+				injectedIndex++;
+			}
+			else if (parsedProgram.SupersededBy.has_value())
+			{
+				LOG("Training program #{} is superseded by program #{} with the same Id", index, parsedProgram.SupersededBy.value());
+				numberOfSupersededPrograms++;
+			}
+			else
+			{
+				LOG("ERROR: Training program #{} {}", index, parsedProgram.Error);
+				numberOfFailures++;
+			}
+		}
+		LOG("Received {} training programs, {} of which were injected or up to date already, {} superseded and {} failed",
+			parsedPrograms.size(), programsToInject.size(), numberOfSupersededPrograms, numberOfFailures);
+		if (numberOfFailures > 0)
+		{
+			_errorDisplay->displayErrorMessage(
+				"Some training programs were not injected",
+				fmt::format("{} out of {} training programs could not be parsed. See the console for details.", numberOfFailures, parsedPrograms.size())
+			);
+		}
 	}
 
 	void TrainingProgramInjector::executeTrainingProgram(const std::string& uuid) const
@@ -29,6 +29,11 @@ namespace injection
 		 */
 		std::string receiveTrainingProgram(const std::vector<std::string>& params);
 
+		/** Receives several training programs from another plugin, either as a JSON array or as one JSON object per line.
+		 * All valid programs get injected at once, so they are only stored once. The result of every program gets logged.
+		 */
+		void receiveTrainingPrograms(const std::vector<std::string>& params);
+
 		/** Executes the training program with the given ID. */
 		void executeTrainingProgram(const std::string& uuid) const;
 
@@ -39,5 +44,6 @@ namespace injection
 		static const std::string InjectProgramNotifier;
 		static const std::string RunProgramNotifier;
 		static const std::string InjectAndRunProgramNotifier;
+		static const std::string InjectProgramsNotifier;
 	};
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define _CRT_SECURE_NO_WARNINGS
 #include <Windows.h>
+#endif
 
 #include "bakkesmod/plugin/bakkesmodplugin.h"
 
@@ -21,5 +23,9 @@ extern std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
 template<typename S, typename... Args>
 void LOG(const S& format_str, Args&&... args)
 {
+	if (_globalCvarManager == nullptr)
+	{
+		return; // Not loaded by bakkesmod (e.g. in unit tests)
+	}
 	_globalCvarManager->log(fmt::format(format_str, args...));
 }
\ No newline at end of file
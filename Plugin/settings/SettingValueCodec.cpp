@@ -0,0 +1,108 @@
+#include <pch.h>
+#include "SettingValueCodec.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+	std::string_view trim(std::string_view text)
+	{
+		const auto start = text.find_first_not_of(" \t");
+		if (start == std::string_view::npos) { return {}; }
+		return text.substr(start, text.find_last_not_of(" \t") - start + 1);
+	}
+
+	std::optional<double> parseNumber(std::string_view text)
+	{
+		const auto trimmed = std::string(trim(text)); // strtod needs a terminating zero
+		if (trimmed.empty()) { return {}; }
+		char* end = nullptr;
+		const auto value = std::strtod(trimmed.c_str(), &end);
+		if (end != trimmed.c_str() + trimmed.size() || !std::isfinite(value)) { return {}; }
+		return value;
+	}
+
+	uint8_t toByte(float component)
+	{
+		return (uint8_t)std::lround(std::clamp(component, 0.0f, 1.0f) * 255.0f);
+	}
+}
+
+namespace settings
+{
+	std::string SettingValueCodec::format(bool value)
+	{
+		return value ? "1" : "0";
+	}
+
+	std::string SettingValueCodec::format(int value)
+	{
+		return std::to_string(value);
+	}
+
+	std::string SettingValueCodec::format(float value)
+	{
+		return fmt::format("{}", value); // Shortest text which parses back to the same value
+	}
+
+	std::string SettingValueCodec::format(const Color& value)
+	{
+		return fmt::format("#{:02X}{:02X}{:02X}{:02X}", toByte(value.Red), toByte(value.Green), toByte(value.Blue), toByte(value.Alpha));
+	}
+
+	std::optional<bool> SettingValueCodec::parseBool(std::string_view text)
+	{
+		const auto trimmed = trim(text);
+		if (trimmed == "true") { return true; }
+		if (trimmed == "false") { return false; }
+		if (auto number = parseNumber(trimmed); number.has_value())
+		{
+			return number.value() != 0.0;
+		}
+		return {};
+	}
+
+	std::optional<int> SettingValueCodec::parseInt(std::string_view text)
+	{
+		const auto trimmed = trim(text);
+		int value = 0;
+		if (auto [end, error] = std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), value); error == std::errc() && end == trimmed.data() + trimmed.size())
+		{
+			return value;
+		}
+		if (auto number = parseNumber(trimmed); number.has_value() && std::abs(number.value()) < 2e9)
+		{
+			return (int)std::lround(number.value());
+		}
+		return {};
+	}
+
+	std::optional<float> SettingValueCodec::parseFloat(std::string_view text)
+	{
+		if (auto number = parseNumber(text); number.has_value())
+		{
+			return (float)number.value();
+		}
+		return {};
+	}
+
+	std::optional<Color> SettingValueCodec::parseColor(std::string_view text)
+	{
+		const auto trimmed = trim(text);
+		if (trimmed.empty() || trimmed.front() != '#' || (trimmed.size() != 7 && trimmed.size() != 9)) { return {}; }
+
+		uint32_t components[4] = { 0, 0, 0, 255 };
+		for (size_t index = 0; index < (trimmed.size() - 1) / 2; index++)
+		{
+			const auto* start = trimmed.data() + 1 + index * 2;
+			if (auto [end, error] = std::from_chars(start, start + 2, components[index], 16); error != std::errc() || end != start + 2)
+			{
+				return {};
+			}
+		}
+		return Color{ components[0] / 255.0f, components[1] / 255.0f, components[2] / 255.0f, components[3] / 255.0f };
+	}
+}
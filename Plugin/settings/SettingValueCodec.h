@@ -0,0 +1,45 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace settings
+{
+	/** An RGBA color. Every component is in the range [0, 1]. */
+	struct Color
+	{
+	public:
+		float Red = 0.0f;
+		float Green = 0.0f;
+		float Blue = 0.0f;
+		float Alpha = 1.0f;
+
+		inline bool operator==(const Color& other) const { return Red == other.Red && Green == other.Green && Blue == other.Blue && Alpha == other.Alpha; }
+		inline bool operator!=(const Color& other) const { return !(*this == other); }
+	};
+
+	/**
+	 * The job of this class is to convert setting values to and from the text which is stored in a cvar.
+	 * Parsing returns nothing if the text does not contain a valid value.
+	 */
+	class RLTT_IMPORT_EXPORT SettingValueCodec
+	{
+	public:
+		static std::string format(bool value);
+		static std::string format(int value);
+		static std::string format(float value);
+		/** Formats the color as #RRGGBBAA, like BakkesMod does for color cvars. */
+		static std::string format(const Color& value);
+
+		/** Accepts any number (where everything but zero is true), "true" and "false". */
+		static std::optional<bool> parseBool(std::string_view text);
+		/** Accepts integers, and rounds decimal numbers, since BakkesMod might store an int cvar as "5.000000". */
+		static std::optional<int> parseInt(std::string_view text);
+		static std::optional<float> parseFloat(std::string_view text);
+		/** Accepts #RRGGBB and #RRGGBBAA. */
+		static std::optional<Color> parseColor(std::string_view text);
+	};
+}
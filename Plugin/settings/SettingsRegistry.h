@@ -0,0 +1,190 @@
+#pragma once
+
+#include "SettingValueCodec.h"
+#include "../training/control/ICVarManager.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace settings
+{
+	/** A value of an enum setting, together with the text which is stored in the cvar and displayed in the UI. */
+	template <typename Enum>
+	struct EnumValueName
+	{
+	public:
+		Enum Value;
+		const char* Name;
+	};
+
+	/**
+	 * The job of this class is to provide typed settings which are stored in cvars, without having to read or compare cvar text on every frame.
+	 *
+	 * Every setting is described at compile time by a struct like this:
+	 *
+	 *   struct ExampleSetting
+	 *   {
+	 *       using ValueType = int;                               // bool, int, float, Color, std::string or an enum
+	 *       static constexpr const char* CvarName = "...";
+	 *       static constexpr const char* Description = "...";
+	 *       static constexpr int DefaultValue = 5;               // A const char* for std::string
+	 *       static constexpr int Minimum = 1;                    // Only for int and float
+	 *       static constexpr int Maximum = 30;
+	 *       static constexpr std::array<EnumValueName<...>, N> Values = { ... }; // Only for enums
+	 *   };
+	 *
+	 * The text of a cvar only gets parsed when the cvar changes, so reading a setting is a plain memory access.
+	 * Subscribers get told about every change, regardless of whether it came from the UI or from the console.
+	 */
+	template <typename... Settings>
+	class SettingsRegistry
+	{
+	public:
+		/** Constructor. Settings have their default values until loadFromCvars() or receiveCvarValue() gets called. */
+		explicit SettingsRegistry(std::shared_ptr<ICVarManager> cvarManager)
+			: _cvarManager{ std::move(cvarManager) }
+		{
+		}
+
+		/** Retrieves the current value of a setting. */
+		template <typename Setting>
+		const typename Setting::ValueType& get() const
+		{
+			return std::get<Slot<Setting>>(_slots).Value;
+		}
+
+		/** Changes a setting, notifies subscribers and stores the new value in the cvar. Does nothing if the value does not change. */
+		template <typename Setting>
+		void set(typename Setting::ValueType value)
+		{
+			if (update<Setting>(std::move(value)))
+			{
+				_cvarManager->setCvarValue(Setting::CvarName, formatValue<Setting>(get<Setting>())); // The cvar notification won't change anything anymore
+			}
+		}
+
+		/** Calls the given function whenever the value of a setting changes. */
+		template <typename Setting>
+		void subscribe(std::function<void(const typename Setting::ValueType&)> subscriber)
+		{
+			std::get<Slot<Setting>>(_slots).Subscribers.push_back(std::move(subscriber));
+		}
+
+		/** Updates a setting from the text of its cvar, e.g. when the cvar was changed. Returns false if the text is not a valid value, in which case the setting is not changed. */
+		template <typename Setting>
+		bool receiveCvarValue(const std::string& text)
+		{
+			auto value = parseValue<Setting>(text);
+			if (!value.has_value()) { return false; }
+			update<Setting>(std::move(value.value()));
+			return true;
+		}
+
+		/** Updates all settings from their cvars. Settings whose cvar does not contain a valid value keep their current value. */
+		void loadFromCvars()
+		{
+			(receiveCvarValue<Settings>(_cvarManager->getCvarValue(Settings::CvarName)), ...);
+		}
+
+		/** Calls the given function with a default constructed descriptor of every setting, e.g. for registering the cvars. */
+		template <typename Function>
+		static void forEachSetting(Function&& function)
+		{
+			(function(Settings{}), ...);
+		}
+
+		/** Converts a value of a setting into the text which is stored in its cvar. */
+		template <typename Setting>
+		static std::string formatValue(const typename Setting::ValueType& value)
+		{
+			using ValueType = typename Setting::ValueType;
+			if constexpr (std::is_enum_v<ValueType>)
+			{
+				for (const auto& entry : Setting::Values)
+				{
+					if (entry.Value == value) { return entry.Name; }
+				}
+				return formatValue<Setting>(Setting::DefaultValue);
+			}
+			else if constexpr (std::is_same_v<ValueType, std::string>)
+			{
+				return value;
+			}
+			else
+			{
+				return SettingValueCodec::format(value);
+			}
+		}
+
+		/** Converts the text of a cvar into a value of a setting. Numbers get clamped to the range of the setting. */
+		template <typename Setting>
+		static std::optional<typename Setting::ValueType> parseValue(const std::string& text)
+		{
+			using ValueType = typename Setting::ValueType;
+			if constexpr (std::is_enum_v<ValueType>)
+			{
+				for (const auto& entry : Setting::Values)
+				{
+					if (text == entry.Name) { return entry.Value; }
+				}
+				return {};
+			}
+			else if constexpr (std::is_same_v<ValueType, std::string>)
+			{
+				return text;
+			}
+			else if constexpr (std::is_same_v<ValueType, bool>)
+			{
+				return SettingValueCodec::parseBool(text);
+			}
+			else if constexpr (std::is_same_v<ValueType, int>)
+			{
+				auto value = SettingValueCodec::parseInt(text);
+				if (!value.has_value()) { return {}; }
+				return std::clamp<int>(value.value(), Setting::Minimum, Setting::Maximum);
+			}
+			else if constexpr (std::is_same_v<ValueType, float>)
+			{
+				auto value = SettingValueCodec::parseFloat(text);
+				if (!value.has_value()) { return {}; }
+				return std::clamp<float>(value.value(), Setting::Minimum, Setting::Maximum);
+			}
+			else
+			{
+				static_assert(std::is_same_v<ValueType, Color>, "Settings must be bool, int, float, Color, std::string or an enum");
+				return SettingValueCodec::parseColor(text);
+			}
+		}
+
+	private:
+		/** The current value of a setting, and who wants to know about changes. */
+		template <typename Setting>
+		struct Slot
+		{
+			typename Setting::ValueType Value = Setting::DefaultValue;
+			std::vector<std::function<void(const typename Setting::ValueType&)>> Subscribers;
+		};
+
+		template <typename Setting>
+		bool update(typename Setting::ValueType value)
+		{
+			auto& slot = std::get<Slot<Setting>>(_slots);
+			if (slot.Value == value) { return false; }
+			slot.Value = std::move(value);
+			for (const auto& subscriber : slot.Subscribers)
+			{
+				subscriber(slot.Value);
+			}
+			return true;
+		}
+
+		std::shared_ptr<ICVarManager> _cvarManager;
+		std::tuple<Slot<Settings>...> _slots;
+	};
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "SettingsRegistry.h"
+
+#include <array>
+#include <string>
+
+namespace settings
+{
+	/** The way the current training step gets displayed at the bottom of the screen. */
+	enum class BarStyle
+	{
+		BlueBar,
+		Minimal,
+		Hidden
+	};
+
+	struct BarStyleSetting
+	{
+		using ValueType = BarStyle;
+		static constexpr const char* CvarName = "RLTrainingTimer_barstyle";
+		static constexpr const char* Description = "Bottom bar style [blue bar (more visible), minimal (less annoying), none (hide)]";
+		static constexpr BarStyle DefaultValue = BarStyle::Minimal;
+		static constexpr std::array<EnumValueName<BarStyle>, 3> Values = { {
+			{ BarStyle::Minimal, "minimal (less annoying)" },
+			{ BarStyle::BlueBar, "blue bar (more visible)" },
+			{ BarStyle::Hidden, "none (hide)" }
+		} };
+	};
+
+	struct PreloadEnabledSetting
+	{
+		using ValueType = bool;
+		static constexpr const char* CvarName = "RLTrainingTimer_preload_enabled";
+		static constexpr const char* Description = "Load the map of the next step before the current step ends";
+		static constexpr bool DefaultValue = false;
+	};
+
+	struct PreloadLeadTimeSetting
+	{
+		using ValueType = int;
+		static constexpr const char* CvarName = "RLTrainingTimer_preload_lead_seconds";
+		static constexpr const char* Description = "How many seconds before the end of a step the next map shall be loaded, until the actual load time has been measured";
+		static constexpr int DefaultValue = 5;
+		static constexpr int Minimum = 1;
+		static constexpr int Maximum = 30;
+	};
+
+	struct PreStepCommandsSetting
+	{
+		using ValueType = std::string;
+		static constexpr const char* CvarName = "RLTrainingTimer_pre_step_commands";
+		static constexpr const char* Description = "Console commands which shall be executed at the start of every training step, separated by semicolons";
+		static constexpr const char* DefaultValue = "";
+	};
+
+	/** All typed settings of the plugin. Add further display options (size, opacity, position, ...) here. */
+	using TrainingTimerSettings = SettingsRegistry<BarStyleSetting, PreloadEnabledSetting, PreloadLeadTimeSetting, PreStepCommandsSetting>;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "QuantileSketch.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace statistics
+{
+	/** POD struct which sums up everything that happened in one step of a training program, across all sessions. */
+	struct StepStatistics
+	{
+	public:
+		uint32_t TimesStarted = 0;
+		uint32_t TimesSkipped = 0;
+		uint32_t PacksCompleted = 0;
+		uint64_t TimeTrainedInMilliseconds = 0; // Without pauses
+		uint64_t PackCompletionTimeSumInMilliseconds = 0;
+		QuantileSketch PackCompletionTimes; // In milliseconds
+
+		/** Retrieves the fraction of starts of this step which were skipped. */
+		inline double skipFrequency() const { return TimesStarted == 0 ? 0.0 : (double)TimesSkipped / TimesStarted; }
+		/** Retrieves the average time it took to complete the training pack of this step, in milliseconds. */
+		inline double averagePackCompletionTime() const { return PacksCompleted == 0 ? 0.0 : (double)PackCompletionTimeSumInMilliseconds / PacksCompleted; }
+		/** Estimates the median time it took to complete the training pack of this step, in milliseconds. */
+		inline double medianPackCompletionTime() const { return PackCompletionTimes.quantile(0.5); }
+	};
+
+	/** POD struct which sums up all sessions of a training program. */
+	struct ProgramStatistics
+	{
+	public:
+		uint32_t SessionsStarted = 0;
+		uint32_t SessionsFinished = 0;
+		uint32_t SessionsStopped = 0;
+		uint64_t TimeTrainedInMilliseconds = 0; // Without pauses
+		int64_t LastTrainingDay = 0; // Days since 1970-01-01 (UTC)
+		uint32_t StreakInDays = 0; // The number of consecutive days up to the last training day on which the program was started
+		uint32_t LongestStreakInDays = 0;
+		std::vector<StepStatistics> Steps; // Indexed by step number
+
+		/** Retrieves the fraction of sessions which were run until the end. */
+		inline double completionRate() const { return SessionsStarted == 0 ? 0.0 : (double)SessionsFinished / SessionsStarted; }
+		/** Retrieves the current streak, which is zero if the program was neither started today nor yesterday. */
+		inline uint32_t currentStreakInDays(int64_t today) const { return today - LastTrainingDay <= 1 ? StreakInDays : 0; }
+	};
+}
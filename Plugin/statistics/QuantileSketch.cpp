@@ -0,0 +1,78 @@
+#include <pch.h>
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	constexpr double Gamma = (1.0 + statistics::QuantileSketch::RelativeAccuracy) / (1.0 - statistics::QuantileSketch::RelativeAccuracy);
+	const double LogGamma = std::log(Gamma);
+
+	int32_t bucketIndex(double value)
+	{
+		return (int32_t)std::ceil(std::log(value) / LogGamma);
+	}
+
+	/** Retrieves the value which has the same relative distance to both bounds of the bucket. */
+	double bucketValue(int32_t index)
+	{
+		return 2.0 * std::pow(Gamma, index) / (Gamma + 1.0);
+	}
+}
+
+namespace statistics
+{
+	void QuantileSketch::add(double value)
+	{
+		_count++;
+		if (value < 1.0)
+		{
+			_zeroCount++;
+			return;
+		}
+		_bucketCounts[bucketIndex(value)]++;
+	}
+
+	void QuantileSketch::merge(const QuantileSketch& other)
+	{
+		for (const auto& [index, bucketCount] : other._bucketCounts)
+		{
+			_bucketCounts[index] += bucketCount;
+		}
+		_zeroCount += other._zeroCount;
+		_count += other._count;
+	}
+
+	double QuantileSketch::quantile(double fraction) const
+	{
+		if (_count == 0) { return 0.0; }
+
+		// Find the bucket which contains the value at the requested rank
+		const auto rank = (uint64_t)(std::clamp(fraction, 0.0, 1.0) * (double)(_count - 1));
+		auto numberOfLowerValues = _zeroCount;
+		if (rank < numberOfLowerValues) { return 0.0; }
+		for (const auto& [index, bucketCount] : _bucketCounts)
+		{
+			numberOfLowerValues += bucketCount;
+			if (rank < numberOfLowerValues)
+			{
+				return bucketValue(index);
+			}
+		}
+		return bucketValue(_bucketCounts.rbegin()->first);
+	}
+
+	QuantileSketch QuantileSketch::fromBucketCounts(std::map<int32_t, uint64_t> bucketCounts, uint64_t zeroCount)
+	{
+		auto sketch = QuantileSketch();
+		sketch._bucketCounts = std::move(bucketCounts);
+		sketch._zeroCount = zeroCount;
+		sketch._count = zeroCount;
+		for (const auto& [index, bucketCount] : sketch._bucketCounts)
+		{
+			sketch._count += bucketCount;
+		}
+		return sketch;
+	}
+}
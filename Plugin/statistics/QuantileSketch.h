@@ -0,0 +1,47 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <cstdint>
+#include <map>
+
+namespace statistics
+{
+	/**
+	 * The job of this class is to estimate quantiles (e.g. the median) of a series of positive values without storing the values themselves.
+	 *
+	 * Values are counted in buckets which grow exponentially, so every estimate is off by at most RelativeAccuracy, no matter how large the values are.
+	 * Adding a value costs the same regardless of how many values were added before, and two sketches can be merged by adding up their buckets.
+	 * A few dozen buckets are usually enough for the times it takes to complete a training pack.
+	 */
+	class RLTT_IMPORT_EXPORT QuantileSketch
+	{
+	public:
+		/** The maximum relative error of quantile estimates. This is part of the persisted format, so sketches stay mergeable. */
+		static constexpr double RelativeAccuracy = 0.01;
+
+		/** Adds a value. Values below 1 are counted, but estimated as zero. */
+		void add(double value);
+
+		/** Adds all values of the other sketch to this one. */
+		void merge(const QuantileSketch& other);
+
+		/** Estimates the value below which the given fraction (0..1) of values lies. Returns zero for an empty sketch. */
+		double quantile(double fraction) const;
+
+		/** Retrieves the number of values which were added. */
+		inline uint64_t count() const { return _count; }
+
+		/** Provides the bucket counts for persisting the sketch. */
+		inline const std::map<int32_t, uint64_t>& bucketCounts() const { return _bucketCounts; }
+		inline uint64_t zeroCount() const { return _zeroCount; }
+
+		/** Restores a sketch from persisted bucket counts. */
+		static QuantileSketch fromBucketCounts(std::map<int32_t, uint64_t> bucketCounts, uint64_t zeroCount);
+
+	private:
+		std::map<int32_t, uint64_t> _bucketCounts; // Bucket i counts values in (gamma^(i-1), gamma^i]
+		uint64_t _zeroCount = 0;
+		uint64_t _count = 0;
+	};
+}
@@ -0,0 +1,247 @@
+#include <pch.h>
+#include "TrainingStatistics.h"
+
+#include "../configuration/control/TrainingProgramHasher.h"
+#include "../history/SessionHistoryReader.h"
+#include "../training/data/SessionEvent.h"
+
+#include <external/nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace statistics
+{
+	// Allow serialization of statistics. Missing values are defaulted so the rollup format can be extended later.
+	void to_json(json& j, const QuantileSketch& sketch)
+	{
+		j = json{ { "Buckets", sketch.bucketCounts() }, { "Zeros", sketch.zeroCount() } };
+	}
+	void from_json(const json& j, QuantileSketch& sketch)
+	{
+		sketch = QuantileSketch::fromBucketCounts(j.value("Buckets", std::map<int32_t, uint64_t>()), j.value("Zeros", (uint64_t)0));
+	}
+	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(StepStatistics, TimesStarted, TimesSkipped, PacksCompleted, TimeTrainedInMilliseconds, PackCompletionTimeSumInMilliseconds, PackCompletionTimes);
+	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ProgramStatistics, SessionsStarted, SessionsFinished, SessionsStopped, TimeTrainedInMilliseconds, LastTrainingDay, StreakInDays, LongestStreakInDays, Steps);
+
+	/**
+	 * The contents of the rollup file. Programs are identified by the hex representation of the hash of their ID.
+	 * Versions 1 and 2 did not store the sequence number of the last applied record, so the history can't be used for catching up with them.
+	 */
+	struct StatisticsRollup
+	{
+		int Version = 3;
+		uint64_t LastAppliedSequenceNumber = 0;
+		std::map<std::string, ProgramStatistics> Programs;
+	};
+	NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(StatisticsRollup, Version, LastAppliedSequenceNumber, Programs);
+
+	std::optional<StatisticsRollup> tryDeserializeRollup(const std::string& contents)
+	{
+		try
+		{
+			return json::parse(contents).get<StatisticsRollup>();
+		}
+		catch (const json::exception& ex)
+		{
+			LOG("Failed restoring training statistics: {}", ex.what());
+			return {};
+		}
+	}
+
+	TrainingStatistics::TrainingStatistics(std::filesystem::path rollupPath, const std::filesystem::path& historyPath)
+		: _storage(std::move(rollupPath), 1) // Statistics can be rebuilt from the history, so one backup is plenty
+		, _writer(_storage)
+	{
+		load(historyPath);
+	}
+
+	void TrainingStatistics::receiveSessionRecord(const history::SessionRecord& record)
+	{
+		apply(record);
+
+		const auto eventType = (training::SessionEventType)record.EventType;
+		if (eventType == training::SessionEventType::ProgramFinished || eventType == training::SessionEventType::ProgramStopped)
+		{
+			save();
+		}
+	}
+
+	void TrainingStatistics::apply(const history::SessionRecord& record)
+	{
+		using training::SessionEventType;
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (record.SequenceNumber <= _lastAppliedSequenceNumber)
+		{
+			return; // Already contained in the statistics
+		}
+		_lastAppliedSequenceNumber = record.SequenceNumber;
+		auto& programStatistics = _programStatistics[record.TrainingProgramIdHash];
+		if (programStatistics.Steps.size() <= record.StepNumber)
+		{
+			programStatistics.Steps.resize((size_t)record.StepNumber + 1);
+		}
+		auto& stepStatistics = programStatistics.Steps[record.StepNumber];
+		_revision++;
+
+		switch ((SessionEventType)record.EventType)
+		{
+		case SessionEventType::ProgramStarted:
+		{
+			programStatistics.SessionsStarted++;
+			const auto day = toDay(record.Timestamp);
+			if (programStatistics.StreakInDays == 0 || day - programStatistics.LastTrainingDay > 1)
+			{
+				programStatistics.StreakInDays = 1;
+			}
+			else if (day - programStatistics.LastTrainingDay == 1)
+			{
+				programStatistics.StreakInDays++;
+			}
+			programStatistics.LastTrainingDay = std::max(programStatistics.LastTrainingDay, day);
+			programStatistics.LongestStreakInDays = std::max(programStatistics.LongestStreakInDays, programStatistics.StreakInDays);
+			break;
+		}
+		case SessionEventType::StepStarted:
+			stepStatistics.TimesStarted++;
+			_packWasCompletedInCurrentStep = false;
+			break;
+		case SessionEventType::StepSkipped:
+			stepStatistics.TimesSkipped++;
+			break;
+		case SessionEventType::PackCompleted:
+			_packWasCompletedInCurrentStep = true;
+			break;
+		case SessionEventType::StepEnded:
+			stepStatistics.TimeTrainedInMilliseconds += record.DurationInMilliseconds;
+			programStatistics.TimeTrainedInMilliseconds += record.DurationInMilliseconds;
+			if (_packWasCompletedInCurrentStep)
+			{
+				stepStatistics.PacksCompleted++;
+				stepStatistics.PackCompletionTimeSumInMilliseconds += record.DurationInMilliseconds;
+				stepStatistics.PackCompletionTimes.add(record.DurationInMilliseconds);
+				_packWasCompletedInCurrentStep = false;
+			}
+			break;
+		case SessionEventType::ProgramFinished:
+			programStatistics.SessionsFinished++;
+			break;
+		case SessionEventType::ProgramStopped:
+			programStatistics.SessionsStopped++;
+			break;
+		default:
+			break; // Pauses and map loads are already excluded from the step durations
+		}
+	}
+
+	std::optional<std::chrono::milliseconds> TrainingStatistics::estimateCompletionTime(const std::string& trainingProgramId, uint16_t stepNumber) const
+	{
+		const auto hash = configuration::TrainingProgramHasher::hashText(trainingProgramId);
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto iter = _programStatistics.find(hash);
+		if (iter == _programStatistics.end() || stepNumber >= iter->second.Steps.size() || iter->second.Steps[stepNumber].PacksCompleted == 0)
+		{
+			return {};
+		}
+		// The median is not thrown off by a single session where the player got distracted
+		return std::chrono::milliseconds((long long)iter->second.Steps[stepNumber].medianPackCompletionTime());
+	}
+
+	std::optional<ProgramStatistics> TrainingStatistics::getProgramStatistics(const std::string& trainingProgramId) const
+	{
+		const auto hash = configuration::TrainingProgramHasher::hashText(trainingProgramId);
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (auto iter = _programStatistics.find(hash); iter != _programStatistics.end())
+		{
+			return iter->second;
+		}
+		return {};
+	}
+
+	uint64_t TrainingStatistics::revision() const
+	{
+		return _revision;
+	}
+
+	void TrainingStatistics::save()
+	{
+		_writer.write(serialize()); // Errors are logged by the writer thread
+	}
+
+	void TrainingStatistics::flush()
+	{
+		_writer.flush();
+	}
+
+	int64_t TrainingStatistics::toDay(int64_t timestamp)
+	{
+		constexpr int64_t MillisecondsPerDay = 24 * 60 * 60 * 1000;
+		return timestamp >= 0 ? timestamp / MillisecondsPerDay : (timestamp - MillisecondsPerDay + 1) / MillisecondsPerDay;
+	}
+
+	void TrainingStatistics::load(const std::filesystem::path& historyPath)
+	{
+		if (auto contents = _storage.read([](const std::string& contents) { return tryDeserializeRollup(contents).has_value(); }); contents.has_value())
+		{
+			auto rollup = tryDeserializeRollup(contents.value()); // Must outlive the loop, since the loop only references its programs
+			for (auto& [key, programStatistics] : rollup->Programs)
+			{
+				_programStatistics.emplace(std::stoull(key, nullptr, 16), std::move(programStatistics));
+			}
+			_lastAppliedSequenceNumber = rollup->LastAppliedSequenceNumber;
+			if (rollup->Version >= 3 && !historyPath.empty())
+			{
+				catchUpWithHistory(historyPath);
+			}
+			return;
+		}
+
+		if (historyPath.empty()) { return; }
+		const auto records = history::SessionHistoryReader(historyPath).readAll();
+		if (records.empty()) { return; }
+
+		LOG("Building training statistics from {} recorded events. This only happens once.", records.size());
+		for (const auto& record : records)
+		{
+			apply(record);
+		}
+		save();
+	}
+
+	void TrainingStatistics::catchUpWithHistory(const std::filesystem::path& historyPath)
+	{
+		const auto reader = history::SessionHistoryReader(historyPath);
+		const auto lastRecord = reader.readLastRecord();
+		const auto lastRecordedSequenceNumber = lastRecord.has_value() ? lastRecord->SequenceNumber : 0;
+		if (lastRecordedSequenceNumber < _lastAppliedSequenceNumber)
+		{
+			// The history was deleted or replaced, so the recorder starts counting again. Newer records would be ignored otherwise.
+			LOG("The session history is older than the training statistics. Only events recorded from now on will be added.");
+			_lastAppliedSequenceNumber = lastRecordedSequenceNumber;
+			return;
+		}
+
+		const auto records = reader.readAfter(_lastAppliedSequenceNumber);
+		if (records.empty()) { return; }
+
+		LOG("Adding {} events to the training statistics which were recorded after they were last stored", records.size());
+		for (const auto& record : records)
+		{
+			apply(record);
+		}
+		save();
+	}
+
+	std::string TrainingStatistics::serialize() const
+	{
+		auto rollup = StatisticsRollup();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			rollup.LastAppliedSequenceNumber = _lastAppliedSequenceNumber;
+			for (const auto& [hash, programStatistics] : _programStatistics)
+			{
+				rollup.Programs.emplace(fmt::format("{:016x}", hash), programStatistics);
+			}
+		}
+		return json(rollup).dump();
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ProgramStatistics.h"
+#include "../history/SessionRecord.h"
+#include "../training/control/ICompletionTimeEstimator.h"
+#include "../configuration/control/CrashSafeFileStorage.h"
+#include "../configuration/control/DebouncedFileWriter.h"
+
+#include <DLLImportExport.h>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace statistics
+{
+	/**
+	 * The job of this class is to keep statistics about every training program and each of its steps up to date while training.
+	 *
+	 * Every event only updates a few counters, so the raw session history never has to be read again. The statistics are stored in a small
+	 * rollup file in the background whenever a session ends, which is all that needs to be loaded on the next start. Only if there is no rollup file yet,
+	 * the session history gets replayed once.
+	 * The rollup remembers the sequence number of the last record it contains. Records which were recorded after that (e.g. because the game crashed
+	 * in the middle of a session) are replayed from the session history when loading.
+	 * The pack completion times of each step also serve as the estimate for the remaining time of steps which last until the pack is completed.
+	 */
+	class RLTT_IMPORT_EXPORT TrainingStatistics : public history::ISessionRecordReceiver, public training::ICompletionTimeEstimator
+	{
+	public:
+		/** Constructor. Loads the statistics from the rollup file, or from the session history at the given path in case there is no rollup file yet. */
+		explicit TrainingStatistics(std::filesystem::path rollupPath, const std::filesystem::path& historyPath = {});
+
+		/** Updates the statistics. The rollup file gets written in the background when a session ends. */
+		void receiveSessionRecord(const history::SessionRecord& record) override;
+
+		/** Updates the statistics for a single recorded event. Records which are not newer than the last applied one are ignored. */
+		void apply(const history::SessionRecord& record);
+
+		/** Estimates the completion time from the median of the recorded pack completion times of the step. This does not copy any statistics. */
+		std::optional<std::chrono::milliseconds> estimateCompletionTime(const std::string& trainingProgramId, uint16_t stepNumber) const override;
+
+		/** Retrieves the statistics of the training program with the given ID, or nothing if it has never been started. */
+		std::optional<ProgramStatistics> getProgramStatistics(const std::string& trainingProgramId) const;
+
+		/** Retrieves a number which changes whenever the statistics change, so callers can tell whether anything they derived from them is outdated. */
+		uint64_t revision() const;
+
+		/**
+		 * Queues writing the rollup file, which happens on a background thread.
+		 * Errors are logged, but not thrown since losing statistics is not a reason for interrupting the training.
+		 */
+		void save();
+		/** Blocks until the rollup file has been written. */
+		void flush();
+
+		/** Converts a timestamp in milliseconds since 1970-01-01 (UTC) to the number of days since then. */
+		static int64_t toDay(int64_t timestamp);
+
+	private:
+		void load(const std::filesystem::path& historyPath);
+		/** Applies the recorded events which are newer than the rollup. */
+		void catchUpWithHistory(const std::filesystem::path& historyPath);
+		std::string serialize() const;
+
+		configuration::CrashSafeFileStorage _storage;
+		configuration::DebouncedFileWriter _writer; // Writes through a copy of the storage
+		std::atomic<uint64_t> _revision = 0;
+
+		mutable std::mutex _mutex; // Protects all members below
+		std::unordered_map<uint64_t, ProgramStatistics> _programStatistics; // Key: Hash of the training program ID
+		uint64_t _lastAppliedSequenceNumber = 0; // The watermark which gets stored in the rollup
+		bool _packWasCompletedInCurrentStep = false;
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ICVarManager.h"
+#include <diagnostics/TimelineRecorder.h>
+
+#include <bakkesmod/wrappers/cvarmanagerwrapper.h>
+
+#include <memory>
+
+/** Since we can't modify CvarManagerWrapper to inherit from ICVarManager, we provide an adapter to our interface instead. */
+class CVarManagerAdapter : public ICVarManager
+{
+public:
+	CVarManagerAdapter(std::shared_ptr<CVarManagerWrapper> actualCVarManager)
+		: ICVarManager()
+		, _actualCVarManager{ std::move(actualCVarManager) }
+	{
+	}
+
+	void executeCommand(std::string command, bool log) override
+	{
+		RLTT_TIMELINE_SCOPE("command", command);
+		_actualCVarManager->executeCommand(command, log);
+	}
+	std::string getCvarValue(const std::string& cvarName) override
+	{
+		auto cvar = _actualCVarManager->getCvar(cvarName);
+		return cvar ? cvar.getStringValue() : std::string();
+	}
+	void setCvarValue(const std::string& cvarName, const std::string& value) override
+	{
+		if (auto cvar = _actualCVarManager->getCvar(cvarName); cvar)
+		{
+			cvar.setValue(value);
+		}
+	}
+
+private:
+	std::shared_ptr<CVarManagerWrapper> _actualCVarManager;
+};
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <pch.h>
+#include "EventTrace.h"
+
+#include <external/nlohmann/json.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using json = nlohmann::json;
+
+namespace training
+{
+	std::string EventTrace::formatEntry(const TraceEntry& entry)
+	{
+		return fmt::format("{}\t{}\t{}\t{}\t{}\t{}",
+			entry.TimeSinceStart.count(),
+			(char)entry.Type,
+			entry.GameIsPaused ? 1 : 0,
+			entry.GameIsInFreeplay ? 1 : 0,
+			entry.Name,
+			entry.Argument);
+	}
+
+	std::string EventTrace::formatArgument(const std::vector<std::string>& values)
+	{
+		return json(values).dump(); // Escapes tabs and line breaks, so the entry stays a single line
+	}
+
+	std::vector<std::string> EventTrace::parseArgument(const std::string& argument)
+	{
+		try
+		{
+			return json::parse(argument).get<std::vector<std::string>>();
+		}
+		catch (const json::exception& ex)
+		{
+			throw std::runtime_error(fmt::format("Invalid argument in event trace: {}", ex.what()));
+		}
+	}
+
+	std::vector<TraceEntry> EventTrace::read(const std::filesystem::path& path)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			throw std::runtime_error(fmt::format("Could not open event trace {}", path.string()));
+		}
+
+		std::string line;
+		if (!std::getline(file, line) || line != FileHeader)
+		{
+			throw std::runtime_error(fmt::format("{} is not an event trace", path.string()));
+		}
+
+		std::vector<TraceEntry> entries;
+		while (std::getline(file, line))
+		{
+			if (line.empty()) { continue; }
+
+			std::vector<std::string> fields;
+			std::istringstream lineStream(line);
+			for (std::string field; std::getline(lineStream, field, '\t');)
+			{
+				fields.push_back(std::move(field));
+			}
+			if (fields.size() < 5)
+			{
+				throw std::runtime_error(fmt::format("Invalid line in event trace {}: {}", path.string(), line));
+			}
+
+			auto entry = TraceEntry();
+			entry.TimeSinceStart = std::chrono::microseconds(std::stoll(fields[0]));
+			entry.Type = (TraceEntryType)fields[1].at(0);
+			entry.GameIsPaused = fields[2] == "1";
+			entry.GameIsInFreeplay = fields[3] == "1";
+			entry.Name = std::move(fields[4]);
+			entry.Argument = fields.size() > 5 ? std::move(fields[5]) : std::string();
+			entries.push_back(std::move(entry));
+		}
+		return entries;
+	}
+}
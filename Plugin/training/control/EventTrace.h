@@ -0,0 +1,84 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace training
+{
+	/** Defines the kinds of things which can be found in an event trace. */
+	enum class TraceEntryType : char
+	{
+		HookEvent = 'H', // A game event hooked through IGameWrapper::HookEvent
+		HookEventPost = 'P', // A game event hooked through IGameWrapper::HookEventPost
+		Command = 'C', // A call to one of the public methods of TrainingProgramFlowControl, e.g. by the UI
+		Input = 'I', // Something the flow control asked for while handling the entry before, e.g. a cvar value. Gets provided before replaying that entry.
+		Result = 'R', // Something the flow control did while handling the entry before, e.g. executing commands. Allows checking a replay.
+	};
+
+	/** POD struct for a single thing which happened while an event trace was being recorded. */
+	struct TraceEntry
+	{
+	public:
+		std::chrono::microseconds TimeSinceStart = std::chrono::microseconds(0);
+		TraceEntryType Type = TraceEntryType::Command;
+		bool GameIsPaused = false; // The result of IGameWrapper::IsPaused() at the time of the entry
+		bool GameIsInFreeplay = false; // The result of IGameWrapper::IsInFreeplay() at the time of the entry
+		std::string Name; // The event name, or the name of the command
+		std::string Argument; // E.g. the training program ID for selecting a program, or the serialized list for receiving list data. Empty for most entries.
+	};
+
+	/** The names of the commands which get recorded. */
+	namespace TraceCommand
+	{
+		constexpr auto ReceiveListData = "receiveListData";
+		constexpr auto Select = "select";
+		constexpr auto Unselect = "unselect";
+		constexpr auto Start = "start";
+		constexpr auto Stop = "stop";
+		constexpr auto Pause = "pause";
+		constexpr auto Resume = "resume";
+		constexpr auto ActivateNext = "activateNext";
+		constexpr auto Skip = "skip";
+		constexpr auto SetPreloadSettings = "setPreloadSettings";
+		constexpr auto SetPreStepCommands = "setPreStepCommands";
+	}
+
+	/** The names of the inputs which get recorded. */
+	namespace TraceInput
+	{
+		constexpr auto CvarValue = "cvarValue"; // Name and value
+		constexpr auto CompletionTime = "completionTime"; // Training program ID, step number and milliseconds (empty if there is no estimate)
+	}
+
+	/** The names of the results which get recorded. */
+	namespace TraceResult
+	{
+		constexpr auto CommandBatch = "commandBatch"; // The commands of the batch
+	}
+
+	/**
+	 * Reads and writes event trace files. Every entry is a single tab separated line, so traces can be compared and edited by hand:
+	 * <microseconds since start> <type> <paused> <in freeplay> <name> <argument>
+	 */
+	class RLTT_IMPORT_EXPORT EventTrace
+	{
+	public:
+		/** The first line of every trace file. The number is the version of the file format. Version 1 traces did not contain inputs and results. */
+		static constexpr auto FileHeader = "RLTT_TRACE 2";
+
+		/** Converts a single entry to a line of a trace file, without the line break. */
+		static std::string formatEntry(const TraceEntry& entry);
+
+		/** Converts several values to a single argument. The values may contain tabs and line breaks. */
+		static std::string formatArgument(const std::vector<std::string>& values);
+		/** Retrieves the values of an argument which was created by formatArgument(). Throws std::runtime_error if the argument is invalid. */
+		static std::vector<std::string> parseArgument(const std::string& argument);
+
+		/** Reads all entries of the trace file at the given path. Throws std::runtime_error if the file can't be read or is not a trace file. */
+		static std::vector<TraceEntry> read(const std::filesystem::path& path);
+	};
+}
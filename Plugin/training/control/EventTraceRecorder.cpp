@@ -0,0 +1,113 @@
+#include <pch.h>
+#include "EventTraceRecorder.h"
+
+namespace
+{
+	thread_local int TraceScopeDepth = 0;
+}
+
+namespace training
+{
+	TraceScope::TraceScope(EventTraceRecorder* recorder, TraceEntryType type, const std::string& name, const std::string& argument)
+	{
+		if (TraceScopeDepth++ == 0 && recorder != nullptr)
+		{
+			recorder->record(type, name, argument);
+		}
+	}
+
+	TraceScope::~TraceScope()
+	{
+		TraceScopeDepth--;
+	}
+
+	EventTraceRecorder::EventTraceRecorder(std::shared_ptr<IGameWrapper> gameWrapper, std::shared_ptr<ITimeProvider> timeProvider)
+		: IGameWrapper()
+		, _gameWrapper{ std::move(gameWrapper) }
+		, _timeProvider{ std::move(timeProvider) }
+	{
+	}
+
+	EventTraceRecorder::~EventTraceRecorder()
+	{
+		stop();
+	}
+
+	void EventTraceRecorder::start(const std::filesystem::path& tracePath)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_traceFile.close();
+		if (tracePath.has_parent_path())
+		{
+			std::filesystem::create_directories(tracePath.parent_path());
+		}
+		_traceFile.open(tracePath, std::ios::trunc);
+		if (!_traceFile)
+		{
+			throw std::runtime_error(fmt::format("Could not create event trace {}", tracePath.string()));
+		}
+		_traceFile << EventTrace::FileHeader << '\n';
+		_startTime = _timeProvider->now();
+		_isRecording = true;
+	}
+
+	void EventTraceRecorder::stop()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isRecording = false;
+		_traceFile.close(); // Flushes the stream
+	}
+
+	bool EventTraceRecorder::isRecording() const
+	{
+		return _isRecording;
+	}
+
+	void EventTraceRecorder::record(TraceEntryType type, const std::string& name, const std::string& argument)
+	{
+		if (!_isRecording) { return; }
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_traceFile.is_open()) { return; }
+
+		auto entry = TraceEntry();
+		entry.TimeSinceStart = std::chrono::duration_cast<std::chrono::microseconds>(_timeProvider->now() - _startTime);
+		entry.Type = type;
+		entry.GameIsPaused = _gameWrapper->IsPaused();
+		entry.GameIsInFreeplay = _gameWrapper->IsInFreeplay();
+		entry.Name = name;
+		entry.Argument = argument;
+		_traceFile << EventTrace::formatEntry(entry) << '\n'; // The stream buffers this, so ticks don't cause a write each
+	}
+
+	void EventTraceRecorder::HookEventPost(std::string eventName, std::function<void(std::string eventName)> callback)
+	{
+		_gameWrapper->HookEventPost(eventName, [this, hookedEventName = eventName, callback = std::move(callback)](std::string eventName) {
+			TraceScope traceScope(this, TraceEntryType::HookEventPost, hookedEventName); // The name which gets replayed, regardless of what the caller passes
+			callback(std::move(eventName));
+		});
+	}
+
+	void EventTraceRecorder::HookEvent(std::string eventName, std::function<void(std::string eventName)> callback)
+	{
+		_gameWrapper->HookEvent(eventName, [this, hookedEventName = eventName, callback = std::move(callback)](std::string eventName) {
+			TraceScope traceScope(this, TraceEntryType::HookEvent, hookedEventName); // The name which gets replayed, regardless of what the caller passes
+			callback(std::move(eventName));
+		});
+	}
+
+	void EventTraceRecorder::Execute(std::function<void(GameWrapper*)> theLambda)
+	{
+		_gameWrapper->Execute(std::move(theLambda));
+	}
+
+	bool EventTraceRecorder::IsPaused()
+	{
+		return _gameWrapper->IsPaused();
+	}
+
+	bool EventTraceRecorder::IsInFreeplay()
+	{
+		return _gameWrapper->IsInFreeplay();
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "EventTrace.h"
+#include "IGameWrapper.h"
+#include "ITimeProvider.h"
+
+#include <DLLImportExport.h>
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace training
+{
+	class EventTraceRecorder;
+
+	/**
+	 * Marks an event or a command which is being handled. Only the outermost scope on a thread gets recorded, so e.g. a timer tick which
+	 * finishes the program does not additionally record the commands it calls internally. Those would be executed twice during a replay otherwise.
+	 */
+	class RLTT_IMPORT_EXPORT TraceScope
+	{
+	public:
+		/** Constructor. Records the entry if this is the outermost scope and a recorder is available. */
+		TraceScope(EventTraceRecorder* recorder, TraceEntryType type, const std::string& name, const std::string& argument = {});
+		/** Destructor. */
+		~TraceScope();
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+	};
+
+	/**
+	 * The job of this class is to record everything which drives TrainingProgramFlowControl into an event trace file, so a session can be replayed exactly.
+	 *
+	 * It wraps the game wrapper in order to see every hooked event, and gets told about commands by the flow control.
+	 * Nothing gets recorded (and nothing gets slower) until start() gets called.
+	 */
+	class RLTT_IMPORT_EXPORT EventTraceRecorder : public IGameWrapper
+	{
+	public:
+		/** Constructor. */
+		EventTraceRecorder(std::shared_ptr<IGameWrapper> gameWrapper, std::shared_ptr<ITimeProvider> timeProvider);
+		/** Destructor. Writes any entries which have not been written yet. */
+		~EventTraceRecorder();
+
+		/** Starts recording into the file at the given path. Any previous recording gets stopped. Throws std::runtime_error if the file can't be created. */
+		void start(const std::filesystem::path& tracePath);
+		/** Stops recording and writes the remaining entries. */
+		void stop();
+		/** Checks whether a recording is in progress. */
+		bool isRecording() const;
+
+		/** Adds an entry to the trace, unless no recording is in progress. Use TraceScope rather than calling this directly. */
+		void record(TraceEntryType type, const std::string& name, const std::string& argument);
+
+		// Inherited via IGameWrapper. Hooked callbacks get recorded before they are called.
+		void HookEventPost(std::string eventName, std::function<void(std::string eventName)> callback) override;
+		void HookEvent(std::string eventName, std::function<void(std::string eventName)> callback) override;
+		void Execute(std::function<void(GameWrapper*)> theLambda) override;
+		bool IsPaused() override;
+		bool IsInFreeplay() override;
+
+	private:
+		std::shared_ptr<IGameWrapper> _gameWrapper;
+		std::shared_ptr<ITimeProvider> _timeProvider;
+		std::atomic<bool> _isRecording = false; // Allows skipping the lock for every event while nothing is being recorded
+
+		std::mutex _mutex; // Protects all members below
+		std::ofstream _traceFile;
+		std::chrono::steady_clock::time_point _startTime;
+	};
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "IGameWrapper.h"
+#include <diagnostics/TimelineRecorder.h>
+
+#include <bakkesmod/wrappers/gamewrapper.h>
+
+#include <memory>
+
+/** Since we can't modify game wrapper to inherit from IGameWrapper, we provide an adapter to our interface instead. */
+class GameWrapperAdapter : public IGameWrapper
+{
+public:
+	GameWrapperAdapter(std::shared_ptr<GameWrapper> actualGameWrapper) 
+		: IGameWrapper()
+		, _actualGameWrapper{ std::move(actualGameWrapper) }
+	{
+	}
+
+	void HookEventPost(std::string eventName, std::function<void(std::string eventName)> callback) override
+	{
+		_actualGameWrapper->HookEventPost(eventName, [hookedEventName = eventName, callback = std::move(callback)](std::string eventName) {
+			RLTT_TIMELINE_SCOPE("hook", hookedEventName);
+			callback(std::move(eventName));
+		});
+	}
+	void HookEvent(std::string eventName, std::function<void(std::string eventName)> callback) override
+	{
+		_actualGameWrapper->HookEvent(eventName, [hookedEventName = eventName, callback = std::move(callback)](std::string eventName) {
+			RLTT_TIMELINE_SCOPE("hook", hookedEventName);
+			callback(std::move(eventName));
+		});
+	}
+	void Execute(std::function<void(GameWrapper*)> theLambda) override
+	{
+		_actualGameWrapper->Execute(std::move(theLambda));
+	}
+	bool IsPaused() override
+	{
+		return _actualGameWrapper->IsPaused();
+	}
+	bool IsInFreeplay() override
+	{
+		return _actualGameWrapper->IsInFreeplay();
+	}
+
+private:
+	std::shared_ptr<GameWrapper> _actualGameWrapper;
+};
\ No newline at end of file
@@ -1,7 +1,29 @@
 #pragma once
 
 #include <string>
-#include <bakkesmod/wrappers/cvarmanagerwrapper.h>
+#include <vector>
+
+/** Collects console commands so they can all be executed within a single hop to the game thread. */
+class CommandBatch
+{
+public:
+	CommandBatch& add(std::string command)
+	{
+		_commands.push_back(std::move(command));
+		return *this;
+	}
+	CommandBatch& add(const std::vector<std::string>& commands)
+	{
+		_commands.insert(_commands.end(), commands.begin(), commands.end());
+		return *this;
+	}
+
+	inline bool empty() const { return _commands.empty(); }
+	inline const std::vector<std::string>& commands() const { return _commands; }
+
+private:
+	std::vector<std::string> _commands;
+};
 
 /** This interface allows testing classes which rely on the cvar manager, without having to start Rocket League. */
 class ICVarManager
@@ -12,23 +34,17 @@ protected:
 public:
 
 	virtual void executeCommand(std::string command, bool log = true) = 0;
-};
-
-/** Since we can't modify CvarManagerWrapper to inherit from the interface above, we provide an adapter to our interface instead. */
-class CVarManagerAdapter : public ICVarManager
-{
-public:
-	CVarManagerAdapter(std::shared_ptr<CVarManagerWrapper> actualCVarManager)
-		: ICVarManager()
-		, _actualCVarManager{ std::move(actualCVarManager) }
-	{
-	}
+	virtual std::string getCvarValue(const std::string& cvarName) = 0;
+	virtual void setCvarValue(const std::string& cvarName, const std::string& value) = 0;
 
-	void executeCommand(std::string command, bool log) override
+	/** Starts collecting commands which shall be executed together. */
+	virtual CommandBatch createBatch() const { return CommandBatch(); }
+	/** Executes all commands of the batch in the order they were added. Must be called on the game thread. */
+	virtual void executeBatch(const CommandBatch& batch)
 	{
-		_actualCVarManager->executeCommand(command, log);
+		for (const auto& command : batch.commands())
+		{
+			executeCommand(command);
+		}
 	}
-
-private:
-	std::shared_ptr<CVarManagerWrapper> _actualCVarManager;
-};
\ No newline at end of file
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace training
+{
+	/** Interface for classes which know how long the player usually needs for completing the training pack of a step. */
+	class RLTT_IMPORT_EXPORT ICompletionTimeEstimator
+	{
+	protected:
+		ICompletionTimeEstimator() = default;
+
+	public:
+		virtual ~ICompletionTimeEstimator() = default;
+
+		/** Estimates how long completing the training pack of the given step will take, or returns nothing if it has never been completed. */
+		virtual std::optional<std::chrono::milliseconds> estimateCompletionTime(const std::string& trainingProgramId, uint16_t stepNumber) const = 0;
+	};
+}
@@ -2,7 +2,8 @@
 
 #include <string>
 #include <functional>
-#include <bakkesmod/wrappers/gamewrapper.h>
+
+class GameWrapper; // Only used as a parameter type, so the interface does not depend on the BakkesMod SDK
 
 /** This interface allows testing classes which rely on the game wrapper, without having to start Rocket League.
  *
@@ -22,38 +23,3 @@ public:
 	virtual bool IsPaused() = 0;
 	virtual bool IsInFreeplay() = 0;
 };
-
-/** Since we can't modify game wrapper to inherit from the interface above, we provide an adapter to our interface instead. */
-class GameWrapperAdapter : public IGameWrapper
-{
-public:
-	GameWrapperAdapter(std::shared_ptr<GameWrapper> actualGameWrapper) 
-		: IGameWrapper()
-		, _actualGameWrapper{ std::move(actualGameWrapper) }
-	{
-	}
-
-	void HookEventPost(std::string eventName, std::function<void(std::string eventName)> callback) override
-	{
-		_actualGameWrapper->HookEventPost(eventName, std::move(callback));
-	}
-	void HookEvent(std::string eventName, std::function<void(std::string eventName)> callback) override
-	{
-		_actualGameWrapper->HookEvent(eventName, std::move(callback));
-	}
-	void Execute(std::function<void(GameWrapper*)> theLambda) override
-	{
-		_actualGameWrapper->Execute(std::move(theLambda));
-	}
-	bool IsPaused() override
-	{
-		return _actualGameWrapper->IsPaused();
-	}
-	bool IsInFreeplay() override
-	{
-		return _actualGameWrapper->IsInFreeplay();
-	}
-
-private:
-	std::shared_ptr<GameWrapper> _actualGameWrapper;
-};
\ No newline at end of file
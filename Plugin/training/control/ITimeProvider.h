@@ -13,6 +13,8 @@ public:
 
 	/** Retrieves the current point in time. */
 	virtual std::chrono::steady_clock::time_point now() const = 0;
+	/** Retrieves the current date and time. Unlike now(), this is only meant for storing when something happened. */
+	virtual std::chrono::system_clock::time_point currentDateTime() const = 0;
 };
 
 /** The default time provider to be used when not unit testing. */
@@ -23,4 +25,9 @@ public:
 	{
 		return std::chrono::steady_clock::now();
 	}
+
+	std::chrono::system_clock::time_point currentDateTime() const override
+	{
+		return std::chrono::system_clock::now();
+	}
 };
\ No newline at end of file
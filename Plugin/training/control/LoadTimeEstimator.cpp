@@ -0,0 +1,43 @@
+#include <pch.h>
+#include "LoadTimeEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace training
+{
+	// The weight of a new measurement. Load times vary a lot (e.g. depending on the disk cache), so older measurements still count.
+	constexpr auto NewMeasurementWeight = 0.3;
+
+	// The smallest safety margin which is added to the average load time, so a load which takes slightly longer than usual does not eat into the next step.
+	constexpr auto MinimumSafetyMargin = std::chrono::milliseconds(1000);
+	// How many standard deviations of the load time are added as a safety margin.
+	constexpr auto SafetyMarginStandardDeviations = 2.0;
+
+	void LoadTimeEstimator::recordLoadTime(const std::string& loadCommand, const std::chrono::milliseconds& loadTime)
+	{
+		auto [iter, isFirstMeasurement] = _loadTimeStatistics.try_emplace(loadCommand, LoadTimeStatistics{ (double)loadTime.count(), .0 });
+		if (!isFirstMeasurement)
+		{
+			// Incremental exponentially weighted mean and variance
+			auto& statistics = iter->second;
+			auto difference = (double)loadTime.count() - statistics.AverageInMilliseconds;
+			auto increment = NewMeasurementWeight * difference;
+			statistics.AverageInMilliseconds += increment;
+			statistics.VarianceInMillisecondsSquared = (1.0 - NewMeasurementWeight) * (statistics.VarianceInMillisecondsSquared + difference * increment);
+		}
+	}
+
+	std::chrono::milliseconds LoadTimeEstimator::estimateLeadTime(const std::string& loadCommand, const std::chrono::milliseconds& configuredLeadTime) const
+	{
+		auto iter = _loadTimeStatistics.find(loadCommand);
+		if (iter == _loadTimeStatistics.end())
+		{
+			return configuredLeadTime;
+		}
+		const auto& statistics = iter->second;
+		auto varianceMargin = std::chrono::milliseconds((long long)(SafetyMarginStandardDeviations * std::sqrt(statistics.VarianceInMillisecondsSquared)));
+		auto safetyMargin = std::clamp(varianceMargin, MinimumSafetyMargin, std::max(MinimumSafetyMargin, configuredLeadTime));
+		return std::chrono::milliseconds((long long)statistics.AverageInMilliseconds) + safetyMargin;
+	}
+}
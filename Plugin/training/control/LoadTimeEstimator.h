@@ -0,0 +1,33 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+namespace training
+{
+	/** The job of this class is to learn how long loading a certain map takes, so loads can be started early enough. */
+	class RLTT_IMPORT_EXPORT LoadTimeEstimator
+	{
+	public:
+		/** Remembers how long the given load command took until the map was loaded. */
+		void recordLoadTime(const std::string& loadCommand, const std::chrono::milliseconds& loadTime);
+
+		/**
+		 * Determines how long before the end of a step the given load command has to be sent. This is the average load time plus a safety margin
+		 * which grows with the spread of the measurements, but never exceeds the configured lead time. Returns the configured lead time if the
+		 * command has not been measured yet.
+		 */
+		std::chrono::milliseconds estimateLeadTime(const std::string& loadCommand, const std::chrono::milliseconds& configuredLeadTime) const;
+
+	private:
+		struct LoadTimeStatistics
+		{
+			double AverageInMilliseconds = .0; // Exponentially weighted, so outliers don't have too much influence
+			double VarianceInMillisecondsSquared = .0; // Exponentially weighted as well
+		};
+		std::unordered_map<std::string, LoadTimeStatistics> _loadTimeStatistics;
+	};
+}
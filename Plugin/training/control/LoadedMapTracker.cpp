@@ -0,0 +1,60 @@
+#include <pch.h>
+#include "LoadedMapTracker.h"
+
+namespace training
+{
+	bool LoadedMapTracker::loadIsNecessary(const std::string& loadCommand, std::chrono::steady_clock::time_point now)
+	{
+		forgetPendingTargetIfExpired(now);
+		auto targetIsLoadedOrLoading = _pendingTarget.has_value() ? _pendingTarget == loadCommand : _currentTarget == loadCommand;
+		if (targetIsLoadedOrLoading)
+		{
+			_counters.SuppressedCommands++;
+			return false;
+		}
+		_counters.IssuedCommands++;
+		return true;
+	}
+
+	void LoadedMapTracker::handleLoadCommandIssued(const std::string& loadCommand, std::chrono::steady_clock::time_point now)
+	{
+		_pendingTarget = loadCommand;
+		_pendingTargetIssueTime = now;
+		_pendingLoadHasStarted = false;
+	}
+
+	void LoadedMapTracker::handleMapLoadStart(std::chrono::steady_clock::time_point now)
+	{
+		forgetPendingTargetIfExpired(now);
+		if (!_pendingTarget.has_value())
+		{
+			_currentTarget.reset(); // The player loaded something on their own
+			return;
+		}
+		_pendingLoadHasStarted = true;
+	}
+
+	void LoadedMapTracker::handleMapLoadEnd()
+	{
+		_currentTarget = _pendingTarget;
+		_pendingTarget.reset();
+	}
+
+	void LoadedMapTracker::forgetPendingTargetIfExpired(std::chrono::steady_clock::time_point now)
+	{
+		if (_pendingTarget.has_value() && !_pendingLoadHasStarted && now - _pendingTargetIssueTime > LoadStartTimeout)
+		{
+			// The command was probably rejected. We don't know what it did, so we don't know what is loaded either
+			_pendingTarget.reset();
+			_currentTarget.reset();
+		}
+	}
+
+	void LoadedMapTracker::handleTrainingEnd()
+	{
+		if (_currentTarget.has_value() && _currentTarget->rfind("load_training", 0) == 0)
+		{
+			_currentTarget.reset();
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace training
+{
+	/** Counts how many load commands were actually issued, and how many were not necessary. */
+	struct LoadCommandCounters
+	{
+		uint32_t IssuedCommands = 0;
+		uint32_t SuppressedCommands = 0;
+	};
+
+	/**
+	 * The job of this class is to know which map, training pack or workshop map is currently loaded, so it does not get loaded again.
+	 *
+	 * The loaded target is identified by the load command which loaded it. It is only known after a load which was issued by us has finished.
+	 * Anything else (loads started by the player, a finished training pack etc) makes the state unknown again, in which case commands must not be suppressed.
+	 * If the game does not start loading shortly after a load command was issued (e.g. because the map does not exist), the command is forgotten,
+	 * so it can't be mistaken for the cause of a later, unrelated load.
+	 */
+	class RLTT_IMPORT_EXPORT LoadedMapTracker
+	{
+	public:
+		/** The time the game gets for starting to load a map after a load command was issued. */
+		static constexpr auto LoadStartTimeout = std::chrono::seconds(5);
+
+		/** Checks whether the target of the given load command is already loaded, and counts the command as either issued or suppressed. */
+		bool loadIsNecessary(const std::string& loadCommand, std::chrono::steady_clock::time_point now);
+		/** Remembers that the given load command was issued, but the map has not been loaded yet. */
+		void handleLoadCommandIssued(const std::string& loadCommand, std::chrono::steady_clock::time_point now);
+
+		/** Forgets the current state if somebody else started loading a map. */
+		void handleMapLoadStart(std::chrono::steady_clock::time_point now);
+		/** Updates the current state once a map has been loaded. */
+		void handleMapLoadEnd();
+		/** Forgets a loaded training pack, since it has to be loaded again in order to restart it. */
+		void handleTrainingEnd();
+
+		/** Retrieves the load command which loaded the current map, or nothing if that is not known. */
+		inline std::optional<std::string> currentTarget() const { return _currentTarget; }
+		/** Retrieves the number of issued and suppressed load commands. */
+		inline LoadCommandCounters counters() const { return _counters; }
+
+	private:
+		/** Forgets the pending load command if the game did not start loading its map in time. */
+		void forgetPendingTargetIfExpired(std::chrono::steady_clock::time_point now);
+
+		std::optional<std::string> _currentTarget = {};
+		std::optional<std::string> _pendingTarget = {};
+		std::chrono::steady_clock::time_point _pendingTargetIssueTime;
+		bool _pendingLoadHasStarted = false; // Loading itself may take as long as it wants
+		LoadCommandCounters _counters;
+	};
+}
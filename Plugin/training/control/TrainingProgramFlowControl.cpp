@@ -1,7 +1,8 @@
 #include <pch.h>
 #include "TrainingProgramFlowControl.h"
-
-#include <unordered_set>
+#include <configuration/control/TrainingProgramHasher.h>
+#include <configuration/control/TrainingProgramRepository.h>
+#include <diagnostics/PerformanceCounters.h>
 
 namespace training
 {
@@ -34,17 +35,28 @@ namespace training
 		});
 
 		_gameWrapper->HookEventPost("Function TAGame.GameEvent_TrainingEditor_TA.EndTraining", [this](const std::string&) {
+			_loadedMapTracker.handleTrainingEnd();
 			if (trainingProgramIsActive() && _currentEntry.TimeMode == configuration::TrainingProgramCompletionMode::CompletePack)
 			{
+				recordSessionEvent(SessionEventType::PackCompleted); // The completion time is part of the statistics, which provide the estimates
 				activateNextTrainingProgramStep();
 			}
 		});
 
+		_gameWrapper->HookEvent("Function TAGame.LoadingScreen_TA.HandlePreLoadMap", [this](const std::string&) {
+			handleMapLoadStart();
+		});
+
+		_gameWrapper->HookEventPost("Function TAGame.LoadingScreen_TA.HandlePostLoadMap", [this](const std::string&) {
+			handleMapLoadEnd();
+		});
+
 		_currentFlowData.SwitchingIsPossible = true; // We currently always allow switching
 	}
 
 	void TrainingProgramFlowControl::selectTrainingProgram(const std::string& trainingProgramId)
 	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Select, trainingProgramId);
 		if (_trainingProgramList.TrainingProgramData.count(trainingProgramId) > 0)
 		{
 			// Adapt internal state                    
@@ -61,6 +73,12 @@ namespace training
 			_currentFlowData.ResumingIsPossible = false;
 			_currentFlowData.StoppingIsPossible = false;
 			_currentFlowData.SkippingIsPossible = false;
+			_currentFlowData.MissingWorkshopMaps = findMissingWorkshopMaps(_trainingProgramList.TrainingProgramData.at(trainingProgramId));
+			_currentFlowData.SelectedTrainingProgramStepNames.clear();
+			for (const auto& entry : _trainingProgramList.TrainingProgramData.at(trainingProgramId).Entries)
+			{
+				_currentFlowData.SelectedTrainingProgramStepNames.push_back(entry.Name);
+			}
 
 			// Don't provide information for the training UI just yet (but do so once the program gets started
 			_currentExecutionData.NumberOfSteps = 0;
@@ -74,6 +92,7 @@ namespace training
 
 	void TrainingProgramFlowControl::unselectTrainingProgram()
 	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Unselect);
 		_selectedTrainingProgramId.reset();
 		_currentTrainingStepNumber.reset();
 
@@ -85,12 +104,23 @@ namespace training
 		_currentFlowData.ResumingIsPossible = false;
 		_currentFlowData.StoppingIsPossible = false;
 		_currentFlowData.SkippingIsPossible = false;
+		_currentFlowData.MissingWorkshopMaps.clear();
+		_currentFlowData.SelectedTrainingProgramStepNames.clear();
 
 		_currentExecutionData.NumberOfSteps = 0; // Invalidates everything else
+		_currentExecutionData.NextStepPrompt.clear();
+		_preloadedStepNumber.reset();
+		_mapLoadingState = PausedState::NotPaused;
+		_mapLoadStartTime.reset();
+		_playerPauseStartTime.reset();
+
+		// Give the player their own variance settings back
+		executeBatch(_cvarManager->createBatch().add(_varianceApplier.createRestoreCommands()));
 	}
 
 	void TrainingProgramFlowControl::startSelectedTrainingProgram()
 	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Start);
 		if (_selectedTrainingProgramId.has_value() && !trainingProgramIsActive())
 		{
 			// Provide information for the flow control UI
@@ -108,6 +138,11 @@ namespace training
 			_referenceTime = _timeProvider->now();
 
 			_currentExecutionData.ProgramHasUntimedSteps = false;
+			_stepVariances.clear();
+			for (const auto& entry : _trainingProgramList.TrainingProgramData.at(_selectedTrainingProgramId.value()).Entries)
+			{
+				_stepVariances.push_back(VarianceApplier::parse(entry.Variance));
+			}
 			for (auto entry : _trainingProgramList.TrainingProgramData.at(_selectedTrainingProgramId.value()).Entries)
 			{
 				if (entry.TimeMode == configuration::TrainingProgramCompletionMode::CompletePack)
@@ -116,12 +151,14 @@ namespace training
 					break;
 				}
 			}
+			recordSessionEvent(SessionEventType::ProgramStarted);
 			activateNextTrainingProgramStep();
 		}
 	}
 
 	void TrainingProgramFlowControl::activateNextTrainingProgramStep()
 	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::ActivateNext);
 		if (_selectedTrainingProgramId.has_value()
 			&& trainingProgramIsActive()
 			&& _trainingProgramList.TrainingProgramData.count(_selectedTrainingProgramId.value()) > 0)
@@ -138,6 +175,8 @@ namespace training
 				}
 				else
 				{
+					recordSessionEvent(SessionEventType::StepEnded, timeSpentInCurrentStep());
+
 					// Reduce remaining program time when skipping in the middle of the step
 					if (_currentExecutionData.TimeLeftInCurrentTrainingStep.count() > 0)
 					{
@@ -147,7 +186,21 @@ namespace training
 				}
 				const auto& trainingProgramEntry = trainingProgramData.Entries.at(_currentTrainingStepNumber.value());
 
-				switchGameModeIfNecessary(trainingProgramEntry);
+				// Change everything the step needs in a single go
+				auto batch = _cvarManager->createBatch();
+				batch.add(_preStepCommands);
+				batch.add(_varianceApplier.createCommands(_stepVariances.at(_currentTrainingStepNumber.value()), [this](const std::string& cvarName) {
+					return getCvarValue(cvarName);
+				}));
+				if (_preloadedStepNumber != _currentTrainingStepNumber) // The map might have been loaded before the previous step ended
+				{
+					switchGameModeIfNecessary(trainingProgramEntry, _currentTrainingStepNumber.value(), batch);
+				}
+				executeBatch(std::move(batch));
+				_preloadedStepNumber.reset();
+				_nextStepLeadTime.reset();
+				_currentExecutionData.NextStepPrompt.clear();
+
 				// No change in flow state (still running)
 
 				// Provide information for the training execution UI
@@ -164,7 +217,21 @@ namespace training
 
 				// this allows not having to query the current entry on every single timer tick.
 				_currentEntry = trainingProgramEntry;
+				estimateRemainingDurations(trainingProgramData);
 				_currentFlowData.SkippingIsPossible = _currentTrainingStepNumber < trainingProgramData.Entries.size() - 1;
+
+				// A pause which is still going on applies to the new step from now on
+				if (_pauseStartTime.has_value())
+				{
+					_pauseStartTime = _referenceTime;
+				}
+				recordSessionEvent(SessionEventType::StepStarted);
+
+				// If the map of this step is still being loaded (e.g. because it was preloaded too late), the rest of the loading screen must not count either
+				if (_mapLoadIsInProgress)
+				{
+					updateMapLoadingState(PausedState::Paused);
+				}
 			}
 			else if(trainingProgramData.Entries.empty())
 			{
@@ -175,34 +242,341 @@ namespace training
 		}
 	}
 
-	void TrainingProgramFlowControl::switchGameModeIfNecessary(const configuration::TrainingProgramEntry& trainingProgramEntry)
+	void TrainingProgramFlowControl::skipTrainingProgramStep()
+	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Skip);
+		if (trainingProgramIsActive() && _currentFlowData.SkippingIsPossible)
+		{
+			recordSessionEvent(SessionEventType::StepSkipped);
+		}
+		activateNextTrainingProgramStep();
+	}
+
+	void TrainingProgramFlowControl::switchGameModeIfNecessary(const configuration::TrainingProgramEntry& trainingProgramEntry, uint16_t stepNumber, CommandBatch& batch)
+	{
+		auto loadCommand = createLoadCommand(trainingProgramEntry);
+		if (!loadCommand.has_value() || !_loadedMapTracker.loadIsNecessary(loadCommand.value(), _timeProvider->now()))
+		{
+			return;
+		}
+		_loadedMapTracker.handleLoadCommandIssued(loadCommand.value(), _timeProvider->now());
+		_pendingMapLoad = PendingMapLoad{ loadCommand.value(), _timeProvider->now(), stepNumber };
+		batch.add(std::move(loadCommand.value()));
+	}
+
+	void TrainingProgramFlowControl::executeBatch(CommandBatch batch)
+	{
+		if (batch.empty())
+		{
+			return;
+		}
+		if (eventTraceIsRecording())
+		{
+			_eventTraceRecorder->record(TraceEntryType::Result, TraceResult::CommandBatch, EventTrace::formatArgument(batch.commands()));
+		}
+		// Only capture what is needed, so nothing refers to the flow control or its entries once the game thread gets to this
+		_gameWrapper->Execute([cvarManager = _cvarManager, batch = std::move(batch)](GameWrapper*) {
+			cvarManager->executeBatch(batch);
+		});
+	}
+
+	void TrainingProgramFlowControl::setEventTraceRecorder(std::shared_ptr<EventTraceRecorder> eventTraceRecorder)
+	{
+		_eventTraceRecorder = std::move(eventTraceRecorder);
+	}
+
+	void TrainingProgramFlowControl::recordTraceHeader()
+	{
+		if (!eventTraceIsRecording())
+		{
+			return;
+		}
+		_eventTraceRecorder->record(TraceEntryType::Command, TraceCommand::SetPreloadSettings, EventTrace::formatArgument({
+			_preloadIsEnabled ? "1" : "0",
+			std::to_string(_defaultPreloadLeadTime.count())
+		}));
+		_eventTraceRecorder->record(TraceEntryType::Command, TraceCommand::SetPreStepCommands, EventTrace::formatArgument(_preStepCommands));
+		if (_selectedTrainingProgramId.has_value())
+		{
+			_eventTraceRecorder->record(TraceEntryType::Command, TraceCommand::Select, _selectedTrainingProgramId.value());
+		}
+	}
+
+	bool TrainingProgramFlowControl::eventTraceIsRecording() const
+	{
+		return _eventTraceRecorder != nullptr && _eventTraceRecorder->isRecording();
+	}
+
+	std::string TrainingProgramFlowControl::getCvarValue(const std::string& cvarName) const
+	{
+		auto cvarValue = _cvarManager->getCvarValue(cvarName);
+		if (eventTraceIsRecording())
+		{
+			_eventTraceRecorder->record(TraceEntryType::Input, TraceInput::CvarValue, EventTrace::formatArgument({ cvarName, cvarValue }));
+		}
+		return cvarValue;
+	}
+
+	void TrainingProgramFlowControl::setCompletionTimeEstimator(std::shared_ptr<ICompletionTimeEstimator> completionTimeEstimator)
+	{
+		_completionTimeEstimator = std::move(completionTimeEstimator);
+	}
+
+	std::optional<std::chrono::milliseconds> TrainingProgramFlowControl::estimateStepDuration(const configuration::TrainingProgramEntry& trainingProgramEntry, uint16_t stepNumber) const
+	{
+		if (trainingProgramEntry.TimeMode == configuration::TrainingProgramCompletionMode::Timed)
+		{
+			return trainingProgramEntry.Duration;
+		}
+		if (_completionTimeEstimator == nullptr || trainingProgramEntry.TrainingPackCode.empty() || !_selectedTrainingProgramId.has_value())
+		{
+			return {};
+		}
+		auto completionTime = _completionTimeEstimator->estimateCompletionTime(_selectedTrainingProgramId.value(), stepNumber);
+		if (eventTraceIsRecording())
+		{
+			_eventTraceRecorder->record(TraceEntryType::Input, TraceInput::CompletionTime, EventTrace::formatArgument({
+				_selectedTrainingProgramId.value(),
+				std::to_string(stepNumber),
+				completionTime.has_value() ? std::to_string(completionTime.value().count()) : std::string()
+			}));
+		}
+		return completionTime;
+	}
+
+	void TrainingProgramFlowControl::estimateRemainingDurations(const configuration::TrainingProgramData& trainingProgramData)
+	{
+		_currentStepDurationEstimate.reset();
+		if (_currentEntry.TimeMode != configuration::TrainingProgramCompletionMode::Timed)
+		{
+			_currentStepDurationEstimate = estimateStepDuration(_currentEntry, _currentTrainingStepNumber.value());
+		}
+
+		_durationOfLaterSteps = std::chrono::milliseconds(0);
+		for (auto index = (size_t)_currentTrainingStepNumber.value() + 1; index < trainingProgramData.Entries.size() && _durationOfLaterSteps.has_value(); index++)
+		{
+			auto stepDuration = estimateStepDuration(trainingProgramData.Entries.at(index), (uint16_t)index);
+			_durationOfLaterSteps = stepDuration.has_value() ? std::optional(_durationOfLaterSteps.value() + stepDuration.value()) : std::nullopt;
+		}
+
+		_currentExecutionData.TimeLeftInCurrentTrainingStepIsEstimated = _currentStepDurationEstimate.has_value();
+		_currentExecutionData.TimeLeftInProgramIsEstimated = _currentExecutionData.ProgramHasUntimedSteps
+			&& (!_currentExecutionData.CurrentStepIsUntimed || _currentStepDurationEstimate.has_value())
+			&& _durationOfLaterSteps.has_value();
+		if (_currentStepDurationEstimate.has_value())
+		{
+			_currentExecutionData.TimeLeftInCurrentTrainingStep = _currentStepDurationEstimate.value();
+		}
+		if (_currentExecutionData.TimeLeftInProgramIsEstimated)
+		{
+			_currentExecutionData.TimeLeftInProgram = _currentExecutionData.TimeLeftInCurrentTrainingStep + _durationOfLaterSteps.value();
+		}
+	}
+
+	void TrainingProgramFlowControl::registerSessionEventReceiver(std::shared_ptr<ISessionEventReceiver> sessionEventReceiver)
+	{
+		_sessionEventReceivers.push_back(std::move(sessionEventReceiver));
+	}
+
+	void TrainingProgramFlowControl::recordSessionEvent(SessionEventType eventType, const std::chrono::milliseconds& duration)
+	{
+		if (!_selectedTrainingProgramId.has_value()) { return; }
+
+		const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(_timeProvider->currentDateTime().time_since_epoch()).count();
+		const auto sessionEvent = SessionEvent{ eventType, _selectedTrainingProgramId.value(), _currentTrainingStepNumber.value_or(0), duration, timestamp };
+		for (const auto& sessionEventReceiver : _sessionEventReceivers)
+		{
+			sessionEventReceiver->receiveSessionEvent(sessionEvent);
+		}
+	}
+
+	std::chrono::milliseconds TrainingProgramFlowControl::timeSpentInCurrentStep() const
+	{
+		// The reference time gets shifted by every pause which has ended. A pause which is still going on does not count either.
+		auto endTime = _pauseStartTime.has_value() ? _pauseStartTime.value() : _timeProvider->now();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(endTime - _referenceTime);
+	}
+
+	void TrainingProgramFlowControl::setPreStepCommands(std::vector<std::string> preStepCommands)
+	{
+		const auto tracedCommands = eventTraceIsRecording() ? EventTrace::formatArgument(preStepCommands) : std::string();
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::SetPreStepCommands, tracedCommands);
+		_preStepCommands = std::move(preStepCommands);
+	}
+
+	std::optional<std::string> TrainingProgramFlowControl::createLoadCommand(const configuration::TrainingProgramEntry& trainingProgramEntry) const
 	{
 		switch (trainingProgramEntry.Type)
 		{
 		case configuration::TrainingProgramEntryType::Freeplay:
-			if (!_gameWrapper->IsInFreeplay() || _currentEntry.Type == configuration::TrainingProgramEntryType::WorkshopMap) // IsInFreeplay() will return true for workshop maps
+			if (!_loadedMapTracker.currentTarget().has_value()
+				&& _gameWrapper->IsInFreeplay()
+				&& _currentEntry.Type != configuration::TrainingProgramEntryType::WorkshopMap) // IsInFreeplay() will return true for workshop maps
 			{
-				_gameWrapper->Execute([this](GameWrapper*) { _cvarManager->executeCommand("load_freeplay"); });
+				return {}; // We did not load anything yet, but the player is in freeplay already
 			}
-			break;
+			return "load_freeplay";
 		case configuration::TrainingProgramEntryType::CustomTraining:
-			_gameWrapper->Execute([this, trainingProgramEntry](GameWrapper*) { _cvarManager->executeCommand(fmt::format("load_training {}", trainingProgramEntry.TrainingPackCode)); });
-			break;
+			return fmt::format("load_training {}", trainingProgramEntry.TrainingPackCode);
 		case configuration::TrainingProgramEntryType::WorkshopMap:
-			_gameWrapper->Execute([this, trainingProgramEntry](GameWrapper*) { _cvarManager->executeCommand(fmt::format("load_workshop \"{}\\{}\"", _trainingProgramList.WorkshopFolderLocation, trainingProgramEntry.WorkshopMapPath)); });
+			return fmt::format("load_workshop \"{}\\{}\"", _trainingProgramList.WorkshopFolderLocation, trainingProgramEntry.WorkshopMapPath);
 		default:
-			// Do nothing
-			break;
+			return {};
 		}
 	}
 
+	void TrainingProgramFlowControl::setPreloadSettings(bool preloadIsEnabled, const std::chrono::milliseconds& defaultLeadTime)
+	{
+		const auto tracedSettings = eventTraceIsRecording()
+			? EventTrace::formatArgument({ preloadIsEnabled ? "1" : "0", std::to_string(defaultLeadTime.count()) })
+			: std::string();
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::SetPreloadSettings, tracedSettings);
+		_preloadIsEnabled = preloadIsEnabled;
+		_defaultPreloadLeadTime = defaultLeadTime;
+		_nextStepLeadTime.reset();
+	}
+
+	void TrainingProgramFlowControl::prepareNextStepIfDue(const std::chrono::milliseconds& timeLeftInStep)
+	{
+		if (!_preloadIsEnabled || _preloadedStepNumber.has_value() || !_currentExecutionData.NextStepPrompt.empty())
+		{
+			return; // Disabled or already done
+		}
+
+		const auto& trainingProgramData = _trainingProgramList.TrainingProgramData.at(_selectedTrainingProgramId.value());
+		const auto nextStepNumber = (uint16_t)(_currentTrainingStepNumber.value() + 1);
+		if (nextStepNumber >= trainingProgramData.Entries.size())
+		{
+			return;
+		}
+		const auto& nextEntry = trainingProgramData.Entries.at(nextStepNumber);
+
+		// Creating the load command formats a string, so this happens once per step rather than on every timer tick
+		if (!_nextStepLeadTime.has_value())
+		{
+			auto loadCommand = createLoadCommand(nextEntry);
+			_nextStepLeadTime = loadCommand.has_value() ? _loadTimeEstimator.estimateLeadTime(loadCommand.value(), _defaultPreloadLeadTime) : _defaultPreloadLeadTime;
+		}
+		if (timeLeftInStep > _nextStepLeadTime.value())
+		{
+			return;
+		}
+
+		if (nextEntry.TimeMode == configuration::TrainingProgramCompletionMode::CompletePack)
+		{
+			// Loading the pack early would let the player start shooting before the step has started, so we only announce it
+			_currentExecutionData.NextStepPrompt = fmt::format("Get ready: {}", nextEntry.Name);
+			return;
+		}
+
+		auto batch = _cvarManager->createBatch();
+		switchGameModeIfNecessary(nextEntry, nextStepNumber, batch);
+		executeBatch(std::move(batch));
+		_preloadedStepNumber = nextStepNumber;
+	}
+
+	void TrainingProgramFlowControl::handleMapLoadStart()
+	{
+		diagnostics::TimelineRecorder::recordBegin("map", "Map load");
+		_loadedMapTracker.handleMapLoadStart(_timeProvider->now());
+		_mapLoadIsInProgress = true;
+
+		forgetPendingMapLoadIfExpired();
+		if (_pendingMapLoad.has_value())
+		{
+			_pendingMapLoad->LoadHasStarted = true;
+		}
+		auto mapIsForLaterStep = _pendingMapLoad.has_value() && _pendingMapLoad->StepNumber != _currentTrainingStepNumber;
+		if (!mapIsForLaterStep)
+		{
+			updateMapLoadingState(PausedState::Paused);
+		}
+	}
+
+	void TrainingProgramFlowControl::handleMapLoadEnd()
+	{
+		diagnostics::TimelineRecorder::recordEnd("map", "Map load");
+		_loadedMapTracker.handleMapLoadEnd();
+		_mapLoadIsInProgress = false;
+		updateMapLoadingState(PausedState::NotPaused);
+
+		if (_pendingMapLoad.has_value() && _pendingMapLoad->LoadHasStarted)
+		{
+			auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(_timeProvider->now() - _pendingMapLoad->StartTime);
+			_loadTimeEstimator.recordLoadTime(_pendingMapLoad->LoadCommand, loadTime);
+			_pendingMapLoad.reset();
+			_nextStepLeadTime.reset(); // The next map might take a different time now
+		}
+	}
+
+	void TrainingProgramFlowControl::updateMapLoadingState(PausedState mapLoadingState)
+	{
+		if (_mapLoadingState == mapLoadingState)
+		{
+			return;
+		}
+		_mapLoadingState = mapLoadingState;
+
+		if (mapLoadingState == PausedState::Paused && trainingProgramIsActive())
+		{
+			_mapLoadStartTime = _timeProvider->now();
+			recordSessionEvent(SessionEventType::MapLoadStarted);
+		}
+		else if (mapLoadingState == PausedState::NotPaused && _mapLoadStartTime.has_value())
+		{
+			recordSessionEvent(SessionEventType::MapLoadEnded, std::chrono::duration_cast<std::chrono::milliseconds>(_timeProvider->now() - _mapLoadStartTime.value()));
+			_mapLoadStartTime.reset();
+		}
+		updatePauseState();
+	}
+
+	void TrainingProgramFlowControl::forgetPendingMapLoadIfExpired()
+	{
+		// Same timeout as the map tracker: A command which did not start a load in time was probably rejected, so a later load is not ours
+		if (_pendingMapLoad.has_value() && !_pendingMapLoad->LoadHasStarted && _timeProvider->now() - _pendingMapLoad->StartTime > LoadedMapTracker::LoadStartTimeout)
+		{
+			_pendingMapLoad.reset();
+		}
+	}
+
+	void TrainingProgramFlowControl::setWorkshopMapCheck(std::function<bool(const std::string& workshopMapPath)> workshopMapExists)
+	{
+		_workshopMapExists = std::move(workshopMapExists);
+	}
+
+	void TrainingProgramFlowControl::refreshMissingWorkshopMaps()
+	{
+		if (auto iter = _selectedTrainingProgramId.has_value() ? _trainingProgramList.TrainingProgramData.find(_selectedTrainingProgramId.value()) : _trainingProgramList.TrainingProgramData.end();
+			iter != _trainingProgramList.TrainingProgramData.end())
+		{
+			_currentFlowData.MissingWorkshopMaps = findMissingWorkshopMaps(iter->second);
+		}
+	}
+
+	std::vector<std::string> TrainingProgramFlowControl::findMissingWorkshopMaps(const configuration::TrainingProgramData& trainingProgramData) const
+	{
+		std::vector<std::string> missingWorkshopMaps;
+		if (!_workshopMapExists) { return missingWorkshopMaps; }
+
+		for (const auto& entry : trainingProgramData.Entries)
+		{
+			if (entry.Type == configuration::TrainingProgramEntryType::WorkshopMap && !_workshopMapExists(entry.WorkshopMapPath))
+			{
+				missingWorkshopMaps.push_back(entry.WorkshopMapPath);
+			}
+		}
+		return missingWorkshopMaps;
+	}
+
 	void TrainingProgramFlowControl::pauseTrainingProgram()
 	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Pause);
 		_trainingProgramPausedState = PausedState::Paused;
 		updatePauseState();
 	}
 	void TrainingProgramFlowControl::resumeTrainingProgram()
 	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Resume);
 		_trainingProgramPausedState = PausedState::NotPaused;
 		updatePauseState();
 	}
@@ -221,6 +595,7 @@ namespace training
 
 	void TrainingProgramFlowControl::handleTimerTick()
 	{
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::HandleTimerTick);
 		if (_currentTrainingProgramState != TrainingProgramState::Running || !_currentTrainingStepNumber.has_value())
 		{
 			return; // The "running" state is the only one in which we will ever need to make time comparisons
@@ -247,9 +622,15 @@ namespace training
 			else
 			{
 				updateTimeInfo(passedTime, _currentEntry.Duration);
+				prepareNextStepIfDue(_currentEntry.Duration - passedTime);
 			}
 		}
-		// else: Ignore timer ticks for untimed program entries
+		else if (_currentStepDurationEstimate.has_value())
+		{
+			// Untimed steps never end on a timer tick, but the estimated remaining time still needs to count down
+			updateTimeInfo(std::chrono::duration_cast<std::chrono::milliseconds>(_timeProvider->now() - _referenceTime), _currentStepDurationEstimate.value());
+		}
+		// else: Ignore timer ticks for untimed program entries without an estimate
 	}
 
 	void TrainingProgramFlowControl::updatePauseState()
@@ -257,6 +638,7 @@ namespace training
 		// Find out what is paused and if a state has changed
 		const auto trainingProgramIsPaused = _trainingProgramPausedState == PausedState::Paused;
 		const auto gameIsPaused = _gamePausedState == PausedState::Paused;
+		const auto mapIsLoading = _mapLoadingState == PausedState::Paused;
 
 		// Transition through the internal states only when in the Running state or one of the paused states
 		// Pausing the game in a different state will send a state update for the UI, but will not transition to a different state
@@ -277,6 +659,10 @@ namespace training
 			{
 				_currentTrainingProgramState = TrainingProgramState::BothPaused;
 			}
+			else if (mapIsLoading)
+			{
+				_currentTrainingProgramState = TrainingProgramState::MapLoading;
+			}
 			else
 			{
 				_currentTrainingProgramState = TrainingProgramState::Running;
@@ -284,27 +670,37 @@ namespace training
 
 			auto flowIsPaused = (_currentTrainingProgramState != TrainingProgramState::Running);
 
-			// Remember the start and end of pauses in case of timed programs
-			if (_currentEntry.TimeMode == configuration::TrainingProgramCompletionMode::Timed)
+			// Map loads freeze the step as well, but they have their own session events
+			auto playerIsPausing = gameIsPaused || trainingProgramIsPaused;
+			if (!_playerPauseStartTime.has_value() && playerIsPausing)
+			{
+				_playerPauseStartTime = _timeProvider->now();
+				recordSessionEvent(SessionEventType::PauseStarted);
+			}
+			else if (_playerPauseStartTime.has_value() && !playerIsPausing)
+			{
+				recordSessionEvent(SessionEventType::PauseEnded, std::chrono::duration_cast<std::chrono::milliseconds>(_timeProvider->now() - _playerPauseStartTime.value()));
+				_playerPauseStartTime.reset();
+			}
+
+			// Remember the start and end of pauses. Untimed steps need this as well, since their durations are used for estimating future completions.
+			if (!flowWasPaused && flowIsPaused)
 			{
-				if (!flowWasPaused && flowIsPaused)
+				// Pause has started
+				if (!_pauseStartTime.has_value())
 				{
-					// Pause has started
-					if (!_pauseStartTime.has_value())
-					{
-						// Rememeber the time when the pause started
-						_pauseStartTime = _timeProvider->now();
-					}
+					// Rememeber the time when the pause started
+					_pauseStartTime = _timeProvider->now();
 				}
-				else if (flowWasPaused && !flowIsPaused)
+			}
+			else if (flowWasPaused && !flowIsPaused)
+			{
+				// Pause has ended
+				if (_pauseStartTime.has_value())
 				{
-					// Pause has ended
-					if (_pauseStartTime.has_value())
-					{
-						// Shift the reference time forward by the duration of the pause. This way, calculations can use this time and act as if there hasn't been any pause.
-						_referenceTime = _timeProvider->now() - (_pauseStartTime.value() - _referenceTime);
-						_pauseStartTime.reset();
-					}
+					// Shift the reference time forward by the duration of the pause. This way, calculations can use this time and act as if there hasn't been any pause.
+					_referenceTime = _timeProvider->now() - (_pauseStartTime.value() - _referenceTime);
+					_pauseStartTime.reset();
 				}
 			}
 			// else: game was paused and is still paused (the fourth case should be impossible at this point)
@@ -315,20 +711,34 @@ namespace training
 		}
 
 		// Allow displaying the "Paused" state in the execution UI
-		_currentExecutionData.TrainingIsPaused = gameIsPaused || trainingProgramIsPaused;
+		// A map load freezes the timer as well, so the overlay must not pretend it is running
+		_currentExecutionData.TrainingIsPaused = gameIsPaused || trainingProgramIsPaused || (mapIsLoading && trainingProgramIsActive());
 	}
 
 	void TrainingProgramFlowControl::finishRunningTrainingProgram()
 	{
 		if (_selectedTrainingProgramId.has_value() && _currentTrainingProgramState == TrainingProgramState::Running)
 		{
-			stopRunningTrainingProgram();
+			recordSessionEvent(SessionEventType::StepEnded, timeSpentInCurrentStep());
+			recordSessionEvent(SessionEventType::ProgramFinished);
+			returnToSelectedState();
 			_currentExecutionData.TrainingFinishedTime = _timeProvider->now();
 		}
 		// Else: Rather than throwing an exception, ignore this.
 	}
 
 	void TrainingProgramFlowControl::stopRunningTrainingProgram()
+	{
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::Stop);
+		if (trainingProgramIsActive())
+		{
+			recordSessionEvent(SessionEventType::StepEnded, timeSpentInCurrentStep());
+			recordSessionEvent(SessionEventType::ProgramStopped);
+		}
+		returnToSelectedState();
+	}
+
+	void TrainingProgramFlowControl::returnToSelectedState()
 	{
 		if (_selectedTrainingProgramId.has_value())
 		{
@@ -347,11 +757,8 @@ namespace training
 			if (_currentTrainingStepNumber.has_value() && _currentTrainingStepNumber.value() < currentTrainingProgram.Entries.size())
 			{
 				_currentExecutionData.TimeLeftInCurrentTrainingStep = nextThreshold - passedTime;
-				_currentExecutionData.TimeLeftInProgram = -passedTime;
-				for (int index = _currentTrainingStepNumber.value(); index < currentTrainingProgram.Entries.size(); index++)
-				{
-					_currentExecutionData.TimeLeftInProgram += currentTrainingProgram.Entries.at(index).Duration;
-				}
+				// The durations of later steps have been summed up when the step was started
+				_currentExecutionData.TimeLeftInProgram = std::max(std::chrono::milliseconds(0), _currentExecutionData.TimeLeftInCurrentTrainingStep) + _durationOfLaterSteps.value_or(std::chrono::milliseconds(0));
 
 				// Fixup negative values (happens when "passedTime" doesn't match the training program duration exactly, which will probably happen almost always)
 				// Note: These fixups are historic and will probably be overriden after this method has been called anyway, but they'll stay here until that is proven.
@@ -370,23 +777,55 @@ namespace training
 	bool TrainingProgramFlowControl::trainingProgramIsActive() const
 	{
 		// The program is "active" if it is either running or paused
-		auto relevantStates = std::unordered_set<TrainingProgramState>{
-			TrainingProgramState::Running,
-			TrainingProgramState::OnlyGamePaused,
-			TrainingProgramState::OnlyProgramPaused,
-			TrainingProgramState::BothPaused
-		};
-		return relevantStates.count(_currentTrainingProgramState) > 0;
+		switch (_currentTrainingProgramState)
+		{
+		case TrainingProgramState::Running:
+		case TrainingProgramState::OnlyGamePaused:
+		case TrainingProgramState::OnlyProgramPaused:
+		case TrainingProgramState::BothPaused:
+		case TrainingProgramState::MapLoading:
+			return true;
+		default:
+			return false;
+		}
 	}
 
 	void TrainingProgramFlowControl::receiveListData(const configuration::TrainingProgramListData& data)
 	{
-		stopRunningTrainingProgram();
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::ReceiveListData);
+		// The list is part of the trace, so a replay receives the same changes. Serializing it is only worth it while recording, though.
+		const auto tracedList = eventTraceIsRecording() ? configuration::TrainingProgramRepository::serializeList(data) : std::string();
+		TraceScope traceScope(_eventTraceRecorder.get(), TraceEntryType::Command, TraceCommand::ReceiveListData, tracedList);
+
+		// Changes to other training programs, e.g. by a sync tool, must not interrupt the session
+		const auto keepRunning = trainingProgramIsActive() && !runningTrainingProgramIsAffectedBy(data);
+		if (!keepRunning)
+		{
+			stopRunningTrainingProgram();
+		}
 		_trainingProgramList = data;
 		_currentFlowData.TrainingPrograms.clear();
 		for (auto trainingProgramId : data.TrainingProgramOrder)
 		{
 			_currentFlowData.TrainingPrograms.push_back({ trainingProgramId, data.TrainingProgramData.at(trainingProgramId).Name });
 		}
+		if (keepRunning)
+		{
+			// The running program might have moved within the list
+			const auto& order = _trainingProgramList.TrainingProgramOrder;
+			_currentFlowData.SelectedTrainingProgramIndex = (uint16_t)std::distance(order.begin(), std::find(order.begin(), order.end(), _selectedTrainingProgramId.value()));
+		}
+	}
+
+	bool TrainingProgramFlowControl::runningTrainingProgramIsAffectedBy(const configuration::TrainingProgramListData& data) const
+	{
+		if (!_selectedTrainingProgramId.has_value()) { return false; }
+
+		const auto& trainingProgramId = _selectedTrainingProgramId.value();
+		auto newIter = data.TrainingProgramData.find(trainingProgramId);
+		if (newIter == data.TrainingProgramData.end()) { return true; } // The program was removed
+
+		return data.WorkshopFolderLocation != _trainingProgramList.WorkshopFolderLocation
+			|| configuration::TrainingProgramHasher::hashProgram(newIter->second) != configuration::TrainingProgramHasher::hashProgram(_trainingProgramList.TrainingProgramData.at(trainingProgramId));
 	}
 }
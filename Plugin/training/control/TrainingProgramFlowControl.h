@@ -6,9 +6,15 @@
 
 #include "../data/TrainingProgramFlowData.h"
 #include "../data/TrainingProgramExecutionData.h"
+#include "../data/SessionEvent.h"
 #include "IGameWrapper.h"
 #include "ITimeProvider.h"
 #include "ICVarManager.h"
+#include "LoadTimeEstimator.h"
+#include "ICompletionTimeEstimator.h"
+#include "EventTraceRecorder.h"
+#include "LoadedMapTracker.h"
+#include "VarianceApplier.h"
 
 #include <bakkesmod/wrappers/gamewrapper.h>
 
@@ -28,6 +34,7 @@ namespace training
 		OnlyGamePaused, // The training program is still "running", but the game is paused. The UI might still want to allow pausing the training program explicilty,
 						// so it does not continue once the game gets unpaused.
 		BothPaused, // Both the training program and the game are paused
+		MapLoading, // Neither the training program nor the game are paused, but the map of the current step is still being loaded
 	};
 
 	/** Defines the state of something which can be paused (game and training program). */
@@ -81,14 +88,48 @@ namespace training
 		/** Activates the next (or first) step of the training program. */
 		void activateNextTrainingProgramStep();
 
+		/** Activates the next step of the training program because the player does not want to finish the current one. */
+		void skipTrainingProgramStep();
+
+		/** Sets a function which checks whether a workshop map exists, so missing maps can be reported before a training program gets started. */
+		void setWorkshopMapCheck(std::function<bool(const std::string& workshopMapPath)> workshopMapExists);
+		/** Checks the workshop maps of the selected training program again, e.g. because the workshop folder was scanned in the meantime. */
+		void refreshMissingWorkshopMaps();
+
+		/**
+		 * Enables or disables loading the map of the next step shortly before the current step ends, so the map is ready when the step starts.
+		 * The lead time gets used until the load time of a map has been measured.
+		 */
+		void setPreloadSettings(bool preloadIsEnabled, const std::chrono::milliseconds& defaultLeadTime);
+
+		/** Retrieves the number of load commands which were issued or suppressed because the map was loaded already. */
+		inline LoadCommandCounters getLoadCommandCounters() const { return _loadedMapTracker.counters(); }
+
+		/** Sets an estimator which knows how long training packs take, so the remaining time of untimed steps can be estimated. */
+		void setCompletionTimeEstimator(std::shared_ptr<ICompletionTimeEstimator> completionTimeEstimator);
+
+		/** Sets a recorder which gets told about every call to this class, so sessions can be replayed later on. Events are recorded by the recorder itself. */
+		void setEventTraceRecorder(std::shared_ptr<EventTraceRecorder> eventTraceRecorder);
+		/** Records the settings and the selection which are in effect, so a trace which was started in the middle of a session can be replayed. */
+		void recordTraceHeader();
+
+		/** Registers a receiver which gets told about everything that happens while a training program is running, e.g. for recording a history. */
+		void registerSessionEventReceiver(std::shared_ptr<ISessionEventReceiver> sessionEventReceiver);
+
+		/** Sets commands which shall be executed whenever a step starts, before anything else gets changed. */
+		void setPreStepCommands(std::vector<std::string> preStepCommands);
+
 		/** Receives data from the configuration context. */
 		void receiveListData(const configuration::TrainingProgramListData& data) override;
 
 		/** Retrieves the current flow state (e.g. so an appropriate UI can be rendered). */
 		inline TrainingProgramFlowData getCurrentFlowData() const { return _currentFlowData; }
 
-		/** Retrieves the current execution state (e.g. so an appropriate UI can be rendered). */
-		inline TrainingProgramExecutionData getCurrentExecutionData() const { return _currentExecutionData; }
+		/**
+		 * Retrieves the current execution state (e.g. so an appropriate UI can be rendered).
+		 * This is not copied since it is needed on every frame, so it must only be used on the game thread, which is the one which changes it.
+		 */
+		inline const TrainingProgramExecutionData& getCurrentExecutionData() const { return _currentExecutionData; }
 
 	private:
 
@@ -105,8 +146,40 @@ namespace training
 		void finishRunningTrainingProgram();
 		/** Generates pause/resume events based on the current state. */
 		void updatePauseState();
-		/** Switches to freeplay, custom training or whatever the user configured. */
-		void switchGameModeIfNecessary(const configuration::TrainingProgramEntry& trainingProgramEntry);
+		/** Freezes or unfreezes the current step while its map is being loaded. This does not count as a pause. */
+		void updateMapLoadingState(PausedState mapLoadingState);
+		/** Forgets about a load command which did not lead to a map load in time, since the game probably rejected it. */
+		void forgetPendingMapLoadIfExpired();
+		/** Returns to the state where the training program is selected, but not running. */
+		void returnToSelectedState();
+		/** Checks whether the given list removes or changes the selected training program. */
+		bool runningTrainingProgramIsAffectedBy(const configuration::TrainingProgramListData& data) const;
+		/** Tells the session event receiver (if any) about something that happened to the current step. */
+		void recordSessionEvent(SessionEventType eventType, const std::chrono::milliseconds& duration = std::chrono::milliseconds(0));
+		/** Calculates how long the current step has been running so far, without pauses. */
+		std::chrono::milliseconds timeSpentInCurrentStep() const;
+		/** Adds the command which switches to freeplay, custom training or whatever the user configured, if that is necessary. */
+		void switchGameModeIfNecessary(const configuration::TrainingProgramEntry& trainingProgramEntry, uint16_t stepNumber, CommandBatch& batch);
+		/** Checks whether calls, inputs and results shall currently be recorded. */
+		bool eventTraceIsRecording() const;
+		/** Retrieves the value of the given cvar, and records it so a replay can provide the same value. */
+		std::string getCvarValue(const std::string& cvarName) const;
+		/** Executes the given commands in a single call on the game thread. */
+		void executeBatch(CommandBatch batch);
+		/** Creates the command which loads the map for the given entry, or nothing if the current map can be used. */
+		std::optional<std::string> createLoadCommand(const configuration::TrainingProgramEntry& trainingProgramEntry) const;
+		/** Preloads the next step, or announces it if it can't be preloaded, once the current step is about to end. */
+		void prepareNextStepIfDue(const std::chrono::milliseconds& timeLeftInStep);
+		/** Excludes the loading screen from the time of the current step, unless the map is being loaded for a later step. */
+		void handleMapLoadStart();
+		/** Measures how long the last load command took and resumes the current step. */
+		void handleMapLoadEnd();
+		/** Finds the workshop maps of the given training program which don't exist. */
+		std::vector<std::string> findMissingWorkshopMaps(const configuration::TrainingProgramData& trainingProgramData) const;
+		/** Retrieves the duration of the given step, or an estimate for an untimed step. Returns nothing if the duration is unknown. */
+		std::optional<std::chrono::milliseconds> estimateStepDuration(const configuration::TrainingProgramEntry& trainingProgramEntry, uint16_t stepNumber) const;
+		/** Estimates the durations of the current step and the steps after it. This is done once per step, so timer ticks only need to subtract. */
+		void estimateRemainingDurations(const configuration::TrainingProgramData& trainingProgramData);
 		/** Updates data for the UI based on the passed time and the threshold for the next step. */
 		void updateTimeInfo(const std::chrono::milliseconds& passedTime, const std::chrono::milliseconds& nextThreshold);
 
@@ -121,12 +194,41 @@ namespace training
 
 		PausedState _trainingProgramPausedState = PausedState::NotPaused;
 		PausedState _gamePausedState = PausedState::NotPaused;
+		PausedState _mapLoadingState = PausedState::NotPaused; // Loading a map pauses the step it is loaded for
+		bool _mapLoadIsInProgress = false;
 
 		std::chrono::steady_clock::time_point _referenceTime; // The "start" time to do calculations again. Will be shifted to account for game pauses, if necessary.
 		std::optional<std::chrono::steady_clock::time_point> _pauseStartTime = {}; // The point in time where a pause was started
+		std::optional<std::chrono::steady_clock::time_point> _playerPauseStartTime = {}; // Like _pauseStartTime, but only for pauses of the player or the game
+		std::optional<std::chrono::steady_clock::time_point> _mapLoadStartTime = {}; // The point in time where the current step got frozen for loading its map
 
 		std::shared_ptr<IGameWrapper> _gameWrapper;
 		std::shared_ptr<ITimeProvider> _timeProvider;
 		std::shared_ptr<ICVarManager> _cvarManager;
+		std::function<bool(const std::string&)> _workshopMapExists; // Optional
+		std::shared_ptr<ICompletionTimeEstimator> _completionTimeEstimator; // Optional
+		std::shared_ptr<EventTraceRecorder> _eventTraceRecorder; // Optional
+		std::vector<std::shared_ptr<ISessionEventReceiver>> _sessionEventReceivers;
+
+		/** A load command which was issued, but the map has not been loaded yet. */
+		struct PendingMapLoad
+		{
+			std::string LoadCommand;
+			std::chrono::steady_clock::time_point StartTime;
+			uint16_t StepNumber; // The step which needs the map
+			bool LoadHasStarted = false;
+		};
+		bool _preloadIsEnabled = false;
+		std::chrono::milliseconds _defaultPreloadLeadTime = std::chrono::seconds(5);
+		std::optional<uint16_t> _preloadedStepNumber = {}; // The step for which the map has already been loaded
+		std::optional<std::chrono::milliseconds> _nextStepLeadTime = {}; // Determined once per step, when it is needed for the first time
+		std::optional<PendingMapLoad> _pendingMapLoad = {};
+		LoadTimeEstimator _loadTimeEstimator;
+		LoadedMapTracker _loadedMapTracker;
+		VarianceApplier _varianceApplier;
+		std::vector<CompactVariance> _stepVariances; // One entry per step of the running program
+		std::vector<std::string> _preStepCommands;
+		std::optional<std::chrono::milliseconds> _currentStepDurationEstimate = {}; // Only set for untimed steps which have been completed before
+		std::optional<std::chrono::milliseconds> _durationOfLaterSteps = {}; // Nothing if any later step is untimed and can't be estimated
 	};
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <pch.h>
+#include "VarianceApplier.h"
+
+#include <cstdlib>
+#include <optional>
+
+namespace
+{
+	enum class ValueKind
+	{
+		Bool,
+		Number,
+		Range,
+	};
+
+	struct VarianceCvar
+	{
+		const char* CvarName;
+		ValueKind Kind;
+	};
+
+	// Indexed by training::VarianceSetting
+	const std::array<VarianceCvar, training::NumberOfVarianceSettings> VarianceCvars = { {
+		{ "sv_training_enabled", ValueKind::Bool },
+		{ "sv_training_limitboost", ValueKind::Number },
+		{ "sv_training_allowmirror", ValueKind::Bool },
+		{ "sv_training_player_velocity", ValueKind::Range },
+		{ "sv_training_var_speed", ValueKind::Number },
+		{ "sv_training_var_loc", ValueKind::Number },
+		{ "sv_training_var_loc_z", ValueKind::Number },
+		{ "sv_training_shuffle", ValueKind::Bool },
+		{ "sv_training_var_car_loc", ValueKind::Number },
+		{ "sv_training_var_car_rot", ValueKind::Number },
+		{ "sv_training_var_spin", ValueKind::Number },
+		{ "sv_training_var_rot", ValueKind::Number },
+	} };
+
+	/** Reads a number from the given position, skipping anything which can't be part of a number (like the brackets of a range). */
+	std::optional<float> readNumber(const std::string& text, size_t& position)
+	{
+		position = text.find_first_of("-+.0123456789", position);
+		if (position == std::string::npos) { return {}; }
+
+		const auto* start = text.c_str() + position;
+		char* end = nullptr;
+		auto value = std::strtof(start, &end);
+		if (end == start) { return {}; }
+		position += (size_t)(end - start);
+		return value;
+	}
+
+	void parseSetting(training::CompactVariance& variance, training::VarianceSetting setting, const std::string& text)
+	{
+		if (text.empty()) { return; } // Not configured
+
+		size_t position = 0;
+		switch (VarianceCvars[(size_t)setting].Kind)
+		{
+		case ValueKind::Bool:
+			if (text == "true" || text == "false")
+			{
+				variance.define(setting, text == "true" ? 1.0f : 0.0f);
+				return;
+			}
+			if (auto value = readNumber(text, position); value.has_value())
+			{
+				variance.define(setting, value.value() != 0.0f ? 1.0f : 0.0f);
+				return;
+			}
+			break;
+		case ValueKind::Number:
+			if (auto value = readNumber(text, position); value.has_value())
+			{
+				variance.define(setting, value.value());
+				return;
+			}
+			break;
+		case ValueKind::Range:
+			if (auto min = readNumber(text, position); min.has_value())
+			{
+				auto max = readNumber(text, position);
+				variance.define(setting, min.value());
+				variance.PlayerVelocityMax = max.value_or(min.value());
+				return;
+			}
+			break;
+		}
+		LOG("Ignoring invalid value '{}' for {}", text, VarianceCvars[(size_t)setting].CvarName);
+	}
+
+	bool valuesAreEqual(const training::CompactVariance& first, const training::CompactVariance& second, training::VarianceSetting setting)
+	{
+		return first.Values[(size_t)setting] == second.Values[(size_t)setting]
+			&& (setting != training::VarianceSetting::PlayerVelocity || first.PlayerVelocityMax == second.PlayerVelocityMax);
+	}
+
+	std::string formatValue(const training::CompactVariance& variance, training::VarianceSetting setting)
+	{
+		const auto value = variance.Values[(size_t)setting];
+		switch (VarianceCvars[(size_t)setting].Kind)
+		{
+		case ValueKind::Bool:
+			return value != 0.0f ? "1" : "0";
+		case ValueKind::Range:
+			return fmt::format("\"({:g}, {:g})\"", value, variance.PlayerVelocityMax);
+		default:
+			return fmt::format("{:g}", value);
+		}
+	}
+}
+
+namespace training
+{
+	CompactVariance VarianceApplier::parse(const configuration::VarianceSettings& varianceSettings)
+	{
+		auto variance = CompactVariance();
+		if (varianceSettings.UseDefaultSettings)
+		{
+			return variance;
+		}
+		parseSetting(variance, VarianceSetting::EnableTraining, varianceSettings.EnableTraining);
+		parseSetting(variance, VarianceSetting::LimitBoost, varianceSettings.LimitBoost);
+		parseSetting(variance, VarianceSetting::AllowMirror, varianceSettings.AllowMirror);
+		parseSetting(variance, VarianceSetting::PlayerVelocity, varianceSettings.PlayerVelocity);
+		parseSetting(variance, VarianceSetting::VarSpeed, varianceSettings.VarSpeed);
+		parseSetting(variance, VarianceSetting::VarLoc, varianceSettings.VarLoc);
+		parseSetting(variance, VarianceSetting::VarLocZ, varianceSettings.VarLocZ);
+		parseSetting(variance, VarianceSetting::Shuffle, varianceSettings.Shuffle);
+		parseSetting(variance, VarianceSetting::VarCarLoc, varianceSettings.VarCarLoc);
+		parseSetting(variance, VarianceSetting::VarCarRot, varianceSettings.VarCarRot);
+		parseSetting(variance, VarianceSetting::VarSpin, varianceSettings.VarSpin);
+		parseSetting(variance, VarianceSetting::VarRot, varianceSettings.VarRot);
+		return variance;
+	}
+
+	std::vector<std::string> VarianceApplier::createCommands(const CompactVariance& target, const std::function<std::string(const std::string&)>& readCurrentValue)
+	{
+		std::vector<std::string> commands;
+		if (target.DefinedSettings == 0 && _appliedVariance.DefinedSettings == 0)
+		{
+			return commands; // The most common case: Neither the previous nor the next step change anything
+		}
+
+		for (size_t index = 0; index < NumberOfVarianceSettings; index++)
+		{
+			const auto setting = (VarianceSetting)index;
+			const auto& cvarName = VarianceCvars[index].CvarName;
+			const auto isApplied = _appliedVariance.isDefined(setting);
+			if (target.isDefined(setting))
+			{
+				if (isApplied && valuesAreEqual(_appliedVariance, target, setting))
+				{
+					continue;
+				}
+				if (!isApplied)
+				{
+					_originalValues[index] = readCurrentValue(cvarName);
+				}
+				_appliedVariance.define(setting, target.Values[index]);
+				if (setting == VarianceSetting::PlayerVelocity)
+				{
+					_appliedVariance.PlayerVelocityMax = target.PlayerVelocityMax;
+				}
+				commands.push_back(fmt::format("{} {}", cvarName, formatValue(target, setting)));
+			}
+			else if (isApplied)
+			{
+				commands.push_back(fmt::format("{} \"{}\"", cvarName, _originalValues[index]));
+				_appliedVariance.undefine(setting);
+			}
+		}
+		return commands;
+	}
+
+	std::vector<std::string> VarianceApplier::createRestoreCommands()
+	{
+		return createCommands(CompactVariance(), [](const std::string&) { return std::string(); }); // The reader is never needed for restoring
+	}
+}
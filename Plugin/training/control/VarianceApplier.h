@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../data/CompactVariance.h"
+#include "../../configuration/data/TrainingProgramEntry.h"
+
+#include <DLLImportExport.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace training
+{
+	/**
+	 * The job of this class is to apply the variance settings of training steps with as few commands as possible,
+	 * and to restore the values the player had configured before, once they are no longer needed.
+	 */
+	class RLTT_IMPORT_EXPORT VarianceApplier
+	{
+	public:
+		/** Converts the settings which are stored as text (for compatibility with other plugins) into the compact form. Values which can't be read are ignored. */
+		static CompactVariance parse(const configuration::VarianceSettings& varianceSettings);
+
+		/**
+		 * Creates the commands which change the currently applied variance into the given one. Settings the target does not define are restored.
+		 * The reader gets called for the current value of any setting which is about to be changed for the first time, so it can be restored later.
+		 */
+		std::vector<std::string> createCommands(const CompactVariance& target, const std::function<std::string(const std::string&)>& readCurrentValue);
+
+		/** Creates the commands which restore every setting that was changed. */
+		std::vector<std::string> createRestoreCommands();
+
+	private:
+		CompactVariance _appliedVariance; // Only contains the settings which we changed
+		std::array<std::string, NumberOfVarianceSettings> _originalValues;
+	};
+}
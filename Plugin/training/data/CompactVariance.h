@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace training
+{
+	/** Identifies one of the bakkesmod training variance settings. */
+	enum class VarianceSetting : uint8_t
+	{
+		EnableTraining,
+		LimitBoost,
+		AllowMirror,
+		PlayerVelocity,
+		VarSpeed,
+		VarLoc,
+		VarLocZ,
+		Shuffle,
+		VarCarLoc,
+		VarCarRot,
+		VarSpin,
+		VarRot,
+		NumberOfSettings
+	};
+	constexpr size_t NumberOfVarianceSettings = (size_t)VarianceSetting::NumberOfSettings;
+
+	/**
+	 * POD struct which stores the variance settings of a training step in a form which can be compared cheaply.
+	 *
+	 * Settings which are not part of DefinedSettings are left untouched. Bools are stored as 0 or 1.
+	 * The player velocity is a range, its upper bound is stored in PlayerVelocityMax.
+	 */
+	struct CompactVariance
+	{
+	public:
+		uint16_t DefinedSettings = 0; // One bit per VarianceSetting
+		std::array<float, NumberOfVarianceSettings> Values = {};
+		float PlayerVelocityMax = 0.0f;
+
+		inline bool isDefined(VarianceSetting setting) const { return (DefinedSettings & (1u << (uint8_t)setting)) != 0; }
+		inline void define(VarianceSetting setting, float value)
+		{
+			DefinedSettings |= (uint16_t)(1u << (uint8_t)setting);
+			Values[(size_t)setting] = value;
+		}
+		inline void undefine(VarianceSetting setting) { DefinedSettings &= (uint16_t)~(1u << (uint8_t)setting); }
+	};
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace training
+{
+	/** Defines the things which can happen while a training program is being executed. */
+	enum class SessionEventType : uint8_t
+	{
+		ProgramStarted,
+		StepStarted,
+		StepEnded, // Duration contains the time spent in the step, without pauses
+		StepSkipped,
+		PauseStarted,
+		PauseEnded, // Duration contains the length of the pause
+		PackCompleted,
+		ProgramFinished,
+		ProgramStopped,
+		MapLoadStarted, // The step is frozen until its map has been loaded. This is not a pause, since neither the player nor the game caused it.
+		MapLoadEnded, // Duration contains the time the step was frozen
+	};
+
+	/** POD struct which describes a single thing which happened while a training program was executed. */
+	struct SessionEvent
+	{
+	public:
+		SessionEventType Type = SessionEventType::ProgramStarted;
+		std::string_view TrainingProgramId; // Only valid during the call to the receiver
+		uint16_t StepNumber = 0;
+		std::chrono::milliseconds Duration = std::chrono::milliseconds(0);
+		int64_t Timestamp = 0; // Milliseconds since the Unix epoch, taken from the time provider of the flow control
+	};
+
+	/** Interface for classes which want to know what happens while a training program is being executed. */
+	class RLTT_IMPORT_EXPORT ISessionEventReceiver
+	{
+	protected:
+		ISessionEventReceiver() = default;
+
+	public:
+		virtual ~ISessionEventReceiver() = default;
+
+		/** Gets called on the thread which drives the training program flow, so implementations must return quickly. */
+		virtual void receiveSessionEvent(const SessionEvent& sessionEvent) = 0;
+	};
+}
@@ -23,5 +23,8 @@ namespace training
 		bool TrainingIsPaused = false;
 		bool ProgramHasUntimedSteps = false;
 		bool CurrentStepIsUntimed = false;
+		bool TimeLeftInCurrentTrainingStepIsEstimated = false; // The current step is untimed, but the player has completed its pack before
+		bool TimeLeftInProgramIsEstimated = false; // The program has untimed steps, but all of the remaining ones could be estimated
+		std::string NextStepPrompt; // Announces the next step shortly before it starts, in case it can't be preloaded
 	};
 }
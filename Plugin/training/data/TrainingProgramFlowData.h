@@ -26,5 +26,7 @@ namespace training
 		bool ResumingIsPossible = false;
 		bool StoppingIsPossible = false;
 		bool SkippingIsPossible = false;
+		std::vector<std::string> MissingWorkshopMaps; // Workshop map paths of the selected training program which could not be found
+		std::vector<std::string> SelectedTrainingProgramStepNames;
 	};
 }
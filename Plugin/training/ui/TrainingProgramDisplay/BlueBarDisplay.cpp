@@ -1,10 +1,12 @@
 #include "pch.h"
 #include "BlueBarDisplay.h"
+#include <diagnostics/PerformanceCounters.h>
 
 namespace training
 {
 	void BlueBarDisplay::renderOneFrame(const std::shared_ptr<GameWrapper>& gameWrapper, CanvasWrapper canvas, const TrainingProgramExecutionData& data)
 	{
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::BlueBarDisplayRender);
 		TrainingProgramDisplay::renderOneFrame(gameWrapper, canvas, data);
 
 		if (data.TrainingFinishedTime.has_value())
@@ -26,6 +28,7 @@ namespace training
 		drawTrainingStepNumber(canvas, renderInfo);
 		drawRemainingStepTime(canvas, renderInfo);
 		drawRemainingProgramTime(canvas, renderInfo);
+		drawNextStepPrompt(canvas, renderInfo);
 		drawTrainingProgramStepTransition(canvas, renderInfo, gameWrapper);
 	}
 
@@ -56,58 +59,39 @@ namespace training
 		// Program Name
 		canvas.SetColor(LinearColor{ 255.0f, 255.0f, 255.0f, 255.0f });
 		canvas.SetPosition(Vector2{ renderInfo.LeftBorder + (int)floor(renderInfo.Width * 0.005f), renderInfo.TopBorder + (int)floor(renderInfo.Height * 0.2f) });
-		auto shortenedName = fmt::format("{}{}", _data.TrainingIsPaused ? "PAUSED - " : "", _data.TrainingProgramName);
-		shortenedName = shortenedName.substr(0, 40);
-		canvas.DrawString(shortenedName, 1.6f * renderInfo.TextWidthFactor, 1.6f * renderInfo.TextHeightFactor);
+		canvas.DrawString(_text.programName(), 1.6f * renderInfo.TextWidthFactor, 1.6f * renderInfo.TextHeightFactor);
 	}
 	void BlueBarDisplay::drawTrainingStepNumber(CanvasWrapper& canvas, const RenderInfo& renderInfo) const
 	{
 		// Training Step Number and Name
 		canvas.SetPosition(Vector2{ renderInfo.LeftBorder + (int)floor(renderInfo.Width * 0.25f), renderInfo.TopBorder + (int)floor(renderInfo.Height * 0.1f) });
-		const auto shortenedName = _data.TrainingStepName.substr(0, 40);
-		canvas.DrawString(
-			fmt::format("{} / {}: {}", _data.TrainingStepNumber + 1, _data.NumberOfSteps, shortenedName),
-			2.5f * renderInfo.TextWidthFactor,
-			2.5f * renderInfo.TextHeightFactor
-		);
+		canvas.DrawString(_text.stepInfo(), 2.5f * renderInfo.TextWidthFactor, 2.5f * renderInfo.TextHeightFactor);
 	}
 	void BlueBarDisplay::drawRemainingStepTime(CanvasWrapper& canvas, const RenderInfo& renderInfo) const
 	{
+		// Remaining Step Time (~ marks an estimate based on previous completions of the pack)
 		canvas.SetPosition(Vector2{ renderInfo.LeftBorder + (int)floor(renderInfo.Width * 0.7f), renderInfo.TopBorder + (int)floor(renderInfo.Height * 0.1f) });
-		if (_data.CurrentStepIsUntimed)
-		{
-			canvas.DrawString("Next: On End", 2.5f * renderInfo.TextWidthFactor, 2.5f * renderInfo.TextHeightFactor);
-		}
-		else
-		{
-			// Remaining Step Time
-			const auto remainingStepTime = std::chrono::milliseconds(_data.TimeLeftInCurrentTrainingStep);
-			const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(remainingStepTime);
-			const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remainingStepTime - minutes);
-			canvas.DrawString(
-				fmt::format("Next: {}m {}s", minutes.count(), seconds.count()),
-				2.5f * renderInfo.TextWidthFactor,
-				2.5f * renderInfo.TextHeightFactor
-			);
-		}
+		canvas.DrawString(_text.remainingStepTime(), 2.5f * renderInfo.TextWidthFactor, 2.5f * renderInfo.TextHeightFactor);
 	}
 	void BlueBarDisplay::drawRemainingProgramTime(CanvasWrapper& canvas, const RenderInfo& renderInfo) const
 	{
 		// Remaining Program Time
-		if (!_data.ProgramHasUntimedSteps)
+		if (!_text.remainingProgramTime().empty())
 		{
 			canvas.SetPosition(Vector2{ renderInfo.LeftBorder + (int)floor(renderInfo.Width * 0.9f), renderInfo.TopBorder + (int)floor(renderInfo.Height * 0.2f) });
-			const auto remainingProgramTime = std::chrono::milliseconds(_data.TimeLeftInProgram);
-			const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(remainingProgramTime);
-			const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remainingProgramTime - minutes);
-			canvas.DrawString(
-				fmt::format("End: {}m {}s", minutes.count(), seconds.count()),
-				2.0f * renderInfo.TextWidthFactor,
-				2.0f * renderInfo.TextHeightFactor
-			);
+			canvas.DrawString(_text.remainingProgramTime(), 2.0f * renderInfo.TextWidthFactor, 2.0f * renderInfo.TextHeightFactor);
+		}
+		// Else: At least one of the remaining steps is untimed and the player has never completed its pack, so there is nothing which could be drawn here.
+	}
+
+	void BlueBarDisplay::drawNextStepPrompt(CanvasWrapper& canvas, const RenderInfo& renderInfo) const
+	{
+		if (!_text.nextStepPrompt().empty())
+		{
+			// Right above the remaining step time, so the bar itself does not have to be rearranged
+			canvas.SetPosition(Vector2{ renderInfo.LeftBorder + (int)floor(renderInfo.Width * 0.7f), renderInfo.TopBorder - renderInfo.Height });
+			canvas.DrawString(_text.nextStepPrompt(), 2.0f * renderInfo.TextWidthFactor, 2.0f * renderInfo.TextHeightFactor, true);
 		}
-		// Else: There is no information which could be drawed here.
-		// We could in theory start drawing the end again if none of the remaining steps were untimed, but that's not implemented at the moment
 	}
 
 	void BlueBarDisplay::drawCenteredText(const std::string& text, CanvasWrapper& canvas, const RenderInfo& renderInfo, const std::shared_ptr<GameWrapper>& gameWrapper, float stringScale, float alpha) const
@@ -136,35 +120,31 @@ namespace training
 
 	void BlueBarDisplay::drawTrainingProgramStepTransition(CanvasWrapper& canvas, const RenderInfo& renderInfo, const std::shared_ptr<GameWrapper>& gameWrapper) const
 	{
-		if (_data.TrainingStepStartTime.has_value())
+		if (_data->TrainingStepStartTime.has_value())
 		{
-			auto millisecondsInCurrentTrainingStep = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data.TrainingStepStartTime.value());
+			auto millisecondsInCurrentTrainingStep = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data->TrainingStepStartTime.value());
 			if (millisecondsInCurrentTrainingStep.count() < 5000)
 			{
-				auto trainingStepName = _data.TrainingStepName;
 				// alpha: 100% for two seconds, then fade out
 				auto textAlpha = fmin(1.0f, (5000.0f - (float)millisecondsInCurrentTrainingStep.count()) / 3000.0f) * 255.0f;
 				auto stringScale = 10.0f;
 
-				drawCenteredText(trainingStepName, canvas, renderInfo, gameWrapper, stringScale, textAlpha);
+				drawCenteredText(_data->TrainingStepName, canvas, renderInfo, gameWrapper, stringScale, textAlpha);
 			}
-			if (auto msLeftInStep = _data.TimeLeftInCurrentTrainingStep.count();
-				msLeftInStep <= 3000)
+			if (!_text.countdown().empty())
 			{
+				auto msLeftInStep = _data->TimeLeftInCurrentTrainingStep.count();
 				auto secondsLeft = (int)ceil((float)msLeftInStep / 1000.0f);
-				if (secondsLeft > 0)
-				{
-					auto textAlpha = (float)(msLeftInStep - (secondsLeft - 1LL) * 1000LL) * 0.155f + 100.0f;
-					auto stringScale = 20.0f;
-					drawCenteredText(std::to_string(secondsLeft), canvas, renderInfo, gameWrapper, stringScale, textAlpha);
-				}
+				auto textAlpha = (float)(msLeftInStep - (secondsLeft - 1LL) * 1000LL) * 0.155f + 100.0f;
+				auto stringScale = 20.0f;
+				drawCenteredText(_text.countdown(), canvas, renderInfo, gameWrapper, stringScale, textAlpha);
 			}
 		}
 	}
 
 	void BlueBarDisplay::drawTrainingProgramFinishedInfo(CanvasWrapper& canvas, const RenderInfo& renderInfo, const std::shared_ptr<GameWrapper>& gameWrapper) const
 	{
-		auto millisecondsSinceFinished = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data.TrainingFinishedTime.value()).count();
+		auto millisecondsSinceFinished = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data->TrainingFinishedTime.value()).count();
 		if (millisecondsSinceFinished < 5000)
 		{
 			auto stringScale = 20.0f;
@@ -20,6 +20,7 @@ namespace training
 	private:
 		void drawPanelBackground(CanvasWrapper& canvas, const RenderInfo& renderInfo) const;
 		void drawRemainingProgramTime(CanvasWrapper& canvas, const RenderInfo& renderInfo) const;
+		void drawNextStepPrompt(CanvasWrapper& canvas, const RenderInfo& renderInfo) const;
 		void drawRemainingStepTime(CanvasWrapper& canvas, const RenderInfo& renderInfo) const;
 		void drawTrainingStepNumber(CanvasWrapper& canvas, const RenderInfo& renderInfo) const;
 		void drawProgramName(CanvasWrapper& canvas, const RenderInfo& renderInfo) const;
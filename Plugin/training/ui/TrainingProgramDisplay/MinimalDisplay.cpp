@@ -1,10 +1,12 @@
 #include "pch.h"
 #include "MinimalDisplay.h"
+#include <diagnostics/PerformanceCounters.h>
 
 namespace training
 {
 	void MinimalDisplay::renderOneFrame(const std::shared_ptr<GameWrapper>& gameWrapper, CanvasWrapper canvas, const TrainingProgramExecutionData& data)
 	{
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::MinimalDisplayRender);
 		TrainingProgramDisplay::renderOneFrame(gameWrapper, canvas, data);
 		auto renderInfo = getRenderInfo(gameWrapper);
 		drawInfo(canvas, renderInfo);
@@ -35,9 +37,9 @@ namespace training
 		LinearColor textColor{ 255.0f, 255.0f, 255.0f, 255.0f };
 
 		// transition
-		if (_data.TrainingStepStartTime.has_value())
+		if (_data->TrainingStepStartTime.has_value())
 		{
-			auto millisecondsInCurrentTrainingStep = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data.TrainingStepStartTime.value());
+			auto millisecondsInCurrentTrainingStep = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data->TrainingStepStartTime.value());
 			if (millisecondsInCurrentTrainingStep.count() < 2000)
 			{
 				float bgFlash = fmin(1.0f, (2000.0f - (float)millisecondsInCurrentTrainingStep.count()) / 2000.0f) * 255.0f;
@@ -47,36 +49,28 @@ namespace training
 		}
 
 		// finished
-		std::string text = "";
-		if (_data.TrainingFinishedTime.has_value())
+		static const auto finishedText = std::string("Finished!");
+		const std::string* text = nullptr; // Points to a text which lives longer than this frame, so nothing gets copied
+		if (_data->TrainingFinishedTime.has_value())
 		{
-			auto millisecondsSinceFinished = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data.TrainingFinishedTime.value()).count();
+			auto millisecondsSinceFinished = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _data->TrainingFinishedTime.value()).count();
 			if (millisecondsSinceFinished < 5000) {
 				bgColor = { 0.0f, 255.0f, 0.0f, bgAlpha };
 				textColor = { 0.0f, 0.0f, 0.0f, 255.0f };
-				text = "Finished!";
+				text = &finishedText;
 			}
 		}
 
-		if(_data.NumberOfSteps > 0 && _data.TrainingStepStartTime.has_value()) {
-			// Training Step Number and Name
-			const auto shortenedName = _data.TrainingStepName.substr(0, 40);
-			std::string timeLeft = "-";
-			if(!_data.CurrentStepIsUntimed) {
-				// Remaining Step Time
-				const auto remainingStepTime = std::chrono::milliseconds(_data.TimeLeftInCurrentTrainingStep);
-				const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(remainingStepTime);
-				const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remainingStepTime - minutes);
-				timeLeft = fmt::format("{}m {}s", minutes.count(), seconds.count());
-			}
-			text = fmt::format("{} / {}    {}    {}", _data.TrainingStepNumber + 1, _data.NumberOfSteps, shortenedName, timeLeft);
+		if(!_text.compactInfo().empty()) {
+			// Training Step Number, Name and Remaining Step Time
+			text = &_text.compactInfo();
 		}
 		
-		if(text.length() == 0) {
+		if(text == nullptr) {
 			return;
 		}
 
-		Vector2F stringSize = canvas.GetStringSize(text);
+		Vector2F stringSize = canvas.GetStringSize(*text);
 		float centerX = renderInfo.LeftBorder + (renderInfo.Width / 2.0f);
 
 		// bakground
@@ -91,7 +85,7 @@ namespace training
 		canvas.SetPosition(Vector2{ (int)round(centerX - (stringSize.X / 2.0f)), renderInfo.TopBorder + (int)floor(renderInfo.Height * 0.2f) });
 		canvas.SetColor(textColor);
 		canvas.DrawString(
-			text,
+			*text,
 			2.0f * renderInfo.TextWidthFactor,
 			2.0f * renderInfo.TextHeightFactor
 		);
@@ -0,0 +1,104 @@
+#include <pch.h>
+#include "OverlayText.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	constexpr size_t MaximumTextLength = 128; // Enough for two names and some numbers
+	constexpr size_t MaximumNameLength = 40; // Longer names would not fit on the screen
+
+	/** Cuts off the given text without copying it. */
+	fmt::string_view shorten(const std::string& text)
+	{
+		return fmt::string_view(text.data(), std::min(text.size(), MaximumNameLength));
+	}
+
+	/** Replaces the contents of the given text. The text must have reserved at least the maximum length, otherwise this would allocate. */
+	template <typename... Args>
+	void formatInto(std::string& text, size_t maximumLength, const char* format, const Args&... args)
+	{
+		text.resize(maximumLength);
+		const auto result = fmt::format_to_n(text.data(), maximumLength, format, args...);
+		text.resize(std::min(result.size, maximumLength));
+	}
+
+	/** Replaces the contents of the given text by a label and a duration in minutes and seconds. Estimates are marked with a ~. */
+	void formatDurationInto(std::string& text, const char* label, bool isEstimated, const std::chrono::milliseconds& duration)
+	{
+		const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration);
+		const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration - minutes);
+		formatInto(text, MaximumTextLength, "{}: {}{}m {}s", label, isEstimated ? "~" : "", minutes.count(), seconds.count());
+	}
+}
+
+namespace training
+{
+	OverlayText::OverlayText()
+	{
+		for (auto text : { &_programName, &_stepInfo, &_remainingStepTime, &_remainingProgramTime, &_nextStepPrompt, &_countdown, &_compactInfo })
+		{
+			text->reserve(MaximumTextLength);
+		}
+	}
+
+	void OverlayText::update(const TrainingProgramExecutionData& data)
+	{
+		formatInto(_programName, MaximumNameLength, "{}{}", data.TrainingIsPaused ? "PAUSED - " : "", data.TrainingProgramName);
+		formatInto(_stepInfo, MaximumTextLength, "{} / {}: {}", data.TrainingStepNumber + 1, data.NumberOfSteps, shorten(data.TrainingStepName));
+		formatInto(_nextStepPrompt, MaximumNameLength, "{}", data.NextStepPrompt);
+
+		const auto stepTimeIsKnown = !data.CurrentStepIsUntimed || data.TimeLeftInCurrentTrainingStepIsEstimated;
+		if (stepTimeIsKnown)
+		{
+			formatDurationInto(_remainingStepTime, "Next", data.TimeLeftInCurrentTrainingStepIsEstimated, data.TimeLeftInCurrentTrainingStep);
+		}
+		else
+		{
+			formatInto(_remainingStepTime, MaximumTextLength, "Next: On End");
+		}
+
+		if (!data.ProgramHasUntimedSteps || data.TimeLeftInProgramIsEstimated)
+		{
+			formatDurationInto(_remainingProgramTime, "End", data.TimeLeftInProgramIsEstimated, data.TimeLeftInProgram);
+		}
+		else
+		{
+			_remainingProgramTime.clear(); // At least one of the remaining steps is untimed and the player has never completed its pack
+		}
+
+		_countdown.clear();
+		if (const auto msLeftInStep = data.TimeLeftInCurrentTrainingStep.count();
+			msLeftInStep <= 3000 && !data.CurrentStepIsUntimed) // Counting down to an estimated end would be misleading
+		{
+			if (const auto secondsLeft = (int)ceil((float)msLeftInStep / 1000.0f); secondsLeft > 0)
+			{
+				formatInto(_countdown, MaximumTextLength, "{}", secondsLeft);
+			}
+		}
+
+		_compactInfo.clear();
+		if (data.NumberOfSteps > 0 && data.TrainingStepStartTime.has_value())
+		{
+			const auto promptSeparator = _nextStepPrompt.empty() ? "" : "    ";
+			if (stepTimeIsKnown)
+			{
+				const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(data.TimeLeftInCurrentTrainingStep);
+				const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(data.TimeLeftInCurrentTrainingStep - minutes);
+				formatInto(_compactInfo, MaximumTextLength, "{} / {}    {}    {}{}m {}s{}{}",
+					data.TrainingStepNumber + 1, data.NumberOfSteps, shorten(data.TrainingStepName),
+					data.TimeLeftInCurrentTrainingStepIsEstimated ? "~" : "", minutes.count(), seconds.count(),
+					promptSeparator, _nextStepPrompt);
+			}
+			else
+			{
+				formatInto(_compactInfo, MaximumTextLength, "{} / {}    {}    -{}{}",
+					data.TrainingStepNumber + 1, data.NumberOfSteps, shorten(data.TrainingStepName),
+					promptSeparator, _nextStepPrompt);
+			}
+		}
+	}
+}
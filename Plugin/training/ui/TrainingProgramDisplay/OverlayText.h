@@ -0,0 +1,48 @@
+#pragma once
+
+#include <DLLImportExport.h>
+#include <training/data/TrainingProgramExecutionData.h>
+
+#include <string>
+
+namespace training
+{
+	/**
+	 * The job of this class is to compose the texts of the training overlay, which is drawn on every frame.
+	 * Every text has its own buffer which is reserved once, so updating the texts does not allocate any memory.
+	 * Texts are cut off at a fixed length rather than growing their buffer.
+	 */
+	class RLTT_IMPORT_EXPORT OverlayText
+	{
+	public:
+		/** Constructor. Reserves the buffers of all texts. */
+		OverlayText();
+
+		/** Composes all texts for the given data. */
+		void update(const TrainingProgramExecutionData& data);
+
+		/** The name of the program, prefixed with PAUSED if necessary. */
+		inline const std::string& programName() const { return _programName; }
+		/** The number and name of the current step. */
+		inline const std::string& stepInfo() const { return _stepInfo; }
+		/** The remaining time of the current step, or a note that the step ends with the pack. */
+		inline const std::string& remainingStepTime() const { return _remainingStepTime; }
+		/** The remaining time of the program. Empty if it is unknown. */
+		inline const std::string& remainingProgramTime() const { return _remainingProgramTime; }
+		/** The announcement of the next step. Empty if there is none. */
+		inline const std::string& nextStepPrompt() const { return _nextStepPrompt; }
+		/** The seconds until the current step ends, during the last three seconds of a timed step. Empty otherwise. */
+		inline const std::string& countdown() const { return _countdown; }
+		/** Everything about the current step in a single line, for compact displays. */
+		inline const std::string& compactInfo() const { return _compactInfo; }
+
+	private:
+		std::string _programName;
+		std::string _stepInfo;
+		std::string _remainingStepTime;
+		std::string _remainingProgramTime;
+		std::string _nextStepPrompt;
+		std::string _countdown;
+		std::string _compactInfo;
+	};
+}
@@ -4,6 +4,7 @@
 #include <bakkesmod/wrappers/GameWrapper.h>
 
 #include <training/data/TrainingProgramExecutionData.h>
+#include "OverlayText.h"
 
 namespace training
 {
@@ -25,14 +26,16 @@ namespace training
 	class TrainingProgramDisplay
 	{
 	public:
-		/** Renders a single frame. */
+		/** Renders a single frame. The data must stay valid until the frame has been rendered. */
 		virtual void renderOneFrame(const std::shared_ptr<GameWrapper>& gameWrapper, CanvasWrapper canvas, const TrainingProgramExecutionData& data) {
-			_data = data;
+			_data = &data; // Not copied, since this happens on every frame
+			_text.update(data);
 		}
 
 	protected:
 		virtual RenderInfo getRenderInfo(const std::shared_ptr<GameWrapper>& gameWrapper) const = 0;
 
-		TrainingProgramExecutionData _data;
+		const TrainingProgramExecutionData* _data = nullptr;
+		OverlayText _text;
 	};
 }
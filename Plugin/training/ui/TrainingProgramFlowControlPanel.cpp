@@ -0,0 +1,310 @@
+#include <pch.h>
+#include "TrainingProgramFlowControlPanel.h"
+
+#include <external/IMGUI/imgui.h>
+#include <external/IMGUI/imgui_disable.h>
+#include <external/IMGUI/imgui_stdlib.h>
+
+namespace training
+{
+	std::string formatDuration(double milliseconds)
+	{
+		const auto duration = std::chrono::milliseconds((long long)milliseconds);
+		const auto hours = std::chrono::duration_cast<std::chrono::hours>(duration);
+		const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration - hours);
+		const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration - hours - minutes);
+		if (hours.count() > 0)
+		{
+			return fmt::format("{}h {}m", hours.count(), minutes.count());
+		}
+		return fmt::format("{}m {}s", minutes.count(), seconds.count());
+	}
+
+	TrainingProgramFlowControlPanel::TrainingProgramFlowControlPanel(
+		std::shared_ptr<TrainingProgramFlowControl> flowControl,
+		std::shared_ptr<settings::TrainingTimerSettings> trainingTimerSettings,
+		std::shared_ptr<statistics::TrainingStatistics> trainingStatistics)
+		: _flowControl{ std::move(flowControl) }
+		, _settings{ std::move(trainingTimerSettings) }
+		, _trainingStatistics{ std::move(trainingStatistics) }
+		, _preStepCommandsBuffer{ _settings->get<settings::PreStepCommandsSetting>() }
+	{
+		_settings->subscribe<settings::PreStepCommandsSetting>([this](const std::string& preStepCommands) { _preStepCommandsBuffer = preStepCommands; });
+	}
+
+	void TrainingProgramFlowControlPanel::renderOneFrame()
+	{
+		// TODO: An optimization would be to cache this and only update it whenever the list of training programs change
+		auto flowData = _flowControl->getCurrentFlowData();
+
+		static const char* selectedTrainingProgramName;
+		if (flowData.SelectedTrainingProgramIndex.has_value())
+		{
+			selectedTrainingProgramName = flowData.TrainingPrograms.at(flowData.SelectedTrainingProgramIndex.value()).Title.c_str();
+		}
+		else
+		{
+			selectedTrainingProgramName = "Choose a program";
+		}
+
+		if (ImGui::BeginCombo("Training Program", selectedTrainingProgramName))
+		{
+			ImGui::Disable disable_selection_if_necessary(!flowData.SwitchingIsPossible);
+			for (const auto& idAndTitle : flowData.TrainingPrograms)
+			{
+				const auto isSelected = flowData.SelectedTrainingProgramIndex.has_value() && flowData.TrainingPrograms.at(flowData.SelectedTrainingProgramIndex.value()).Id == idAndTitle.Id;
+				if (ImGui::Selectable(idAndTitle.Title.c_str(), isSelected))
+				{
+					try
+					{
+						_flowControl->selectTrainingProgram(idAndTitle.Id);
+					}
+					catch (const std::runtime_error& ex)
+					{
+						_exceptionMessages.emplace_back(ex.what());
+					}
+				}
+			}
+			ImGui::EndCombo();
+		}
+
+		for (const auto& missingWorkshopMap : flowData.MissingWorkshopMaps)
+		{
+			ImGui::TextColored(ImVec4{ 0.9f, .7f, .1f, 1.0f }, "Workshop map not found: %s", missingWorkshopMap.c_str()); // The path must not be used as a format string
+		}
+
+		addBarStyleDropdown();
+		addPreloadSettings();
+		addPreStepCommandsInput();
+
+		{
+			ImGui::Disable disable_start_if_necessary(!flowData.StartingIsPossible);
+			if (ImGui::Button("Start") && flowData.StartingIsPossible)
+			{
+				_exceptionMessages.clear();
+				try
+				{
+					_flowControl->startSelectedTrainingProgram();
+				}
+				catch (const std::runtime_error& ex)
+				{
+					_exceptionMessages.emplace_back(ex.what());
+				}
+			}
+		}
+		ImGui::SameLine();
+		{
+			ImGui::Disable disable_pause_if_necessary(!flowData.PausingIsPossible);
+			if (ImGui::Button("Pause") && flowData.PausingIsPossible)
+			{
+				try
+				{
+					_flowControl->pauseTrainingProgram();
+				}
+				catch (const std::runtime_error& ex)
+				{
+					_exceptionMessages.emplace_back(ex.what());
+				}
+			}
+		}
+		ImGui::SameLine();
+		{
+			ImGui::Disable disable_resume_if_necessary(!flowData.ResumingIsPossible);
+			if (ImGui::Button("Resume") && flowData.ResumingIsPossible)
+			{
+				try
+				{
+					_flowControl->resumeTrainingProgram();
+				}
+				catch (const std::runtime_error& ex)
+				{
+					_exceptionMessages.emplace_back(ex.what());
+				}
+			}
+		}
+		ImGui::SameLine();
+		{
+			ImGui::Disable disable_stop_if_necessary(!flowData.StoppingIsPossible);
+			if (ImGui::Button("Stop") && flowData.StoppingIsPossible)
+			{
+				try
+				{
+					_flowControl->stopRunningTrainingProgram();
+				}
+				catch (const std::runtime_error& ex)
+				{
+					_exceptionMessages.emplace_back(ex.what());
+				}
+			}
+		}
+
+		ImGui::SameLine();
+		{
+			ImGui::Disable disable_stop_if_necessary(!flowData.SkippingIsPossible);
+			if (ImGui::Button("Skip") && flowData.SkippingIsPossible)
+			{
+				try
+				{
+					_flowControl->skipTrainingProgramStep();
+				}
+				catch (const std::runtime_error& ex)
+				{
+					_exceptionMessages.emplace_back(ex.what());
+				}
+			}
+		}
+
+		addStatistics(flowData);
+
+		ImGui::Separator();
+
+		for (const auto& exceptionMessage : _exceptionMessages)
+		{
+			ImGui::TextColored(ImVec4{ 0.8f, .1f, .1f, 1.0f }, exceptionMessage.c_str());
+		}
+
+	}
+
+	bool TrainingProgramFlowControlPanel::addBarStyleDropdown()
+	{
+		const auto currentBarStyle = _settings->get<settings::BarStyleSetting>();
+		const char* currentBarStyleName = "";
+		for (const auto& entry : settings::BarStyleSetting::Values)
+		{
+			if (entry.Value == currentBarStyle) { currentBarStyleName = entry.Name; }
+		}
+
+		ImGui::PushItemWidth(200.0f);
+		auto changed = false;
+		if (ImGui::BeginCombo("##barstyle", currentBarStyleName))
+		{
+			for (const auto& entry : settings::BarStyleSetting::Values)
+			{
+				if (ImGui::Selectable(entry.Name, entry.Value == currentBarStyle))
+				{
+					_settings->set<settings::BarStyleSetting>(entry.Value);
+					changed = true;
+				}
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::PopItemWidth();
+		ImGui::SameLine();
+		ImGui::TextUnformatted("Bottom bar style");
+
+		return changed;
+	}
+
+	void TrainingProgramFlowControlPanel::addPreloadSettings()
+	{
+		auto preloadIsEnabled = _settings->get<settings::PreloadEnabledSetting>();
+		if (ImGui::Checkbox("Load the next map early", &preloadIsEnabled))
+		{
+			_settings->set<settings::PreloadEnabledSetting>(preloadIsEnabled);
+		}
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Loads the map of the next step shortly before the current step ends, so the next step can start right away.\n"
+				"Steps which require completing a pack are only announced, since loading them early would start the pack too soon.");
+		}
+
+		if (preloadIsEnabled)
+		{
+			auto leadTimeInSeconds = _settings->get<settings::PreloadLeadTimeSetting>();
+			ImGui::PushItemWidth(200.0f);
+			if (ImGui::SliderInt("Initial lead time [s]", &leadTimeInSeconds, settings::PreloadLeadTimeSetting::Minimum, settings::PreloadLeadTimeSetting::Maximum))
+			{
+				_settings->set<settings::PreloadLeadTimeSetting>(leadTimeInSeconds);
+			}
+			ImGui::PopItemWidth();
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("Used until the load time of a map has been measured. Measured load times replace this value for each map.");
+			}
+		}
+	}
+
+	void TrainingProgramFlowControlPanel::addPreStepCommandsInput()
+	{
+		ImGui::PushItemWidth(200.0f);
+		if (ImGui::InputText("Commands on every step", &_preStepCommandsBuffer, ImGuiInputTextFlags_EnterReturnsTrue))
+		{
+			_settings->set<settings::PreStepCommandsSetting>(_preStepCommandsBuffer);
+		}
+		ImGui::PopItemWidth();
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Console commands which are executed whenever a training step starts, separated by semicolons. Press Enter to apply.");
+		}
+	}
+
+	void TrainingProgramFlowControlPanel::addStatistics(const TrainingProgramFlowData& flowData)
+	{
+		if (_trainingStatistics == nullptr || !flowData.SelectedTrainingProgramIndex.has_value()) { return; }
+		if (!ImGui::CollapsingHeader("Statistics")) { return; }
+
+		const auto today = statistics::TrainingStatistics::toDay(
+			std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		const auto& trainingProgramId = flowData.TrainingPrograms.at(flowData.SelectedTrainingProgramIndex.value()).Id;
+		if (!_statisticsText.has_value()
+			|| _statisticsText->StatisticsRevision != _trainingStatistics->revision()
+			|| _statisticsText->TrainingProgramId != trainingProgramId
+			|| _statisticsText->Today != today
+			|| _statisticsText->StepNames != flowData.SelectedTrainingProgramStepNames)
+		{
+			updateStatisticsText(flowData, today);
+		}
+
+		for (const auto& line : _statisticsText->Lines)
+		{
+			ImGui::TextUnformatted(line.c_str());
+		}
+	}
+
+	void TrainingProgramFlowControlPanel::updateStatisticsText(const TrainingProgramFlowData& flowData, int64_t today)
+	{
+		auto& text = _statisticsText.emplace();
+		text.TrainingProgramId = flowData.TrainingPrograms.at(flowData.SelectedTrainingProgramIndex.value()).Id;
+		text.StatisticsRevision = _trainingStatistics->revision(); // Before reading, so changes made while reading cause another update
+		text.Today = today;
+		text.StepNames = flowData.SelectedTrainingProgramStepNames;
+
+		auto programStatistics = _trainingStatistics->getProgramStatistics(text.TrainingProgramId);
+		if (!programStatistics.has_value())
+		{
+			text.Lines.emplace_back("This program has not been started yet.");
+			return;
+		}
+
+		text.Lines.push_back(fmt::format("Time trained: {}", formatDuration((double)programStatistics->TimeTrainedInMilliseconds)));
+		text.Lines.push_back(fmt::format("Sessions: {} started, {} finished ({:.0f}%)",
+			programStatistics->SessionsStarted, programStatistics->SessionsFinished, programStatistics->completionRate() * 100.0));
+		text.Lines.push_back(fmt::format("Streak: {} days (longest: {} days)",
+			programStatistics->currentStreakInDays(today), programStatistics->LongestStreakInDays));
+
+		for (size_t stepNumber = 0; stepNumber < text.StepNames.size() && stepNumber < programStatistics->Steps.size(); stepNumber++)
+		{
+			const auto& stepStatistics = programStatistics->Steps[stepNumber];
+			if (stepStatistics.TimesStarted == 0) { continue; }
+
+			auto line = fmt::format("{}: {} trained, {:.0f}% skipped", text.StepNames[stepNumber],
+				formatDuration((double)stepStatistics.TimeTrainedInMilliseconds), stepStatistics.skipFrequency() * 100.0);
+			if (stepStatistics.PacksCompleted > 0)
+			{
+				line += fmt::format(", pack completed in {} on average ({} median)",
+					formatDuration(stepStatistics.averagePackCompletionTime()), formatDuration(stepStatistics.medianPackCompletionTime()));
+			}
+			text.Lines.push_back(std::move(line));
+		}
+	}
+
+	void TrainingProgramFlowControlPanel::addErrorMessage(std::string errorMessage)
+	{
+		_exceptionMessages.push_back(std::move(errorMessage));
+	}
+
+	void TrainingProgramFlowControlPanel::clearErrorMessages()
+	{
+		_exceptionMessages.clear();
+	}
+}
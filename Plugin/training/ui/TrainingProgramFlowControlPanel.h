@@ -0,0 +1,65 @@
+#pragma once
+
+#include <DLLImportExport.h>
+
+#include "../control/TrainingProgramFlowControl.h"
+#include "../../statistics/TrainingStatistics.h"
+#include "../../settings/TrainingTimerSettings.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace training
+{
+	/**
+	 * The job of this class is to render the contents of the training window: program selection, flow buttons, settings and statistics.
+	 * Settings are read and written through the settings registry, which keeps the cvars up to date.
+	 *
+	 * This does not need the game, so the window can be rendered by benchmarks as well.
+	 */
+	class RLTT_IMPORT_EXPORT TrainingProgramFlowControlPanel
+	{
+	public:
+		/** Constructor. Statistics are optional. */
+		TrainingProgramFlowControlPanel(
+			std::shared_ptr<TrainingProgramFlowControl> flowControl,
+			std::shared_ptr<settings::TrainingTimerSettings> trainingTimerSettings,
+			std::shared_ptr<statistics::TrainingStatistics> trainingStatistics
+		);
+
+		/** Renders the contents of the window. Must be called between ImGui::Begin() and ImGui::End(). */
+		void renderOneFrame();
+
+		/** Displays an error below the controls until the next program gets started. */
+		void addErrorMessage(std::string errorMessage);
+
+		/** Removes all error messages. */
+		void clearErrorMessages();
+
+	private:
+		/** The formatted statistics of the selected program, and what they were formatted from. */
+		struct StatisticsText
+		{
+			std::string TrainingProgramId;
+			uint64_t StatisticsRevision = 0;
+			int64_t Today = 0;
+			std::vector<std::string> StepNames;
+			std::vector<std::string> Lines;
+		};
+
+		bool addBarStyleDropdown();
+		void addPreloadSettings();
+		void addPreStepCommandsInput();
+		void addStatistics(const TrainingProgramFlowData& flowData);
+		void updateStatisticsText(const TrainingProgramFlowData& flowData, int64_t today);
+
+		std::vector<std::string> _exceptionMessages;
+		std::shared_ptr<TrainingProgramFlowControl> _flowControl;
+		std::shared_ptr<settings::TrainingTimerSettings> _settings;
+		std::shared_ptr<statistics::TrainingStatistics> _trainingStatistics;
+		std::optional<StatisticsText> _statisticsText; // Formatting every frame would be a waste, since statistics only change when a step ends
+		std::string _preStepCommandsBuffer; // Edited by the input field. Only refreshed when the setting changes, so the commands are not copied every frame
+	};
+}
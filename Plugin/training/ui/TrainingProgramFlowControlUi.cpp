@@ -1,62 +1,86 @@
 #include <pch.h>
 #include "TrainingProgramFlowControlUi.h"
+#include "../control/CVarManagerAdapter.h"
+#include <diagnostics/PerformanceCounters.h>
 
 #include <external/IMGUI/imgui.h>
-#include <external/IMGUI/imgui_disable.h>
 
-#define RLTRAININGTIMER_CVAR_BARSTYLE "RLTrainingTimer_barstyle"
+#include <sstream>
 
 namespace training
 {
-	const std::string BlueBarStyleName = "blue bar (more visible)";
-	const std::string MinimalStyleName = "minimal (less annoying)";
-	const std::string HiddenStyleName = "none (hide)";
-
 	void TrainingProgramFlowControlUi::initTrainingProgramFlowControlUi(
 		std::shared_ptr<GameWrapper> gameWrapper,
 		std::shared_ptr<TrainingProgramFlowControl> flowControl,
 		std::shared_ptr<CVarManagerWrapper> cvarManager,
-		std::shared_ptr<PersistentStorage> persistentStorage)
+		std::shared_ptr<PersistentStorage> persistentStorage,
+		std::shared_ptr<statistics::TrainingStatistics> trainingStatistics)
 	{
 		_flowControl = flowControl;
 		_cvarManager = std::move(cvarManager);
 		_persistentStorage = std::move(persistentStorage);
-		auto cvar = _persistentStorage->RegisterPersistentCvar(
-			RLTRAININGTIMER_CVAR_BARSTYLE, 
-			"minimal", 
-			fmt::format("Bottom bar style [{}, {}, {}]", BlueBarStyleName, MinimalStyleName, HiddenStyleName).c_str()
-		);
-		cvar.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
-            auto str = cvar.getStringValue();
-			if(str == BlueBarStyleName) {
-				_barStyle = BarStyle::BlueBar;
-			} else if(str == MinimalStyleName) {
-				_barStyle = BarStyle::Minimal;
-			} else if(str == HiddenStyleName) {
-				_barStyle = BarStyle::None;
-			} else {
-				LOG("Unknown barstyle '{}'", str);
-				_barStyle = BarStyle::None;
+		auto cvarManagerAdapter = std::make_shared<CVarManagerAdapter>(_cvarManager);
+		_settings = std::make_shared<settings::TrainingTimerSettings>(cvarManagerAdapter);
+		_panel = std::make_shared<TrainingProgramFlowControlPanel>(flowControl, _settings, std::move(trainingStatistics));
+
+		// Register a persistent cvar for every typed setting. Their text only gets parsed when they change.
+		settings::TrainingTimerSettings::forEachSetting([this](auto setting) {
+			using Setting = decltype(setting);
+			using ValueType = typename Setting::ValueType;
+			auto hasRange = false;
+			float minimum = 0, maximum = 0;
+			if constexpr (std::is_same_v<ValueType, bool>)
+			{
+				hasRange = true;
+				maximum = 1;
+			}
+			else if constexpr (std::is_same_v<ValueType, int> || std::is_same_v<ValueType, float>)
+			{
+				hasRange = true;
+				minimum = (float)Setting::Minimum;
+				maximum = (float)Setting::Maximum;
 			}
-        });
+			auto cvar = _persistentStorage->RegisterPersistentCvar(
+				Setting::CvarName,
+				settings::TrainingTimerSettings::formatValue<Setting>(Setting::DefaultValue),
+				Setting::Description,
+				true, hasRange, minimum, hasRange, maximum
+			);
+			cvar.addOnValueChanged([this](std::string, CVarWrapper cvar) {
+				if (!_settings->receiveCvarValue<Setting>(cvar.getStringValue()))
+				{
+					LOG("Ignoring invalid value '{}' of {}", cvar.getStringValue(), Setting::CvarName);
+				}
+			});
+		});
+		_settings->loadFromCvars();
+
+		_settings->subscribe<settings::PreloadEnabledSetting>([this](bool) { applyPreloadSettings(); });
+		_settings->subscribe<settings::PreloadLeadTimeSetting>([this](int) { applyPreloadSettings(); });
+		applyPreloadSettings();
+
+		_settings->subscribe<settings::PreStepCommandsSetting>([this](const std::string&) { applyPreStepCommands(); });
+		applyPreStepCommands();
 
 		gameWrapper->RegisterDrawable([this, gameWrapper](const CanvasWrapper& canvasWrapper) {
-			if(_barStyle == BarStyle::BlueBar) {
+			const auto barStyle = _settings->get<settings::BarStyleSetting>();
+			if(barStyle == settings::BarStyle::BlueBar) {
 				_BlueBarDisplay->renderOneFrame(gameWrapper, canvasWrapper, _flowControl->getCurrentExecutionData());
-			} else if(_barStyle == BarStyle::Minimal) {
+			} else if(barStyle == settings::BarStyle::Minimal) {
 				_MinimalDisplay->renderOneFrame(gameWrapper, canvasWrapper, _flowControl->getCurrentExecutionData());
 			}
 		});
 	}
 	void TrainingProgramFlowControlUi::Render()
 	{
+		RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::TrainingWindowRender);
 		if (!_isWindowOpen)
 		{
 			toggleMenu();
 			return;
 		}
 
-		if (_flowControl == nullptr)
+		if (_panel == nullptr)
 		{
 			return;
 		}
@@ -73,7 +97,7 @@ namespace training
 		}
 
 		// Render data
-		renderOneFrame();
+		_panel->renderOneFrame();
 
 		// End GUI
 		_shouldBlockInput = ImGui::GetIO().WantCaptureMouse || ImGui::GetIO().WantCaptureKeyboard;
@@ -111,156 +135,28 @@ namespace training
 	{
 		_globalCvarManager->executeCommand("togglemenu " + GetMenuName());
 	}
-	void TrainingProgramFlowControlUi::renderOneFrame()
+	void TrainingProgramFlowControlUi::applyPreloadSettings()
 	{
-		// TODO: An optimization would be to cache this and only update it whenever the list of training programs change
-		auto flowData = _flowControl->getCurrentFlowData();
-
-		static const char* selectedTrainingProgramName;
-		if (flowData.SelectedTrainingProgramIndex.has_value())
-		{
-			selectedTrainingProgramName = flowData.TrainingPrograms.at(flowData.SelectedTrainingProgramIndex.value()).Title.c_str();
-		}
-		else
-		{
-			selectedTrainingProgramName = "Choose a program";
-		}
-
-		if (ImGui::BeginCombo("Training Program", selectedTrainingProgramName))
-		{
-			ImGui::Disable disable_selection_if_necessary(!flowData.SwitchingIsPossible);
-			for (const auto& idAndTitle : flowData.TrainingPrograms)
-			{
-				const auto isSelected = flowData.SelectedTrainingProgramIndex.has_value() && flowData.TrainingPrograms.at(flowData.SelectedTrainingProgramIndex.value()).Id == idAndTitle.Id;
-				if (ImGui::Selectable(idAndTitle.Title.c_str(), isSelected))
-				{
-					try
-					{
-						_flowControl->selectTrainingProgram(idAndTitle.Id);
-					}
-					catch (const std::runtime_error& ex)
-					{
-						_exceptionMessages.emplace_back(ex.what());
-					}
-				}
-			}
-			ImGui::EndCombo();
-		}
-
-		addBarStyleDropdown();
-
-		{
-			ImGui::Disable disable_start_if_necessary(!flowData.StartingIsPossible);
-			if (ImGui::Button("Start") && flowData.StartingIsPossible)
-			{
-				_exceptionMessages.clear();
-				try
-				{
-					_flowControl->startSelectedTrainingProgram();
-				}
-				catch (const std::runtime_error& ex)
-				{
-					_exceptionMessages.emplace_back(ex.what());
-				}
-			}
-		}
-		ImGui::SameLine();
-		{
-			ImGui::Disable disable_pause_if_necessary(!flowData.PausingIsPossible);
-			if (ImGui::Button("Pause") && flowData.PausingIsPossible)
-			{
-				try
-				{
-					_flowControl->pauseTrainingProgram();
-				}
-				catch (const std::runtime_error& ex)
-				{
-					_exceptionMessages.emplace_back(ex.what());
-				}
-			}
-		}
-		ImGui::SameLine();
-		{
-			ImGui::Disable disable_resume_if_necessary(!flowData.ResumingIsPossible);
-			if (ImGui::Button("Resume") && flowData.ResumingIsPossible)
-			{
-				try
-				{
-					_flowControl->resumeTrainingProgram();
-				}
-				catch (const std::runtime_error& ex)
-				{
-					_exceptionMessages.emplace_back(ex.what());
-				}
-			}
-		}
-		ImGui::SameLine();
-		{
-			ImGui::Disable disable_stop_if_necessary(!flowData.StoppingIsPossible);
-			if (ImGui::Button("Stop") && flowData.StoppingIsPossible)
-			{
-				try
-				{
-					_flowControl->stopRunningTrainingProgram();
-				}
-				catch (const std::runtime_error& ex)
-				{
-					_exceptionMessages.emplace_back(ex.what());
-				}
-			}
-		}
-
-		ImGui::SameLine();
-		{
-			ImGui::Disable disable_stop_if_necessary(!flowData.SkippingIsPossible);
-			if (ImGui::Button("Skip") && flowData.SkippingIsPossible)
-			{
-				try
-				{
-					_flowControl->activateNextTrainingProgramStep();
-				}
-				catch (const std::runtime_error& ex)
-				{
-					_exceptionMessages.emplace_back(ex.what());
-				}
-			}
-		}
-
-		ImGui::Separator();
-
-		for (const auto& exceptionMessage : _exceptionMessages)
-		{
-			ImGui::TextColored(ImVec4{ 0.8f, .1f, .1f, 1.0f }, exceptionMessage.c_str());
-		}
-
+		_flowControl->setPreloadSettings(
+			_settings->get<settings::PreloadEnabledSetting>(),
+			std::chrono::seconds(_settings->get<settings::PreloadLeadTimeSetting>())
+		);
 	}
 
-	bool TrainingProgramFlowControlUi::addBarStyleDropdown()
+	void TrainingProgramFlowControlUi::applyPreStepCommands()
 	{
-		std::vector<std::string> enumNames = { MinimalStyleName, BlueBarStyleName, HiddenStyleName };
-		auto cvar = _cvarManager->getCvar(RLTRAININGTIMER_CVAR_BARSTYLE);
-		std::string currentBarStyle = cvar.getStringValue();
-		
-		ImGui::PushItemWidth(200.0f);
-		auto changed = false;
-		if (ImGui::BeginCombo("##barstyle", currentBarStyle.c_str()))
+		std::vector<std::string> preStepCommands;
+		std::istringstream stream(_settings->get<settings::PreStepCommandsSetting>());
+		std::string command;
+		while (std::getline(stream, command, ';'))
 		{
-			for (const auto& name : enumNames)
+			const auto start = command.find_first_not_of(" \t");
+			if (start != std::string::npos)
 			{
-				const auto isSelected = name == currentBarStyle;
-				if (ImGui::Selectable(name.c_str(), isSelected))
-				{
-					cvar.setValue(name);
-					changed = true;
-				}
+				preStepCommands.push_back(command.substr(start, command.find_last_not_of(" \t") - start + 1));
 			}
-			ImGui::EndCombo();
 		}
-		ImGui::PopItemWidth();
-		ImGui::SameLine();
-		ImGui::TextUnformatted("Bottom bar style");
-
-		return changed;
+		_flowControl->setPreStepCommands(std::move(preStepCommands));
 	}
 
 	void TrainingProgramFlowControlUi::displayErrorMessage(const std::string& shortText, const std::string& errorDescription)
@@ -269,12 +165,18 @@ namespace training
 		{
 			toggleMenu();
 		}
-		_exceptionMessages.emplace_back(fmt::format("{}: {}", shortText, errorDescription));
+		if (_panel != nullptr)
+		{
+			_panel->addErrorMessage(fmt::format("{}: {}", shortText, errorDescription));
+		}
 		LOG("Error occured: {} ({})", shortText, errorDescription);
 	}
 
 	void TrainingProgramFlowControlUi::clearErrorMessages()
 	{
-		_exceptionMessages.clear();
+		if (_panel != nullptr)
+		{
+			_panel->clearErrorMessages();
+		}
 	}
 }
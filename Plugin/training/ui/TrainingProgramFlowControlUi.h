@@ -4,6 +4,7 @@
 #include "TrainingProgramDisplay/BlueBarDisplay.h"
 #include "TrainingProgramDisplay/MinimalDisplay.h"
 #include "IErrorDisplay.h"
+#include "TrainingProgramFlowControlPanel.h"
 
 #include <bakkesmod/plugin/pluginwindow.h>
 #include <bakkesmod/wrappers/gamewrapper.h>
@@ -28,7 +29,8 @@ namespace training
 			std::shared_ptr<GameWrapper> gameWrapper, 
 			std::shared_ptr<TrainingProgramFlowControl> flowControl,
 			std::shared_ptr<CVarManagerWrapper> cvarManager,
-			std::shared_ptr<PersistentStorage> persistentStorage
+			std::shared_ptr<PersistentStorage> persistentStorage,
+			std::shared_ptr<statistics::TrainingStatistics> trainingStatistics
 		);
 
 		// Inherited via PluginWindow
@@ -46,24 +48,19 @@ namespace training
 		virtual void clearErrorMessages() override;
 		
 	private:
-		void renderOneFrame();
 		void toggleMenu();
 
 		bool _shouldBlockInput = false;
 		bool _isWindowOpen = false;
 
-		enum class BarStyle {
-			BlueBar,
-			Minimal,
-			None
-		};
-		BarStyle _barStyle = BarStyle::Minimal;
-		bool addBarStyleDropdown();
+		void applyPreloadSettings();
+		void applyPreStepCommands();
 
-		std::vector<std::string> _exceptionMessages;
 		std::shared_ptr<PersistentStorage> _persistentStorage;
 		std::shared_ptr<CVarManagerWrapper> _cvarManager;
+		std::shared_ptr<settings::TrainingTimerSettings> _settings; // The bar style is read on every frame, so it must not be parsed from the cvar each time
 		std::shared_ptr<TrainingProgramFlowControl> _flowControl = nullptr;
+		std::shared_ptr<TrainingProgramFlowControlPanel> _panel = nullptr; // Renders the contents of the window
 		std::shared_ptr<TrainingProgramDisplay> _BlueBarDisplay = std::make_shared<BlueBarDisplay>();
 		std::shared_ptr<TrainingProgramDisplay> _MinimalDisplay = std::make_shared<MinimalDisplay>();
 	};
@@ -0,0 +1,4 @@
+#include <pch.h>
+
+// Defined by the plugin class in the actual DLL. It stays empty here, so LOG() does nothing.
+std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
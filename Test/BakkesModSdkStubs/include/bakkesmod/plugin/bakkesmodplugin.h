@@ -0,0 +1,7 @@
+#pragma once
+
+// Minimal stand-in for the BakkesMod SDK header of the same name, so the core library can be built without the SDK (see CMakeLists.txt).
+// The plugin class itself is Windows-only, so this only provides the wrappers which the precompiled header expects.
+
+#include "../wrappers/cvarmanagerwrapper.h"
+#include "../wrappers/gamewrapper.h"
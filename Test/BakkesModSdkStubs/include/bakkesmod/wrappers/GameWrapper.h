@@ -0,0 +1,4 @@
+#pragma once
+
+// The SDK gets included with both spellings, which only makes a difference outside of Windows
+#include "gamewrapper.h"
@@ -0,0 +1,36 @@
+#pragma once
+
+// Minimal stand-in for the BakkesMod SDK header of the same name, so the core library can be built without the SDK (see CMakeLists.txt).
+// Only what the core library uses is declared. Nothing in here talks to a game: cvars don't exist and commands go nowhere.
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#define PERMISSION_ALL 0
+
+/** A cvar which does not exist. */
+class CVarWrapper
+{
+public:
+	explicit operator bool() const { return false; }
+	bool IsNull() const { return true; }
+
+	std::string getStringValue() const { return std::string(); }
+	bool getBoolValue() const { return false; }
+	int getIntValue() const { return 0; }
+	float getFloatValue() const { return 0.0f; }
+	void setValue(const std::string&) {}
+	void setValue(int) {}
+	void setValue(float) {}
+};
+
+/** A cvar manager which ignores everything. */
+class CVarManagerWrapper
+{
+public:
+	void executeCommand(const std::string&, bool = true) {}
+	void registerNotifier(const std::string&, std::function<void(std::vector<std::string>)>, const std::string&, unsigned char) {}
+	CVarWrapper getCvar(const std::string&) { return CVarWrapper(); }
+	void log(const std::string&) {}
+};
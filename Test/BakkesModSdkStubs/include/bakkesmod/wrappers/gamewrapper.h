@@ -0,0 +1,20 @@
+#pragma once
+
+// Minimal stand-in for the BakkesMod SDK header of the same name, so the core library can be built without the SDK (see CMakeLists.txt).
+// Only what the core library uses is declared. There is no game, so events never fire and nothing is paused.
+
+#include <filesystem>
+#include <functional>
+#include <string>
+
+/** A game wrapper without a game. */
+class GameWrapper
+{
+public:
+	void HookEvent(const std::string&, std::function<void(std::string)>) {}
+	void HookEventPost(const std::string&, std::function<void(std::string)>) {}
+	void Execute(const std::function<void(GameWrapper*)>& theLambda) { theLambda(this); }
+	bool IsPaused() { return false; }
+	bool IsInFreeplay() { return false; }
+	std::filesystem::path GetDataFolder() { return std::filesystem::temp_directory_path(); }
+};
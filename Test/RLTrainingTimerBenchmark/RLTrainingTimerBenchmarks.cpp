@@ -0,0 +1,7 @@
+// RLTrainingTimerBenchmarks.cpp : Contains the 'main' function of the benchmarks. The benchmarks themselves are in the "benchmarks" folder.
+//
+// Run with --benchmark_format=json --benchmark_out=<file> in order to compare results between builds.
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <Plugin/training/control/TrainingProgramFlowControl.h>
+#include <Test/RLTrainingTimerTest/fakes/FakeGameWrapper.h>
+#include <Test/RLTrainingTimerTest/fakes/FakeTimeProvider.h>
+
+#include "NullCVarManager.h"
+#include "SyntheticTrainingPrograms.h"
+
+namespace
+{
+	const std::string TrainingProgramId = "{0D6A4C2B-3E1F-4B8A-9C7D-5E2F1A0B3C4D}";
+	const std::string TimerTickEventName = "Function TAGame.Replay_TA.Tick";
+
+	/** A flow control which only knows fakes, with a synthetic program of the given number of steps. */
+	struct FlowControlSetup
+	{
+	public:
+		explicit FlowControlSetup(int64_t numberOfSteps, const std::chrono::milliseconds& stepDuration = std::chrono::hours(24))
+			: TrainingProgramList{ synthetic::createTrainingProgramList(synthetic::createTrainingProgram(TrainingProgramId, (size_t)numberOfSteps, stepDuration)) }
+		{
+			FlowControl.hookToEvents();
+			FlowControl.receiveListData(TrainingProgramList);
+			FlowControl.selectTrainingProgram(TrainingProgramId);
+		}
+
+		configuration::TrainingProgramListData TrainingProgramList;
+		std::shared_ptr<FakeGameWrapper> GameWrapper = std::make_shared<FakeGameWrapper>();
+		std::shared_ptr<FakeTimeProvider> TimeProvider = std::make_shared<FakeTimeProvider>();
+		std::shared_ptr<NullCVarManager> CVarManager = std::make_shared<NullCVarManager>();
+		training::TrainingProgramFlowControl FlowControl{ GameWrapper, TimeProvider, CVarManager };
+	};
+
+	/** Measures a timer tick while a step is running, the way the game sends it (i.e. through the hooked callback). This happens on every frame. */
+	void FlowControl_TimerTick(benchmark::State& state)
+	{
+		auto setup = FlowControlSetup(state.range(0));
+		setup.FlowControl.startSelectedTrainingProgram();
+		const auto& tick = setup.GameWrapper->FakeEventMap.at(TimerTickEventName);
+		for (auto _ : state)
+		{
+			setup.TimeProvider->CurrentFakeTime += std::chrono::milliseconds(1);
+			tick(TimerTickEventName);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(FlowControl_TimerTick)->RangeMultiplier(10)->Range(1, 10000);
+
+	/** Measures switching steps by running through the whole program, so every kind of step gets activated. */
+	void FlowControl_ActivateNextTrainingProgramStep(benchmark::State& state)
+	{
+		auto setup = FlowControlSetup(state.range(0));
+		for (auto _ : state)
+		{
+			setup.FlowControl.startSelectedTrainingProgram(); // Activates the first step
+			for (int64_t stepNumber = 1; stepNumber < state.range(0); stepNumber++)
+			{
+				setup.FlowControl.activateNextTrainingProgramStep();
+			}
+			setup.FlowControl.stopRunningTrainingProgram();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(FlowControl_ActivateNextTrainingProgramStep)->RangeMultiplier(10)->Range(1, 10000);
+
+	/** Measures pausing and resuming the running program (two operations per iteration). */
+	void FlowControl_PauseAndResume(benchmark::State& state)
+	{
+		auto setup = FlowControlSetup(state.range(0));
+		setup.FlowControl.startSelectedTrainingProgram();
+		for (auto _ : state)
+		{
+			setup.TimeProvider->CurrentFakeTime += std::chrono::milliseconds(1);
+			setup.FlowControl.pauseTrainingProgram();
+			setup.TimeProvider->CurrentFakeTime += std::chrono::milliseconds(1);
+			setup.FlowControl.resumeTrainingProgram();
+		}
+		state.SetItemsProcessed(state.iterations() * 2);
+	}
+	BENCHMARK(FlowControl_PauseAndResume)->RangeMultiplier(10)->Range(1, 10000);
+
+	/** Measures receiving a changed training program list, which happens whenever the player edits any program. */
+	void FlowControl_ReceiveListData(benchmark::State& state)
+	{
+		auto setup = FlowControlSetup(state.range(0));
+		for (auto _ : state)
+		{
+			setup.FlowControl.receiveListData(setup.TrainingProgramList);
+		}
+		state.SetItemsProcessed(state.iterations());
+		state.SetComplexityN(state.range(0));
+	}
+	BENCHMARK(FlowControl_ReceiveListData)->RangeMultiplier(10)->Range(1, 10000)->Complexity();
+}
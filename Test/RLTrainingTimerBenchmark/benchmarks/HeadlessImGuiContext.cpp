@@ -0,0 +1,53 @@
+#include "HeadlessImGuiContext.h"
+
+#include <Plugin/external/IMGUI/imgui.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// ImGui uses malloc by default, which would bypass an operator new which counts allocations
+	void* allocateThroughOperatorNew(size_t size, void*) { return ::operator new(size); }
+	void freeThroughOperatorDelete(void* memory, void*) { ::operator delete(memory); }
+
+	void* allocateThroughMalloc(size_t size, void*) { return std::malloc(size); }
+	void freeThroughFree(void* memory, void*) { std::free(memory); }
+}
+
+HeadlessImGuiContext::HeadlessImGuiContext()
+{
+	ImGui::SetAllocatorFunctions(allocateThroughOperatorNew, freeThroughOperatorDelete);
+	_context = ImGui::CreateContext();
+	ImGui::SetCurrentContext(_context);
+
+	auto& io = ImGui::GetIO();
+	io.IniFilename = nullptr; // Window positions must not be stored anywhere
+	io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+	io.DeltaTime = 1.0f / 60.0f;
+
+	// The font atlas must have been built before the first frame. The texture itself is never used.
+	unsigned char* pixels = nullptr;
+	int width = 0;
+	int height = 0;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+HeadlessImGuiContext::~HeadlessImGuiContext()
+{
+	ImGui::DestroyContext(_context);
+	ImGui::SetAllocatorFunctions(allocateThroughMalloc, freeThroughFree);
+}
+
+void HeadlessImGuiContext::renderFrame(const std::function<void()>& drawWindowContents)
+{
+	ImGui::SetCurrentContext(_context);
+
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+	ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+	ImGui::Begin("Headless");
+	drawWindowContents();
+	ImGui::End();
+	ImGui::Render();
+}
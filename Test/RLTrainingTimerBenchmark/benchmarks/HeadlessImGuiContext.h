@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+struct ImGuiContext;
+
+/**
+ * The job of this class is to render ImGui frames without a game, a window or a graphics device, so UI code can be measured by benchmarks.
+ * Frames are laid out and their draw lists get built, but nothing gets drawn.
+ *
+ * This changes ImGui's allocator functions and its current context, which are global, so it only exists in the benchmarks and only one instance may exist at a time.
+ * It has to drive the same ImGui as the UI code. On Windows, ImGui is compiled into the plugin DLL and not exported, so the UI benchmarks only exist in the CMake build.
+ * ImGui allocates through operator new while this exists, so counting allocations includes ImGui's own ones.
+ */
+class HeadlessImGuiContext
+{
+public:
+	/** Creates an ImGui context with a fixed display size and the default font. */
+	HeadlessImGuiContext();
+	/** Destroys the ImGui context. */
+	~HeadlessImGuiContext();
+
+	HeadlessImGuiContext(const HeadlessImGuiContext&) = delete;
+	HeadlessImGuiContext& operator=(const HeadlessImGuiContext&) = delete;
+
+	/** Renders a frame with a single window and lets the given function fill it. */
+	void renderFrame(const std::function<void()>& drawWindowContents);
+
+private:
+	ImGuiContext* _context = nullptr;
+};
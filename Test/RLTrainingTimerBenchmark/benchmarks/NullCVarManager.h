@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Plugin/training/control/ICVarManager.h>
+
+#include <string>
+#include <unordered_map>
+
+/**
+ * A cvar manager which discards every command, so benchmarks which run millions of iterations don't measure a growing list of commands.
+ * Cvar values are kept, since there is only a fixed number of them.
+ */
+class NullCVarManager : public ICVarManager
+{
+public:
+	NullCVarManager() = default;
+
+	void executeCommand(std::string, bool) override {}
+	void executeBatch(const CommandBatch&) override {}
+
+	std::string getCvarValue(const std::string& cvarName) override
+	{
+		auto iter = _cvarValues.find(cvarName);
+		return iter == _cvarValues.end() ? std::string() : iter->second;
+	}
+
+	void setCvarValue(const std::string& cvarName, const std::string& value) override
+	{
+		_cvarValues[cvarName] = value;
+	}
+
+private:
+	std::unordered_map<std::string, std::string> _cvarValues;
+};
@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+#include <Plugin/configuration/control/TrainingProgramRepository.h>
+
+#include "SyntheticTrainingPrograms.h"
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+	/** A temporary folder which gets removed along with everything in it. */
+	struct TemporaryFolder
+	{
+	public:
+		TemporaryFolder()
+			: Path{ std::filesystem::temp_directory_path() / ("RLTrainingTimerBenchmark_" + std::to_string(std::random_device()())) }
+		{
+			std::filesystem::create_directories(Path);
+		}
+		~TemporaryFolder()
+		{
+			std::filesystem::remove_all(Path);
+		}
+
+		std::filesystem::path Path;
+	};
+
+	/** Measures every iteration on its own, so latency percentiles can be reported next to the mean which google benchmark reports anyway. */
+	class LatencyRecorder
+	{
+	public:
+		explicit LatencyRecorder(benchmark::State& state)
+			: _state{ state }
+		{
+		}
+
+		template <typename Function>
+		void measure(Function&& function)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			function();
+			const auto latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+			_state.SetIterationTime(latency.count());
+			_latenciesInMicroseconds.push_back(latency.count() * 1e6);
+		}
+
+		/** Adds the p50, p90 and p99 latencies in microseconds as counters. */
+		void reportPercentiles()
+		{
+			if (_latenciesInMicroseconds.empty()) { return; }
+			std::sort(_latenciesInMicroseconds.begin(), _latenciesInMicroseconds.end());
+			for (const auto& [name, percentile] : { std::make_pair("p50_us", 0.5), std::make_pair("p90_us", 0.9), std::make_pair("p99_us", 0.99) })
+			{
+				const auto index = std::min(_latenciesInMicroseconds.size() - 1, (size_t)(percentile * _latenciesInMicroseconds.size()));
+				_state.counters[name] = _latenciesInMicroseconds[index];
+			}
+		}
+
+	private:
+		benchmark::State& _state;
+		std::vector<double> _latenciesInMicroseconds;
+	};
+
+	/** Reports the size of the given file, and the throughput based on it. */
+	void reportFileSize(benchmark::State& state, const std::filesystem::path& path)
+	{
+		const auto fileSize = std::filesystem::file_size(path);
+		state.counters["FileSizeBytes"] = (double)fileSize;
+		state.SetBytesProcessed((int64_t)(state.iterations() * fileSize));
+	}
+
+	/** A library with the given number of programs, with 3 to 20 steps each. */
+	configuration::TrainingProgramListData createLibrary(int64_t numberOfPrograms)
+	{
+		auto options = synthetic::LibraryOptions();
+		options.NumberOfPrograms = (size_t)numberOfPrograms;
+		return synthetic::createTrainingProgramLibrary(options);
+	}
+
+	/** A single program with the given number of steps. */
+	configuration::TrainingProgramData createSingleProgram(int64_t numberOfSteps)
+	{
+		auto options = synthetic::LibraryOptions();
+		options.NumberOfPrograms = 1;
+		options.MinimumNumberOfSteps = (size_t)numberOfSteps;
+		options.MaximumNumberOfSteps = (size_t)numberOfSteps;
+		auto library = synthetic::createTrainingProgramLibrary(options);
+		return std::move(library.TrainingProgramData.begin()->second);
+	}
+
+	/** Measures storing the whole library at a given location, which happens synchronously (e.g. "Export All"). */
+	void Repository_StoreData(benchmark::State& state)
+	{
+		const auto folder = TemporaryFolder();
+		const auto path = folder.Path / "trainingprograms.json";
+		auto repository = configuration::TrainingProgramRepository(folder.Path / "default.json");
+		const auto library = createLibrary(state.range(0));
+		auto latencies = LatencyRecorder(state);
+		for (auto _ : state)
+		{
+			latencies.measure([&]() { repository.storeData(library, path.string()); });
+		}
+		latencies.reportPercentiles();
+		reportFileSize(state, path);
+	}
+	BENCHMARK(Repository_StoreData)->RangeMultiplier(10)->Range(10, 1000)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+	/** Measures storing the whole library at the default location until it is on disk. The game thread only waits for handing the data over. */
+	void Repository_StoreDataInBackground(benchmark::State& state)
+	{
+		const auto folder = TemporaryFolder();
+		const auto path = folder.Path / "default.json";
+		auto repository = configuration::TrainingProgramRepository(path);
+		const auto library = createLibrary(state.range(0));
+		auto latencies = LatencyRecorder(state);
+		for (auto _ : state)
+		{
+			latencies.measure([&]() {
+				repository.storeData(library);
+				repository.flush();
+			});
+		}
+		latencies.reportPercentiles();
+		reportFileSize(state, path);
+	}
+	BENCHMARK(Repository_StoreDataInBackground)->RangeMultiplier(10)->Range(10, 1000)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+	/** Measures restoring the whole library, which happens whenever the plugin gets loaded. */
+	void Repository_RestoreData(benchmark::State& state)
+	{
+		const auto folder = TemporaryFolder();
+		const auto path = folder.Path / "trainingprograms.json";
+		auto repository = configuration::TrainingProgramRepository(folder.Path / "default.json");
+		repository.storeData(createLibrary(state.range(0)), path.string());
+		auto latencies = LatencyRecorder(state);
+		for (auto _ : state)
+		{
+			latencies.measure([&]() { benchmark::DoNotOptimize(repository.restoreData(path.string())); });
+		}
+		latencies.reportPercentiles();
+		reportFileSize(state, path);
+	}
+	BENCHMARK(Repository_RestoreData)->RangeMultiplier(10)->Range(10, 1000)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+	/** Measures exporting a single program with the given number of steps. */
+	void Repository_ExportSingleTrainingProgram(benchmark::State& state)
+	{
+		const auto folder = TemporaryFolder();
+		const auto path = folder.Path / "program.json";
+		auto repository = configuration::TrainingProgramRepository(folder.Path / "default.json");
+		const auto trainingProgram = createSingleProgram(state.range(0));
+		auto latencies = LatencyRecorder(state);
+		for (auto _ : state)
+		{
+			latencies.measure([&]() { repository.exportSingleTrainingProgram(trainingProgram, path.string()); });
+		}
+		latencies.reportPercentiles();
+		reportFileSize(state, path);
+	}
+	BENCHMARK(Repository_ExportSingleTrainingProgram)->RangeMultiplier(10)->Range(10, 1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+	/** Measures importing a single program with the given number of steps. */
+	void Repository_ImportSingleTrainingProgram(benchmark::State& state)
+	{
+		const auto folder = TemporaryFolder();
+		const auto path = folder.Path / "program.json";
+		auto repository = configuration::TrainingProgramRepository(folder.Path / "default.json");
+		repository.exportSingleTrainingProgram(createSingleProgram(state.range(0)), path.string());
+		auto latencies = LatencyRecorder(state);
+		for (auto _ : state)
+		{
+			latencies.measure([&]() { benchmark::DoNotOptimize(repository.importSingleTrainingProgram(path.string())); });
+		}
+		latencies.reportPercentiles();
+		reportFileSize(state, path);
+	}
+	BENCHMARK(Repository_ImportSingleTrainingProgram)->RangeMultiplier(10)->Range(10, 1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <Plugin/history/SessionHistoryRecorder.h>
+#include <Plugin/history/SessionHistoryReader.h>
+
+#include <random>
+
+namespace
+{
+	std::filesystem::path createTemporaryHistoryPath()
+	{
+		return std::filesystem::temp_directory_path() / ("RLTrainingTimerBenchmark_" + std::to_string(std::random_device()())) / "session_history.bin";
+	}
+
+	/** Measures how long appending a single record takes for the caller (i.e. the game thread). */
+	void SessionHistoryWriter_Append(benchmark::State& state)
+	{
+		const auto path = createTemporaryHistoryPath();
+		{
+			history::SessionHistoryWriter writer(path, 64 * 1024 * 1024);
+			auto record = history::SessionRecord();
+			for (auto _ : state)
+			{
+				record.Timestamp++;
+				writer.append(record);
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+		std::filesystem::remove_all(path.parent_path());
+	}
+	BENCHMARK(SessionHistoryWriter_Append);
+
+	/** Measures the overhead of a session event on the flow control, including the conversion to a record. */
+	void SessionHistoryRecorder_ReceiveSessionEvent(benchmark::State& state)
+	{
+		const auto path = createTemporaryHistoryPath();
+		{
+			history::SessionHistoryRecorder recorder(path, 64 * 1024 * 1024);
+			const std::string trainingProgramId = "{5B1C9F2E-7A4D-4E3B-9C6A-2D8F0E1B3A57}";
+			auto sessionEvent = training::SessionEvent{ training::SessionEventType::StepStarted, trainingProgramId, 0, std::chrono::milliseconds(0) };
+			for (auto _ : state)
+			{
+				sessionEvent.StepNumber++;
+				recorder.receiveSessionEvent(sessionEvent);
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+		std::filesystem::remove_all(path.parent_path());
+	}
+	BENCHMARK(SessionHistoryRecorder_ReceiveSessionEvent);
+
+	/** Measures reading a history with the given number of records. */
+	void SessionHistoryReader_ReadAll(benchmark::State& state)
+	{
+		const auto path = createTemporaryHistoryPath();
+		{
+			history::SessionHistoryWriter writer(path, 64 * 1024 * 1024);
+			for (int64_t index = 0; index < state.range(0); index++)
+			{
+				auto record = history::SessionRecord();
+				record.Timestamp = index;
+				writer.append(record);
+			}
+		}
+
+		const auto reader = history::SessionHistoryReader(path);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(reader.readAll());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		std::filesystem::remove_all(path.parent_path());
+	}
+	BENCHMARK(SessionHistoryReader_ReadAll)->Arg(1000)->Arg(100000);
+}
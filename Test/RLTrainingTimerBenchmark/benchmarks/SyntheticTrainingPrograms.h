@@ -0,0 +1,159 @@
+#pragma once
+
+#include <Plugin/configuration/data/TrainingProgramData.h>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <random>
+
+/** Creates training programs of any size for benchmarks. Steps alternate between freeplay, custom training and workshop maps, so every kind of load command is used. */
+namespace synthetic
+{
+	inline configuration::TrainingProgramEntry createEntry(size_t stepNumber, const std::chrono::milliseconds& duration)
+	{
+		auto entry = configuration::TrainingProgramEntry();
+		entry.Name = fmt::format("Step {}", stepNumber + 1);
+		entry.TimeMode = configuration::TrainingProgramCompletionMode::Timed;
+		entry.Duration = duration;
+		switch (stepNumber % 3)
+		{
+		case 0:
+			entry.Type = configuration::TrainingProgramEntryType::Freeplay;
+			break;
+		case 1:
+			entry.Type = configuration::TrainingProgramEntryType::CustomTraining;
+			entry.TrainingPackCode = fmt::format("{:04X}-{:04X}-{:04X}-{:04X}", stepNumber, stepNumber * 7, stepNumber * 13, stepNumber * 31);
+			break;
+		default:
+			entry.Type = configuration::TrainingProgramEntryType::WorkshopMap;
+			entry.WorkshopMapPath = fmt::format("Map{}\\Map{}.udk", stepNumber, stepNumber);
+			break;
+		}
+		return entry;
+	}
+
+	/** Creates a program with the given number of timed steps, which all have the same duration. */
+	inline configuration::TrainingProgramData createTrainingProgram(const std::string& id, size_t numberOfSteps, const std::chrono::milliseconds& stepDuration)
+	{
+		auto trainingProgram = configuration::TrainingProgramData();
+		trainingProgram.Id = id;
+		trainingProgram.Name = fmt::format("Synthetic program with {} steps", numberOfSteps);
+		for (size_t stepNumber = 0; stepNumber < numberOfSteps; stepNumber++)
+		{
+			trainingProgram.Entries.push_back(createEntry(stepNumber, stepDuration));
+			trainingProgram.Duration += stepDuration;
+		}
+		return trainingProgram;
+	}
+
+	/** Creates a list which only contains the given training program. */
+	inline configuration::TrainingProgramListData createTrainingProgramList(configuration::TrainingProgramData trainingProgram)
+	{
+		auto trainingProgramList = configuration::TrainingProgramListData();
+		trainingProgramList.WorkshopFolderLocation = "C:\\Workshop";
+		trainingProgramList.TrainingProgramOrder.push_back(trainingProgram.Id);
+		trainingProgramList.TrainingProgramData.emplace(trainingProgram.Id, std::move(trainingProgram));
+		return trainingProgramList;
+	}
+
+	/** Defines the shape of a synthetic training program library. */
+	struct LibraryOptions
+	{
+	public:
+		size_t NumberOfPrograms = 100;
+		size_t MinimumNumberOfSteps = 3;
+		size_t MaximumNumberOfSteps = 20;
+		size_t NotesLength = 200; // Characters per step. Real notes range from nothing to whole paragraphs
+		double CustomVarianceProbability = 0.3; // The share of custom training steps which do not use the default variance settings
+		double CompletePackProbability = 0.2; // The share of custom training steps which last until the pack has been completed
+		uint32_t Seed = 42; // The same seed produces the same library, so results can be compared between runs
+	};
+
+	/** Creates text of the given length, made of words rather than a single repeated character, so it compresses and escapes like real text. */
+	inline std::string createText(std::mt19937& random, size_t length, bool allowLineBreaks = true)
+	{
+		static const char* const Words[] = { "shoot", "the", "ball", "into", "top", "corner", "air", "dribble", "flip", "reset", "wall", "pass", "save", "\"quick\"", "aerial", "boost" };
+		auto text = std::string();
+		text.reserve(length + 10);
+		while (text.size() < length)
+		{
+			text += Words[random() % (sizeof(Words) / sizeof(Words[0]))];
+			text += (allowLineBreaks && random() % 8 == 0) ? ".\n" : " ";
+		}
+		text.resize(length);
+		return text;
+	}
+
+	/** Creates variance settings which deviate from the defaults, the way the settings dialog would store them. */
+	inline configuration::VarianceSettings createVarianceSettings(std::mt19937& random)
+	{
+		auto variance = configuration::VarianceSettings();
+		variance.UseDefaultSettings = false;
+		variance.EnableTraining = "1";
+		variance.LimitBoost = std::to_string(random() % 101);
+		variance.AllowMirror = (random() % 2 == 0) ? "1" : "0";
+		variance.PlayerVelocity = "(0, 2000)";
+		variance.VarSpeed = std::to_string(random() % 20);
+		variance.VarLoc = std::to_string(random() % 100);
+		variance.VarLocZ = std::to_string(random() % 50);
+		variance.Shuffle = (random() % 2 == 0) ? "1" : "0";
+		variance.VarCarLoc = std::to_string(random() % 100);
+		variance.VarCarRot = std::to_string(random() % 10);
+		variance.VarSpin = "(-500, 500)";
+		variance.VarRot = std::to_string(random() % 10);
+		return variance;
+	}
+
+	/** Creates a list of training programs with varying numbers of steps, a mix of all entry types and completion modes, notes and variance settings. */
+	inline configuration::TrainingProgramListData createTrainingProgramLibrary(const LibraryOptions& options)
+	{
+		auto random = std::mt19937(options.Seed);
+		auto probability = std::uniform_real_distribution<double>(0.0, 1.0);
+		auto numberOfSteps = std::uniform_int_distribution<size_t>(options.MinimumNumberOfSteps, std::max(options.MinimumNumberOfSteps, options.MaximumNumberOfSteps));
+
+		auto trainingProgramList = configuration::TrainingProgramListData();
+		trainingProgramList.WorkshopFolderLocation = "C:\\Program Files (x86)\\Steam\\steamapps\\workshop\\content\\252950";
+		for (size_t programNumber = 0; programNumber < options.NumberOfPrograms; programNumber++)
+		{
+			auto trainingProgram = configuration::TrainingProgramData();
+			trainingProgram.Id = fmt::format("{{{:08X}-{:04X}-4{:03X}-8{:03X}-{:012X}}}", random(), random() % 0x10000, random() % 0x1000, random() % 0x1000, (uint64_t)random() << 16 | random() % 0x10000);
+			trainingProgram.Name = fmt::format("Program {}: {}", programNumber + 1, createText(random, 20, false));
+			trainingProgram.Description = createText(random, options.NotesLength);
+			trainingProgram.ReadOnly = (programNumber % 10 == 0);
+
+			const auto stepCount = numberOfSteps(random);
+			for (size_t stepNumber = 0; stepNumber < stepCount; stepNumber++)
+			{
+				auto entry = createEntry(stepNumber + programNumber, std::chrono::seconds(30 + random() % 600));
+				entry.Name = fmt::format("Step {}: {}", stepNumber + 1, createText(random, 15, false));
+				entry.Notes = createText(random, options.NotesLength);
+				if (random() % 4 == 0)
+				{
+					entry.Type = configuration::TrainingProgramEntryType::Unspecified;
+					entry.TrainingPackCode.clear();
+					entry.WorkshopMapPath.clear();
+				}
+				if (entry.Type == configuration::TrainingProgramEntryType::CustomTraining)
+				{
+					entry.TrainingPackCode = fmt::format("{:04X}-{:04X}-{:04X}-{:04X}", random() % 0x10000, random() % 0x10000, random() % 0x10000, random() % 0x10000);
+					if (probability(random) < options.CustomVarianceProbability)
+					{
+						entry.Variance = createVarianceSettings(random);
+					}
+					if (probability(random) < options.CompletePackProbability)
+					{
+						entry.TimeMode = configuration::TrainingProgramCompletionMode::CompletePack;
+						entry.Duration = std::chrono::milliseconds(0);
+					}
+				}
+				trainingProgram.Duration += entry.Duration;
+				trainingProgram.Entries.push_back(std::move(entry));
+			}
+
+			trainingProgramList.TrainingProgramOrder.push_back(trainingProgram.Id);
+			trainingProgramList.TrainingProgramData.emplace(trainingProgram.Id, std::move(trainingProgram));
+		}
+		return trainingProgramList;
+	}
+}
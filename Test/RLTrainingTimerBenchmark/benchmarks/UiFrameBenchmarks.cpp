@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <Plugin/training/ui/TrainingProgramFlowControlPanel.h>
+#include <Test/RLTrainingTimerTest/fakes/FakeGameWrapper.h>
+#include <Test/RLTrainingTimerTest/fakes/FakeTimeProvider.h>
+#include <Test/RLTrainingTimerTest/fixtures/AllocationCounter.h>
+
+#include "HeadlessImGuiContext.h"
+#include "NullCVarManager.h"
+#include "SyntheticTrainingPrograms.h"
+
+namespace
+{
+	const size_t NumberOfStepsPerProgram = 5;
+
+	/** Creates a library of the given number of programs, the way a player with many programs would have it. */
+	std::vector<configuration::TrainingProgramData> createLibrary(int64_t numberOfPrograms)
+	{
+		auto library = std::vector<configuration::TrainingProgramData>();
+		for (int64_t programNumber = 0; programNumber < numberOfPrograms; programNumber++)
+		{
+			const auto id = fmt::format("{{{:08X}-3E1F-4B8A-9C7D-5E2F1A0B3C4D}}", programNumber);
+			library.push_back(synthetic::createTrainingProgram(id, NumberOfStepsPerProgram, std::chrono::minutes(1)));
+		}
+		return library;
+	}
+
+	/** Renders frames until the benchmark is done. CPU time is reported per frame, allocations are averaged over all frames. */
+	void renderFrames(benchmark::State& state, const std::function<void()>& drawWindowContents)
+	{
+		auto imGuiContext = HeadlessImGuiContext();
+		imGuiContext.renderFrame(drawWindowContents); // ImGui creates its windows and buffers on the first frame
+		size_t numberOfAllocations = 0;
+		for (auto _ : state)
+		{
+			auto allocationCounter = AllocationCounter();
+			imGuiContext.renderFrame(drawWindowContents);
+			numberOfAllocations += allocationCounter.numberOfAllocations();
+		}
+		state.counters["AllocationsPerFrame"] = benchmark::Counter((double)numberOfAllocations, benchmark::Counter::kAvgIterations);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	/** Measures a frame of the training window while a program of the library is running. */
+	void FlowControlWindow_RenderFrame(benchmark::State& state)
+	{
+		auto trainingProgramList = configuration::TrainingProgramListData();
+		for (auto& trainingProgram : createLibrary(state.range(0)))
+		{
+			trainingProgramList.TrainingProgramOrder.push_back(trainingProgram.Id);
+			trainingProgramList.TrainingProgramData.emplace(trainingProgram.Id, std::move(trainingProgram));
+		}
+
+		auto timeProvider = std::make_shared<FakeTimeProvider>();
+		auto cvarManager = std::make_shared<NullCVarManager>();
+		auto flowControl = std::make_shared<training::TrainingProgramFlowControl>(std::make_shared<FakeGameWrapper>(), timeProvider, cvarManager);
+		flowControl->receiveListData(trainingProgramList);
+		flowControl->selectTrainingProgram(trainingProgramList.TrainingProgramOrder.back());
+		flowControl->startSelectedTrainingProgram();
+
+		auto trainingTimerSettings = std::make_shared<settings::TrainingTimerSettings>(cvarManager);
+		auto panel = training::TrainingProgramFlowControlPanel(flowControl, trainingTimerSettings, nullptr);
+		renderFrames(state, [&panel, &timeProvider]() {
+			timeProvider->CurrentFakeTime += std::chrono::milliseconds(16);
+			panel.renderOneFrame();
+		});
+	}
+	BENCHMARK(FlowControlWindow_RenderFrame)->RangeMultiplier(10)->Range(10, 5000)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#ifdef _WIN32
+#define UUID_SYSTEM_GENERATOR // The generator the plugin used before, which asks Windows for every ID
+#endif
+#include <Plugin/configuration/control/uuid_generator.h>
+
+#include <random>
+
+namespace
+{
+#ifdef UUID_SYSTEM_GENERATOR
+	/** Measures the former generator of the plugin, which asks the operating system for every ID. */
+	void Uuid_SystemGenerator(benchmark::State& state)
+	{
+		auto generator = uuids::uuid_system_generator();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(uuids::to_string(generator()));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Uuid_SystemGenerator);
+#endif
+
+	/** Measures taking every ID from std::random_device, which is how other platforms get randomness from the operating system. */
+	void Uuid_RandomDeviceGenerator(benchmark::State& state)
+	{
+		auto randomDevice = std::random_device();
+		auto generator = uuids::basic_uuid_random_generator<std::random_device>(randomDevice);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(uuids::to_string(generator()));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Uuid_RandomDeviceGenerator);
+
+	/** Measures the former fallback of the plugin, which used stduuid's generator on a single std::mt19937 and was not thread safe. */
+	void Uuid_StduuidRandomGenerator(benchmark::State& state)
+	{
+		auto randomEngine = std::mt19937(std::random_device()());
+		auto generator = uuids::uuid_random_generator(randomEngine);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(uuids::to_string(generator()));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Uuid_StduuidRandomGenerator);
+
+	/** Measures generating an ID as a string, the way the plugin uses it for a new training program. */
+	void Uuid_GenerateUUID(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(uuid_generator::generateUUID());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Uuid_GenerateUUID)->ThreadRange(1, 4);
+
+	/** Measures generating a binary ID, without formatting it. */
+	void Uuid_Generate(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(uuid_generator::generate());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Uuid_Generate)->ThreadRange(1, 4);
+
+	/** Measures generating the IDs for a whole library at once, e.g. when migrating from version 1.1. */
+	void Uuid_GenerateBulk(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(uuid_generator::generate((size_t)state.range(0)));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(Uuid_GenerateBulk)->RangeMultiplier(10)->Range(10, 10000);
+}
@@ -9,7 +9,7 @@ int main(int argc, char** argv)
     testing::InitGoogleTest(&argc, argv);
     testing::InitGoogleMock(&argc, argv);
 
-    RUN_ALL_TESTS();
+    return RUN_ALL_TESTS();
 }
 
 // Run program: Ctrl + F5 or Debug > Start Without Debugging menu
@@ -3,19 +3,44 @@
 #include <Plugin/training/control/ICVarManager.h>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
-/** This fake class allows reading the most recent command which would have been executed, instead of actually executing it. */
+/** This fake class allows reading the commands and batches which would have been executed, instead of actually executing them. */
 class FakeCVarManager: public ICVarManager
 {
 public:
 	FakeCVarManager() = default;
 
-	void executeCommand(std::string command, bool log) override
+	void executeCommand(std::string command, bool /*log*/) override
 	{
 		_lastCommand = command;
+		_executedCommands.push_back(command);
+	}
+
+	void executeBatch(const CommandBatch& batch) override
+	{
+		_executedBatches.push_back(batch.commands());
+		ICVarManager::executeBatch(batch);
+	}
+
+	std::string getCvarValue(const std::string& cvarName) override
+	{
+		auto iter = FakeCvarValues.find(cvarName);
+		return iter == FakeCvarValues.end() ? std::string() : iter->second;
+	}
+
+	void setCvarValue(const std::string& cvarName, const std::string& value) override
+	{
+		FakeCvarValues[cvarName] = value;
 	}
 
 	inline std::string lastCommand() const { return _lastCommand; }
+	inline const std::vector<std::string>& executedCommands() const { return _executedCommands; }
+	inline const std::vector<std::vector<std::string>>& executedBatches() const { return _executedBatches; }
+
+	std::unordered_map<std::string, std::string> FakeCvarValues;
 private:
 	std::string _lastCommand;
+	std::vector<std::string> _executedCommands;
+	std::vector<std::vector<std::string>> _executedBatches;
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Plugin/training/control/ICompletionTimeEstimator.h>
+#include <map>
+#include <utility>
+
+/** This fake class returns preconfigured completion times instead of learning them. */
+class FakeCompletionTimeEstimator : public training::ICompletionTimeEstimator
+{
+public:
+	std::optional<std::chrono::milliseconds> estimateCompletionTime(const std::string& trainingProgramId, uint16_t stepNumber) const override
+	{
+		auto iter = FakeCompletionTimes.find(std::make_pair(trainingProgramId, stepNumber));
+		return iter == FakeCompletionTimes.end() ? std::nullopt : std::optional(iter->second);
+	}
+
+	std::map<std::pair<std::string, uint16_t>, std::chrono::milliseconds> FakeCompletionTimes;
+};
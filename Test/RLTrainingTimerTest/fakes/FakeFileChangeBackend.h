@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Plugin/configuration/control/IFileChangeBackend.h>
+
+/** Simulates a single file without touching the file system. Tests can change the file as if another program had written it. */
+class FakeFileChangeBackend : public configuration::IFileChangeBackend
+{
+public:
+	bool mightHaveChanged() override
+	{
+		return MightHaveChanged;
+	}
+
+	std::optional<configuration::FileSignature> getSignature(const std::filesystem::path&) const override
+	{
+		return Signature;
+	}
+
+	std::optional<std::string> readFile(const std::filesystem::path&) const override
+	{
+		NumberOfReads++;
+		return Contents;
+	}
+
+	/** Changes the contents of the fake file, like a write of another program would. */
+	void writeExternally(const std::string& contents)
+	{
+		Contents = contents;
+		Signature = configuration::FileSignature{ std::filesystem::file_time_type(std::chrono::seconds(++_writeCount)), contents.size() };
+	}
+
+	/** Changes the modification time of the fake file without changing its contents. */
+	void touch()
+	{
+		writeExternally(Contents.value_or(std::string()));
+	}
+
+	bool MightHaveChanged = true;
+	std::optional<configuration::FileSignature> Signature;
+	std::optional<std::string> Contents;
+	mutable int NumberOfReads = 0;
+
+private:
+	int _writeCount = 0;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Plugin/training/data/SessionEvent.h>
+#include <vector>
+
+/** This fake class remembers the types of all session events it received. */
+class FakeSessionEventReceiver : public training::ISessionEventReceiver
+{
+public:
+	void receiveSessionEvent(const training::SessionEvent& sessionEvent) override
+	{
+		ReceivedEventTypes.push_back(sessionEvent.Type);
+		ReceivedEvents.push_back(sessionEvent);
+	}
+
+	std::vector<training::SessionEventType> ReceivedEventTypes;
+	std::vector<training::SessionEvent> ReceivedEvents; // Note: The training program IDs are no longer valid
+};
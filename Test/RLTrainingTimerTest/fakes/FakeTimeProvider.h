@@ -11,5 +11,13 @@ public:
 		return CurrentFakeTime;
 	}
 
+	std::chrono::system_clock::time_point currentDateTime() const override
+	{
+		// Advances together with the fake time
+		return FakeDateTimeAtStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(CurrentFakeTime - FakeTimeAtStart);
+	}
+
 	std::chrono::steady_clock::time_point CurrentFakeTime = std::chrono::steady_clock::now();
+	const std::chrono::steady_clock::time_point FakeTimeAtStart = CurrentFakeTime;
+	std::chrono::system_clock::time_point FakeDateTimeAtStart = std::chrono::system_clock::now();
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	thread_local size_t AllocationsOfThisThread = 0; // Per thread, so neither a lock nor an atomic is needed
+
+	void* allocate(std::size_t size, std::size_t alignment)
+	{
+		AllocationsOfThisThread++;
+		if (size == 0) { size = 1; }
+		while (true)
+		{
+#ifdef _WIN32
+			auto memory = alignment > alignof(std::max_align_t) ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+			// aligned_alloc requires the size to be a multiple of the alignment
+			auto memory = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment) : std::malloc(size);
+#endif
+			if (memory != nullptr)
+			{
+				return memory;
+			}
+			auto newHandler = std::get_new_handler();
+			if (newHandler == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+			newHandler();
+		}
+	}
+
+	void deallocate(void* memory, std::size_t alignment) noexcept
+	{
+#ifdef _WIN32
+		if (alignment > alignof(std::max_align_t))
+		{
+			_aligned_free(memory);
+			return;
+		}
+#else
+		(void)alignment; // aligned_alloc and malloc share free
+#endif
+		std::free(memory);
+	}
+}
+
+// Replace the global operator new of the test executable. The array and nothrow forms call these by default.
+void* operator new(std::size_t size)
+{
+	return allocate(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocate(size, (std::size_t)alignment);
+}
+
+// Match the operators above, including the sized forms which the compiler prefers whenever it knows the size.
+void operator delete(void* memory) noexcept
+{
+	deallocate(memory, alignof(std::max_align_t));
+}
+void operator delete(void* memory, std::size_t) noexcept
+{
+	deallocate(memory, alignof(std::max_align_t));
+}
+void operator delete(void* memory, std::align_val_t alignment) noexcept
+{
+	deallocate(memory, (std::size_t)alignment);
+}
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept
+{
+	deallocate(memory, (std::size_t)alignment);
+}
+
+AllocationCounter::AllocationCounter()
+	: _allocationsAtStart{ AllocationsOfThisThread }
+{
+}
+
+size_t AllocationCounter::numberOfAllocations() const
+{
+	return AllocationsOfThisThread - _allocationsAtStart;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Counts the heap allocations which happen on the current thread while an instance of it exists.
+ * This allows making sure that code which runs on every frame (timer ticks, rendering) does not allocate once it is in a steady state.
+ *
+ * Counting replaces the global operator new of the test executable, so it never ends up in the plugin DLL.
+ * Allocations are only visible if the code under test uses that operator new. This is the case for the CMake build, which links the plugin code statically.
+ * On Windows, the tests link the plugin DLL, which brings its own runtime library and thus its own operator new. Allocations made by the DLL can't be counted there.
+ */
+class AllocationCounter
+{
+public:
+	/** Checks whether allocations made by the plugin code are counted. See the class comment. */
+#ifdef _WIN32
+	static constexpr bool CountsPluginAllocations = false;
+#else
+	static constexpr bool CountsPluginAllocations = true;
+#endif
+
+	/** Starts counting. */
+	AllocationCounter();
+
+	/** Retrieves the number of allocations which happened on the current thread since the counter was created. */
+	size_t numberOfAllocations() const;
+
+private:
+	size_t _allocationsAtStart;
+};
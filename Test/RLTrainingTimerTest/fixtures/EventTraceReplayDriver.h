@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../fakes/FakeTimeProvider.h"
+#include "../fakes/FakeGameWrapper.h"
+#include "../fakes/FakeCVarManager.h"
+#include "../fakes/FakeCompletionTimeEstimator.h"
+#include <Plugin/training/control/TrainingProgramFlowControl.h>
+#include <Plugin/training/control/EventTrace.h>
+#include <Plugin/configuration/control/TrainingProgramRepository.h>
+
+#include <stdexcept>
+
+/**
+ * Feeds a recorded event trace through a flow control which only knows fakes, as fast as possible.
+ * The fake time jumps from entry to entry, so a replay takes the same course as the recorded session, no matter how long that session was.
+ * Inputs which were recorded for an entry (e.g. cvar values) get provided by the fakes before that entry is replayed.
+ */
+class EventTraceReplayDriver
+{
+public:
+	/** Constructor. Whenever the trace says so, the training program list which was recorded in the trace gets passed to the flow control. */
+	EventTraceReplayDriver()
+	{
+		FlowControl = std::make_unique<training::TrainingProgramFlowControl>(FakeGameWrapperInstance, FakeTimeProviderInstance, FakeCVarManagerInstance);
+		FlowControl->hookToEvents();
+		FlowControl->setCompletionTimeEstimator(FakeCompletionTimeEstimatorInstance);
+		_traceStartTime = FakeTimeProviderInstance->CurrentFakeTime;
+	}
+
+	/** Replays all entries in order. A trace may be replayed in several parts. The command batches which were recorded get stored in RecordedBatches. Throws std::runtime_error for entries which can't be replayed. */
+	void replay(const std::vector<training::TraceEntry>& entries)
+	{
+		for (size_t index = 0; index < entries.size(); index++)
+		{
+			const auto& entry = entries[index];
+			if (entry.Type == training::TraceEntryType::Input || entry.Type == training::TraceEntryType::Result)
+			{
+				continue; // Handled together with the entry they belong to
+			}
+			for (auto followingIndex = index + 1; followingIndex < entries.size(); followingIndex++)
+			{
+				const auto& followingEntry = entries[followingIndex];
+				if (followingEntry.Type == training::TraceEntryType::Input) { provideInput(followingEntry); }
+				else if (followingEntry.Type == training::TraceEntryType::Result) { storeResult(followingEntry); }
+				else { break; }
+			}
+
+			FakeTimeProviderInstance->CurrentFakeTime = _traceStartTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(entry.TimeSinceStart);
+			FakeGameWrapperInstance->FakeIsPaused = entry.GameIsPaused;
+			FakeGameWrapperInstance->FakeIsInFreeplay = entry.GameIsInFreeplay;
+			switch (entry.Type)
+			{
+			case training::TraceEntryType::HookEvent:
+				findCallback(FakeGameWrapperInstance->FakeEventMap, entry.Name)(entry.Name);
+				break;
+			case training::TraceEntryType::HookEventPost:
+				findCallback(FakeGameWrapperInstance->FakeEventPostMap, entry.Name)(entry.Name);
+				break;
+			case training::TraceEntryType::Command:
+				executeCommand(entry);
+				break;
+			default:
+				throw std::runtime_error("Unknown trace entry type");
+			}
+		}
+	}
+
+	std::shared_ptr<FakeGameWrapper> FakeGameWrapperInstance = std::make_shared<FakeGameWrapper>();
+	std::shared_ptr<FakeTimeProvider> FakeTimeProviderInstance = std::make_shared<FakeTimeProvider>();
+	std::shared_ptr<FakeCVarManager> FakeCVarManagerInstance = std::make_shared<FakeCVarManager>();
+	std::shared_ptr<FakeCompletionTimeEstimator> FakeCompletionTimeEstimatorInstance = std::make_shared<FakeCompletionTimeEstimator>();
+	std::unique_ptr<training::TrainingProgramFlowControl> FlowControl;
+	std::vector<std::vector<std::string>> RecordedBatches; // The batches which were executed while recording, to be compared with FakeCVarManagerInstance->executedBatches()
+
+private:
+	static const std::function<void(std::string)>& findCallback(const std::unordered_map<std::string, std::function<void(std::string)>>& callbacks, const std::string& eventName)
+	{
+		if (auto iter = callbacks.find(eventName); iter != callbacks.end())
+		{
+			return iter->second;
+		}
+		throw std::runtime_error("The flow control does not hook " + eventName);
+	}
+
+	void provideInput(const training::TraceEntry& entry)
+	{
+		const auto values = training::EventTrace::parseArgument(entry.Argument);
+		if (entry.Name == training::TraceInput::CvarValue && values.size() == 2)
+		{
+			FakeCVarManagerInstance->FakeCvarValues[values[0]] = values[1];
+		}
+		else if (entry.Name == training::TraceInput::CompletionTime && values.size() == 3)
+		{
+			auto key = std::make_pair(values[0], (uint16_t)std::stoul(values[1]));
+			if (values[2].empty()) { FakeCompletionTimeEstimatorInstance->FakeCompletionTimes.erase(key); }
+			else { FakeCompletionTimeEstimatorInstance->FakeCompletionTimes[key] = std::chrono::milliseconds(std::stoll(values[2])); }
+		}
+		else
+		{
+			throw std::runtime_error("Unknown input " + entry.Name);
+		}
+	}
+
+	void storeResult(const training::TraceEntry& entry)
+	{
+		if (entry.Name != training::TraceResult::CommandBatch)
+		{
+			throw std::runtime_error("Unknown result " + entry.Name);
+		}
+		RecordedBatches.push_back(training::EventTrace::parseArgument(entry.Argument));
+	}
+
+	void executeCommand(const training::TraceEntry& entry)
+	{
+		using namespace training;
+		if (entry.Name == TraceCommand::ReceiveListData) { FlowControl->receiveListData(recordedTrainingProgramList(entry)); }
+		else if (entry.Name == TraceCommand::SetPreloadSettings) { setPreloadSettings(entry); }
+		else if (entry.Name == TraceCommand::SetPreStepCommands) { FlowControl->setPreStepCommands(EventTrace::parseArgument(entry.Argument)); }
+		else if (entry.Name == TraceCommand::Select) { FlowControl->selectTrainingProgram(entry.Argument); }
+		else if (entry.Name == TraceCommand::Unselect) { FlowControl->unselectTrainingProgram(); }
+		else if (entry.Name == TraceCommand::Start) { FlowControl->startSelectedTrainingProgram(); }
+		else if (entry.Name == TraceCommand::Stop) { FlowControl->stopRunningTrainingProgram(); }
+		else if (entry.Name == TraceCommand::Pause) { FlowControl->pauseTrainingProgram(); }
+		else if (entry.Name == TraceCommand::Resume) { FlowControl->resumeTrainingProgram(); }
+		else if (entry.Name == TraceCommand::ActivateNext) { FlowControl->activateNextTrainingProgramStep(); }
+		else if (entry.Name == TraceCommand::Skip) { FlowControl->skipTrainingProgramStep(); }
+		else { throw std::runtime_error("Unknown command " + entry.Name); }
+	}
+
+	void setPreloadSettings(const training::TraceEntry& entry)
+	{
+		const auto values = training::EventTrace::parseArgument(entry.Argument);
+		if (values.size() != 2)
+		{
+			throw std::runtime_error("The trace contains invalid preload settings");
+		}
+		FlowControl->setPreloadSettings(values[0] == "1", std::chrono::milliseconds(std::stoll(values[1])));
+	}
+
+	static configuration::TrainingProgramListData recordedTrainingProgramList(const training::TraceEntry& entry)
+	{
+		auto trainingProgramList = configuration::TrainingProgramRepository::deserializeList(entry.Argument);
+		if (!trainingProgramList.has_value())
+		{
+			throw std::runtime_error("The trace contains an invalid training program list");
+		}
+		return trainingProgramList.value();
+	}
+
+	std::chrono::steady_clock::time_point _traceStartTime;
+};
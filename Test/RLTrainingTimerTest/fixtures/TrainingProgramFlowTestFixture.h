@@ -115,6 +115,24 @@ protected:
 		_fakeTimeProvider->CurrentFakeTime = pointInTime;
 		_fakeGameWrapper->FakeEventMap.at(TimerTickEventName)("");
 	}
+	// Simulates an event where the game started loading a map at the given point in time
+	void startMapLoad(const std::chrono::steady_clock::time_point& pointInTime)
+	{
+		_fakeTimeProvider->CurrentFakeTime = pointInTime;
+		_fakeGameWrapper->FakeEventMap.at(MapLoadStartEventName)("");
+	}
+	// Simulates an event where the game finished loading a map at the given point in time
+	void finishMapLoad(const std::chrono::steady_clock::time_point& pointInTime)
+	{
+		_fakeTimeProvider->CurrentFakeTime = pointInTime;
+		_fakeGameWrapper->FakeEventPostMap.at(MapLoadEndEventName)("");
+	}
+	// Simulates an event where the player reached the end screen of the current training pack at the given point in time
+	void completePack(const std::chrono::steady_clock::time_point& pointInTime)
+	{
+		_fakeTimeProvider->CurrentFakeTime = pointInTime;
+		_fakeGameWrapper->FakeEventPostMap.at(TrainingEndEventName)("");
+	}
 
 
 	std::unique_ptr<training::TrainingProgramFlowControl> sut;
@@ -156,4 +174,7 @@ protected:
 
 	const std::string PauseEventName = "Function Engine.WorldInfo.EventPauseChanged";
 	const std::string TimerTickEventName = "Function TAGame.Replay_TA.Tick";
+	const std::string MapLoadStartEventName = "Function TAGame.LoadingScreen_TA.HandlePreLoadMap";
+	const std::string MapLoadEndEventName = "Function TAGame.LoadingScreen_TA.HandlePostLoadMap";
+	const std::string TrainingEndEventName = "Function TAGame.GameEvent_TrainingEditor_TA.EndTraining";
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <Plugin/configuration/control/TrainingProgramRepository.h>
+
+#include <fstream>
+#include <random>
+
+/** Provides a repository which stores its data in a temporary folder which gets deleted after each test. */
+class TrainingProgramRepositoryTestFixture : public testing::Test
+{
+public:
+	void SetUp() override
+	{
+		StorageFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerTest_" + std::to_string(std::random_device()()));
+		StoragePath = StorageFolder / "trainingprogramlist.json";
+		sut = std::make_unique<configuration::TrainingProgramRepository>(StoragePath);
+	}
+
+	void TearDown() override
+	{
+		sut.reset();
+		std::filesystem::remove_all(StorageFolder);
+	}
+
+protected:
+	/** Replaces the repository by a new one, just like when the game gets restarted. Backups get rotated once per session. */
+	void restartSession()
+	{
+		sut.reset();
+		sut = std::make_unique<configuration::TrainingProgramRepository>(StoragePath);
+	}
+
+	/** Creates a list with a single training program of the given name. */
+	static configuration::TrainingProgramListData createList(const std::string& trainingProgramName)
+	{
+		configuration::TrainingProgramData trainingProgram;
+		trainingProgram.Id = "{" + trainingProgramName + "}";
+		trainingProgram.Name = trainingProgramName;
+
+		configuration::TrainingProgramListData list;
+		list.TrainingProgramData.emplace(trainingProgram.Id, trainingProgram);
+		list.TrainingProgramOrder.push_back(trainingProgram.Id);
+		return list;
+	}
+
+	/** Retrieves the name of the first training program in the list, or an empty string if there is none. */
+	static std::string firstName(const configuration::TrainingProgramListData& list)
+	{
+		return list.TrainingProgramOrder.empty() ? std::string() : list.TrainingProgramData.at(list.TrainingProgramOrder.front()).Name;
+	}
+
+	/** Simulates a write which was interrupted after the given number of bytes, e.g. because the game crashed. */
+	static void tearFile(const std::filesystem::path& path, size_t remainingBytes)
+	{
+		std::filesystem::resize_file(path, remainingBytes);
+	}
+
+	static void writeFile(const std::filesystem::path& path, const std::string& contents)
+	{
+		std::ofstream os{ path, std::ios::binary };
+		os << contents;
+	}
+
+	std::filesystem::path StorageFolder;
+	std::filesystem::path StoragePath;
+	std::unique_ptr<configuration::TrainingProgramRepository> sut;
+};
@@ -5,10 +5,14 @@
 
 class ITrainingProgramRepositoryMock : public configuration::ITrainingProgramRepository
 {
+public:
 	MOCK_METHOD(void, storeData, (const configuration::TrainingProgramListData& data), (override));
 	MOCK_METHOD(void, storeData, (const configuration::TrainingProgramListData& data, const std::string& location), (override));
 	MOCK_METHOD(configuration::TrainingProgramListData, restoreData, (), (const override));
 	MOCK_METHOD(configuration::TrainingProgramListData, restoreData, (const std::string& location), (const override));
+	MOCK_METHOD(std::optional<configuration::TrainingProgramListData>, restoreDataIfChangedExternally, (), (override));
 	MOCK_METHOD(void, exportSingleTrainingProgram, (const configuration::TrainingProgramData& data, const std::string& location), (override));
 	MOCK_METHOD(configuration::TrainingProgramData, importSingleTrainingProgram, (const std::string& location), (const override));
+	MOCK_METHOD(void, exportTrainingPrograms, (const std::vector<configuration::TrainingProgramData>& data, const std::string& location, configuration::BulkExportFormat format), (override));
+	MOCK_METHOD(std::vector<configuration::TrainingProgramData>, importTrainingProgramBundle, (const std::string& location), (const override));
 };
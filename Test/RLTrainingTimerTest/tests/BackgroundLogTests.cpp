@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/diagnostics/BackgroundLog.h>
+
+#include <thread>
+
+namespace test
+{
+	using diagnostics::BackgroundLog;
+
+	TEST(BackgroundLogTests, takeMessages_when_postedFromSeveralThreads_will_returnEveryMessageOnce)
+	{
+		BackgroundLog::takeMessages();
+		std::vector<std::thread> threads;
+		for (auto threadNumber = 0; threadNumber < 4; threadNumber++)
+		{
+			threads.emplace_back([threadNumber]() {
+				for (auto messageNumber = 0; messageNumber < 10; messageNumber++)
+				{
+					BackgroundLog::post(std::to_string(threadNumber) + "/" + std::to_string(messageNumber));
+				}
+			});
+		}
+		for (auto& thread : threads) { thread.join(); }
+
+		EXPECT_EQ(BackgroundLog::takeMessages().size(), 40);
+		EXPECT_TRUE(BackgroundLog::takeMessages().empty());
+	}
+
+	TEST(BackgroundLogTests, post_when_messagesAreNeverWritten_will_onlyKeepNewestMessages)
+	{
+		BackgroundLog::takeMessages();
+		for (auto messageNumber = 0; messageNumber < 1000; messageNumber++)
+		{
+			BackgroundLog::post(std::to_string(messageNumber));
+		}
+
+		auto messages = BackgroundLog::takeMessages();
+
+		ASSERT_FALSE(messages.empty());
+		EXPECT_LT(messages.size(), 1000);
+		EXPECT_EQ(messages.back(), "999");
+	}
+}
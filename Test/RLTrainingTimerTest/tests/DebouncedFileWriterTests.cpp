@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/configuration/control/DebouncedFileWriter.h>
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace test
+{
+	using configuration::DebouncedFileWriter;
+
+	class DebouncedFileWriterTests : public testing::Test
+	{
+	public:
+		void SetUp() override
+		{
+			Folder = std::filesystem::temp_directory_path() / ("RLTrainingTimerDebouncedFileWriterTest_" + std::to_string(std::random_device()()));
+			std::filesystem::create_directories(Folder);
+			FilePath = Folder / "settings.cfg";
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(Folder);
+		}
+
+	protected:
+		std::string readFile() const
+		{
+			std::ifstream file{ FilePath, std::ios::binary };
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return contents.str();
+		}
+
+		std::filesystem::path Folder;
+		std::filesystem::path FilePath;
+	};
+
+	TEST_F(DebouncedFileWriterTests, write_when_calledManyTimesInQuickSuccession_will_writeFileOnce)
+	{
+		DebouncedFileWriter writer(FilePath, std::chrono::seconds(10));
+		for (int value = 0; value <= 100; value++)
+		{
+			writer.write("rltt_slider \"" + std::to_string(value) + "\"\n");
+		}
+		writer.flush();
+
+		EXPECT_EQ(writer.numberOfWrites(), 1);
+		EXPECT_EQ(readFile(), "rltt_slider \"100\"\n");
+	}
+
+	TEST_F(DebouncedFileWriterTests, write_when_quietPeriodHasPassed_will_writeWithoutFlush)
+	{
+		DebouncedFileWriter writer(FilePath, std::chrono::milliseconds(10));
+		writer.write("rltt_value \"1\"\n");
+
+		const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (writer.numberOfWrites() == 0 && std::chrono::steady_clock::now() < timeout)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+
+		EXPECT_EQ(writer.numberOfWrites(), 1);
+		EXPECT_EQ(readFile(), "rltt_value \"1\"\n");
+	}
+
+	TEST_F(DebouncedFileWriterTests, write_when_contentsDidNotChange_will_skipWrite)
+	{
+		DebouncedFileWriter writer(FilePath, std::chrono::seconds(10));
+		writer.write("rltt_value \"1\"\n");
+		writer.flush();
+		writer.write("rltt_value \"2\"\n");
+		writer.write("rltt_value \"1\"\n"); // Back to what is in the file already
+		writer.flush();
+
+		EXPECT_EQ(writer.numberOfWrites(), 1);
+	}
+
+	TEST_F(DebouncedFileWriterTests, write_when_fileExistsWithSameContents_will_skipWrite)
+	{
+		std::ofstream{ FilePath, std::ios::binary } << "rltt_value \"1\"\n";
+
+		DebouncedFileWriter writer(FilePath, std::chrono::seconds(10));
+		writer.write("rltt_value \"1\"\n");
+		writer.flush();
+
+		EXPECT_EQ(writer.numberOfWrites(), 0);
+	}
+
+	TEST_F(DebouncedFileWriterTests, write_when_contentsChangedBetweenFlushes_will_writeEachTime)
+	{
+		DebouncedFileWriter writer(FilePath, std::chrono::seconds(10));
+		writer.write("rltt_value \"1\"\n");
+		writer.flush();
+		writer.write("rltt_value \"2\"\n");
+		writer.flush();
+
+		EXPECT_EQ(writer.numberOfWrites(), 2);
+		EXPECT_EQ(readFile(), "rltt_value \"2\"\n");
+	}
+
+	TEST_F(DebouncedFileWriterTests, destructor_when_contentsArePending_will_writeThemRightAway)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		{
+			DebouncedFileWriter writer(FilePath, std::chrono::seconds(10));
+			writer.write("rltt_value \"3\"\n");
+		}
+
+		EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+		EXPECT_EQ(readFile(), "rltt_value \"3\"\n");
+	}
+}
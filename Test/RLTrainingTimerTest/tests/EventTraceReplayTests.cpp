@@ -0,0 +1,206 @@
+#include "../fixtures/TrainingProgramFlowTestFixture.h"
+#include "../fixtures/EventTraceReplayDriver.h"
+#include "../fakes/FakeSessionEventReceiver.h"
+#include "../fakes/FakeCompletionTimeEstimator.h"
+
+#include <Plugin/training/control/EventTraceRecorder.h>
+#include <Plugin/configuration/control/TrainingProgramRepository.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+namespace test
+{
+	class EventTraceReplayTests : public TrainingProgramFlowTestFixture
+	{
+	public:
+		void SetUp() override
+		{
+			TrainingProgramFlowTestFixture::SetUp();
+			TraceFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerTraceTest_" + std::to_string(std::random_device()()));
+			TracePath = TraceFolder / "session.trace";
+
+			// Record everything which happens to the flow control of the fixture. The fake game wrapper gets replaced since it already knows the callbacks of the original flow control.
+			_fakeGameWrapper = std::make_shared<FakeGameWrapper>();
+			_recorder = std::make_shared<training::EventTraceRecorder>(_fakeGameWrapper, _fakeTimeProvider);
+			sut = std::make_unique<training::TrainingProgramFlowControl>(_recorder, _fakeTimeProvider, _fakeCVarManager);
+			sut->hookToEvents();
+			sut->setEventTraceRecorder(_recorder);
+			_recordedEvents = std::make_shared<FakeSessionEventReceiver>();
+			sut->registerSessionEventReceiver(_recordedEvents);
+		}
+
+		void TearDown() override
+		{
+			_recorder->stop();
+			std::filesystem::remove_all(TraceFolder);
+		}
+
+	protected:
+		std::filesystem::path TraceFolder;
+		std::filesystem::path TracePath;
+		std::shared_ptr<training::EventTraceRecorder> _recorder;
+		std::shared_ptr<FakeSessionEventReceiver> _recordedEvents;
+	};
+
+	TEST_F(EventTraceReplayTests, read_when_traceWasRecorded_will_restoreEntries)
+	{
+		_recorder->start(TracePath);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		_fakeGameWrapper->FakeIsInFreeplay = true;
+		sendTimerTick(_fakeTimeProvider->CurrentFakeTime + std::chrono::microseconds(1500));
+		_recorder->stop();
+
+		auto entries = training::EventTrace::read(TracePath);
+
+		ASSERT_EQ(entries.size(), 3);
+		EXPECT_EQ(entries[0].Name, training::TraceCommand::ReceiveListData);
+		auto recordedList = configuration::TrainingProgramRepository::deserializeList(entries[0].Argument);
+		ASSERT_TRUE(recordedList.has_value());
+		EXPECT_EQ(recordedList->TrainingProgramOrder, FullTrainingProgramList.TrainingProgramOrder);
+		EXPECT_EQ(entries[1].Type, training::TraceEntryType::Command);
+		EXPECT_EQ(entries[1].Name, training::TraceCommand::Select);
+		EXPECT_EQ(entries[1].Argument, FullyTimedTrainingProgramId);
+		EXPECT_EQ(entries[2].Type, training::TraceEntryType::HookEvent);
+		EXPECT_EQ(entries[2].Name, TimerTickEventName);
+		EXPECT_EQ(entries[2].TimeSinceStart, std::chrono::microseconds(1500));
+		EXPECT_TRUE(entries[2].GameIsInFreeplay);
+	}
+
+	TEST_F(EventTraceReplayTests, record_when_commandIsCalledByEvent_will_onlyRecordEvent)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		_recorder->start(TracePath);
+
+		// Finishes the first step, which internally activates the next one
+		sendTimerTick(_fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration);
+		_recorder->stop();
+
+		auto entries = training::EventTrace::read(TracePath);
+
+		ASSERT_EQ(entries.size(), 1);
+		EXPECT_EQ(entries[0].Name, TimerTickEventName);
+	}
+
+	TEST_F(EventTraceReplayTests, replay_when_sessionWasRecorded_will_reproduceSession)
+	{
+		_recorder->start(TracePath);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(MixedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+		sendTimerTick(startTime + std::chrono::seconds(10));
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(20);
+		pauseGame();
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(50);
+		resumeGame();
+		sendTimerTick(startTime + std::chrono::seconds(95)); // Ends the first step, since the pause does not count
+		completePack(startTime + std::chrono::seconds(150));
+		sendTimerTick(startTime + std::chrono::seconds(160));
+		sut->skipTrainingProgramStep();
+		sendTimerTick(startTime + std::chrono::seconds(200));
+		sut->stopRunningTrainingProgram();
+		_recorder->stop();
+
+		auto driver = EventTraceReplayDriver(); // The training programs are part of the trace
+		auto replayedEvents = std::make_shared<FakeSessionEventReceiver>();
+		driver.FlowControl->registerSessionEventReceiver(replayedEvents);
+		driver.replay(training::EventTrace::read(TracePath));
+
+		ASSERT_EQ(replayedEvents->ReceivedEventTypes, _recordedEvents->ReceivedEventTypes);
+		for (size_t index = 0; index < replayedEvents->ReceivedEvents.size(); index++)
+		{
+			EXPECT_EQ(replayedEvents->ReceivedEvents[index].StepNumber, _recordedEvents->ReceivedEvents[index].StepNumber);
+			EXPECT_EQ(replayedEvents->ReceivedEvents[index].Duration, _recordedEvents->ReceivedEvents[index].Duration);
+		}
+		EXPECT_EQ(driver.FakeCVarManagerInstance->executedBatches(), _fakeCVarManager->executedBatches());
+		EXPECT_EQ(driver.RecordedBatches, _fakeCVarManager->executedBatches());
+	}
+
+	TEST_F(EventTraceReplayTests, replay_when_settingsWereMadeBeforeRecording_will_applyRecordedHeader)
+	{
+		const auto preStepCommands = std::vector<std::string>{ "boost_amount\t100", "rltt_example \"quoted\"" };
+		auto completionTimeEstimator = std::make_shared<FakeCompletionTimeEstimator>();
+		completionTimeEstimator->FakeCompletionTimes[std::make_pair(UntimedTrainingProgramId, uint16_t(0))] = std::chrono::seconds(90);
+		sut->setCompletionTimeEstimator(completionTimeEstimator);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->setPreloadSettings(true, std::chrono::seconds(5));
+		sut->setPreStepCommands(preStepCommands);
+		sut->selectTrainingProgram(UntimedTrainingProgramId);
+
+		_recorder->start(TracePath);
+		_recorder->record(training::TraceEntryType::Command, training::TraceCommand::ReceiveListData, configuration::TrainingProgramRepository::serializeList(FullTrainingProgramList));
+		sut->recordTraceHeader();
+		sut->startSelectedTrainingProgram();
+		const auto recordedTimeLeft = sut->getCurrentExecutionData().TimeLeftInProgram;
+		ASSERT_EQ(recordedTimeLeft, std::chrono::seconds(90));
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+		completePack(startTime + std::chrono::seconds(60));
+		sendTimerTick(startTime + std::chrono::seconds(70));
+		sut->stopRunningTrainingProgram();
+		_recorder->stop();
+
+		auto driver = EventTraceReplayDriver();
+		auto entries = training::EventTrace::read(TracePath);
+		auto startEntry = std::find_if(entries.begin(), entries.end(), [](const training::TraceEntry& entry) { return entry.Name == training::TraceCommand::Start; });
+		ASSERT_NE(startEntry, entries.end());
+		auto entryAfterStart = std::find_if(startEntry + 1, entries.end(), [](const training::TraceEntry& entry) {
+			return entry.Type != training::TraceEntryType::Input && entry.Type != training::TraceEntryType::Result;
+		});
+		driver.replay({ entries.begin(), entryAfterStart });
+		EXPECT_EQ(driver.FlowControl->getCurrentExecutionData().TimeLeftInProgram, recordedTimeLeft);
+		driver.replay({ entryAfterStart, entries.end() });
+
+		ASSERT_FALSE(_fakeCVarManager->executedBatches().empty());
+		EXPECT_EQ(_fakeCVarManager->executedBatches().front().front(), preStepCommands.front());
+		EXPECT_EQ(driver.FakeCVarManagerInstance->executedBatches(), _fakeCVarManager->executedBatches());
+		EXPECT_EQ(driver.RecordedBatches, _fakeCVarManager->executedBatches());
+	}
+
+	TEST_F(EventTraceReplayTests, replay_when_listChangedWhileRecording_will_replayChangedList)
+	{
+		auto changedList = FullTrainingProgramList;
+		changedList.TrainingProgramOrder.pop_back();
+		_recorder->start(TracePath);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->receiveListData(changedList);
+		_recorder->stop();
+
+		auto driver = EventTraceReplayDriver();
+		driver.replay(training::EventTrace::read(TracePath));
+
+		EXPECT_EQ(driver.FlowControl->getCurrentFlowData().TrainingPrograms.size(), changedList.TrainingProgramOrder.size());
+	}
+
+	// Replays every trace in the folder given by the RLTT_TRACE_FOLDER environment variable, e.g. traces which were recorded with rltt_trace_start.
+	// Every replay must execute exactly the commands which were executed while recording.
+	TEST_F(EventTraceReplayTests, replay_when_traceFolderIsConfigured_will_replayAllTraces)
+	{
+		const auto traceFolder = std::getenv("RLTT_TRACE_FOLDER");
+		if (traceFolder == nullptr)
+		{
+			GTEST_SKIP() << "RLTT_TRACE_FOLDER is not set";
+		}
+
+		size_t numberOfEntries = 0;
+		const auto replayStart = std::chrono::steady_clock::now();
+		for (const auto& file : std::filesystem::directory_iterator(traceFolder))
+		{
+			if (file.path().extension() != ".trace") { continue; }
+
+			auto driver = EventTraceReplayDriver();
+			auto entries = training::EventTrace::read(file.path());
+			driver.replay(entries);
+			EXPECT_EQ(driver.FakeCVarManagerInstance->executedBatches(), driver.RecordedBatches) << file.path();
+			numberOfEntries += entries.size();
+		}
+		const auto replayTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - replayStart);
+
+		RecordProperty("ReplayedEntries", (int)numberOfEntries);
+		RecordProperty("ReplayTimeInMilliseconds", (int)replayTime.count());
+	}
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <Plugin/configuration/control/FileChangeDetector.h>
+#include "../fakes/FakeFileChangeBackend.h"
+
+#include <fstream>
+#include <future>
+#include <random>
+#include <thread>
+
+namespace test
+{
+	class FileChangeDetectorTests : public testing::Test
+	{
+	public:
+		void SetUp() override
+		{
+			_fakeBackend = std::make_shared<FakeFileChangeBackend>();
+			_fakeBackend->writeExternally("initial");
+			sut = std::make_unique<configuration::FileChangeDetector>("trainingprogramlist.json", _fakeBackend);
+			sut->acknowledge("initial");
+			_fakeBackend->NumberOfReads = 0;
+		}
+
+	protected:
+		std::shared_ptr<FakeFileChangeBackend> _fakeBackend;
+		std::unique_ptr<configuration::FileChangeDetector> sut;
+	};
+
+	TEST_F(FileChangeDetectorTests, detectChange_when_fileWasNotModified_will_notReadFile)
+	{
+		auto change = sut->detectChange();
+
+		EXPECT_FALSE(change.has_value());
+		EXPECT_EQ(_fakeBackend->NumberOfReads, 0);
+	}
+
+	TEST_F(FileChangeDetectorTests, detectChange_when_backendReportsNoActivity_will_notReadFile)
+	{
+		_fakeBackend->writeExternally("changed");
+		_fakeBackend->MightHaveChanged = false;
+
+		auto change = sut->detectChange();
+
+		EXPECT_FALSE(change.has_value());
+		EXPECT_EQ(_fakeBackend->NumberOfReads, 0);
+	}
+
+	TEST_F(FileChangeDetectorTests, detectChange_when_fileWasChangedExternally_will_reportNewContentsOnce)
+	{
+		_fakeBackend->writeExternally("changed");
+
+		auto firstChange = sut->detectChange();
+		auto secondChange = sut->detectChange();
+
+		ASSERT_TRUE(firstChange.has_value());
+		EXPECT_EQ(firstChange.value(), "changed");
+		EXPECT_FALSE(secondChange.has_value());
+	}
+
+	TEST_F(FileChangeDetectorTests, detectChange_when_fileWasOnlyTouched_will_reportNothing)
+	{
+		_fakeBackend->touch();
+
+		auto change = sut->detectChange();
+
+		EXPECT_FALSE(change.has_value());
+		EXPECT_EQ(_fakeBackend->NumberOfReads, 1);
+	}
+
+	TEST_F(FileChangeDetectorTests, detectChange_when_ownWriteWasAcknowledged_will_reportNothing)
+	{
+		_fakeBackend->writeExternally("written by us");
+		sut->acknowledge("written by us");
+
+		auto change = sut->detectChange();
+
+		EXPECT_FALSE(change.has_value());
+		EXPECT_EQ(_fakeBackend->NumberOfReads, 0);
+	}
+
+	TEST_F(FileChangeDetectorTests, detectChange_when_calledWhileOwnWriteIsInProgress_will_reportNothing)
+	{
+		std::optional<std::string> changeDuringWrite;
+		sut->writeOwnChange("written by us", [this, &changeDuringWrite]() {
+			_fakeBackend->writeExternally("written by us");
+			changeDuringWrite = std::async(std::launch::async, [this]() { return sut->detectChange(); }).get(); // Like the game thread checking for changes
+		});
+		auto changeAfterWrite = sut->detectChange();
+
+		EXPECT_FALSE(changeDuringWrite.has_value());
+		EXPECT_FALSE(changeAfterWrite.has_value());
+		EXPECT_EQ(_fakeBackend->NumberOfReads, 0);
+	}
+
+	TEST(DirectoryNotificationFileChangeBackendTests, mightHaveChanged_when_fileInFolderWasWritten_will_returnTrue)
+	{
+		const auto folder = std::filesystem::temp_directory_path() / ("RLTrainingTimerWatchTest_" + std::to_string(std::random_device()()));
+		std::filesystem::create_directories(folder);
+		{
+			auto sut = configuration::DirectoryNotificationFileChangeBackend(folder);
+			std::ofstream{ folder / "trainingprogramlist.json" } << "changed";
+
+			// Notifications arrive asynchronously on some platforms
+			auto changeWasReported = false;
+			for (auto attempt = 0; attempt < 100 && !changeWasReported; attempt++)
+			{
+				changeWasReported = sut.mightHaveChanged();
+				if (!changeWasReported) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); }
+			}
+
+			EXPECT_TRUE(changeWasReported);
+		}
+		std::filesystem::remove_all(folder);
+	}
+}
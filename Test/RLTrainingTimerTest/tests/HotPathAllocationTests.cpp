@@ -0,0 +1,146 @@
+#include "../fixtures/TrainingProgramFlowTestFixture.h"
+#include "../fixtures/AllocationCounter.h"
+#include "../fakes/FakeCompletionTimeEstimator.h"
+
+#include <Plugin/training/ui/TrainingProgramDisplay/OverlayText.h>
+
+namespace test
+{
+	// Timer ticks and the overlay happen on every frame, so they must not allocate once a step is running.
+	// Everything which happens on the test thread gets counted, so the fakes must not allocate during a tick either.
+
+	const auto NumberOfFrames = 100;
+	const auto FrameTime = std::chrono::milliseconds(16);
+
+	TEST_F(TrainingProgramFlowTestFixture, numberOfAllocations_when_pluginCodeAllocates_will_countAllocations)
+	{
+		if (!AllocationCounter::CountsPluginAllocations) { GTEST_SKIP() << "Allocations of the plugin DLL can't be counted"; }
+
+		auto allocationCounter = AllocationCounter();
+		sut->receiveListData(FullTrainingProgramList); // Copies the whole list
+
+		EXPECT_GT(allocationCounter.numberOfAllocations(), 0);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, timerTick_when_timedStepIsRunning_will_notAllocate)
+	{
+		if (!AllocationCounter::CountsPluginAllocations) { GTEST_SKIP() << "Allocations of the plugin DLL can't be counted"; }
+		sut->setPreloadSettings(true, std::chrono::seconds(5));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto frameTime = _fakeTimeProvider->CurrentFakeTime;
+		sendTimerTick(frameTime += FrameTime); // Anything which gets determined once per step
+
+		auto allocationCounter = AllocationCounter();
+		for (auto frame = 0; frame < NumberOfFrames; frame++)
+		{
+			sendTimerTick(frameTime += FrameTime);
+		}
+
+		EXPECT_EQ(allocationCounter.numberOfAllocations(), 0);
+		EXPECT_LT(sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStep, OneMinuteFreeplayEntry.Duration);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, timerTick_when_estimatedStepIsRunning_will_notAllocate)
+	{
+		if (!AllocationCounter::CountsPluginAllocations) { GTEST_SKIP() << "Allocations of the plugin DLL can't be counted"; }
+		auto completionTimeEstimator = std::make_shared<FakeCompletionTimeEstimator>();
+		completionTimeEstimator->FakeCompletionTimes[{ MixedTrainingProgramId, 1 }] = std::chrono::minutes(3);
+		sut->setCompletionTimeEstimator(completionTimeEstimator);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(MixedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto frameTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(frameTime); // Activates the pack completion step
+		sendTimerTick(frameTime += FrameTime);
+
+		auto allocationCounter = AllocationCounter();
+		for (auto frame = 0; frame < NumberOfFrames; frame++)
+		{
+			sendTimerTick(frameTime += FrameTime);
+		}
+
+		EXPECT_EQ(allocationCounter.numberOfAllocations(), 0);
+		EXPECT_TRUE(sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStepIsEstimated);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, timerTick_when_programIsPaused_will_notAllocate)
+	{
+		if (!AllocationCounter::CountsPluginAllocations) { GTEST_SKIP() << "Allocations of the plugin DLL can't be counted"; }
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		sut->pauseTrainingProgram();
+		auto frameTime = _fakeTimeProvider->CurrentFakeTime;
+
+		auto allocationCounter = AllocationCounter();
+		for (auto frame = 0; frame < NumberOfFrames; frame++)
+		{
+			sendTimerTick(frameTime += FrameTime);
+		}
+
+		EXPECT_EQ(allocationCounter.numberOfAllocations(), 0);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, overlayText_when_stepIsRunning_will_notAllocate)
+	{
+		if (!AllocationCounter::CountsPluginAllocations) { GTEST_SKIP() << "Allocations of the plugin DLL can't be counted"; }
+		FullyTimedTrainingProgram.Name = std::string(100, 'P'); // Longer than anything which gets displayed
+		FullTrainingProgramList.TrainingProgramData.at(FullyTimedTrainingProgramId) = FullyTimedTrainingProgram;
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto frameTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration - std::chrono::seconds(3);
+		auto overlayText = training::OverlayText();
+
+		auto allocationCounter = AllocationCounter();
+		for (auto frame = 0; frame < NumberOfFrames; frame++)
+		{
+			sendTimerTick(frameTime += FrameTime);
+			overlayText.update(sut->getCurrentExecutionData());
+		}
+
+		EXPECT_EQ(allocationCounter.numberOfAllocations(), 0);
+		EXPECT_FALSE(overlayText.countdown().empty());
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, overlayText_when_namesAreTooLong_will_cutThemOff)
+	{
+		auto data = training::TrainingProgramExecutionData();
+		data.NumberOfSteps = 3;
+		data.TrainingStepNumber = 1;
+		data.TrainingProgramName = std::string(100, 'P');
+		data.TrainingStepName = std::string(100, 'S');
+		data.TrainingIsPaused = true;
+		data.TimeLeftInCurrentTrainingStep = std::chrono::seconds(75);
+		data.TrainingStepStartTime = _fakeTimeProvider->CurrentFakeTime;
+		auto overlayText = training::OverlayText();
+
+		overlayText.update(data);
+
+		EXPECT_EQ(overlayText.programName(), "PAUSED - " + std::string(31, 'P'));
+		EXPECT_EQ(overlayText.stepInfo(), "2 / 3: " + std::string(40, 'S'));
+		EXPECT_EQ(overlayText.remainingStepTime(), "Next: 1m 15s");
+		EXPECT_EQ(overlayText.compactInfo(), "2 / 3    " + std::string(40, 'S') + "    1m 15s");
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, overlayText_when_stepIsUntimed_will_notShowStepTime)
+	{
+		auto data = training::TrainingProgramExecutionData();
+		data.NumberOfSteps = 1;
+		data.TrainingStepName = "Pack";
+		data.ProgramHasUntimedSteps = true;
+		data.CurrentStepIsUntimed = true;
+		data.NextStepPrompt = "Get ready: Next";
+		data.TrainingStepStartTime = _fakeTimeProvider->CurrentFakeTime;
+		auto overlayText = training::OverlayText();
+
+		overlayText.update(data);
+
+		EXPECT_EQ(overlayText.remainingStepTime(), "Next: On End");
+		EXPECT_TRUE(overlayText.remainingProgramTime().empty());
+		EXPECT_TRUE(overlayText.countdown().empty());
+		EXPECT_EQ(overlayText.compactInfo(), "1 / 1    Pack    -    Get ready: Next");
+	}
+}
@@ -0,0 +1,103 @@
+#include "../fixtures/TrainingProgramFlowTestFixture.h"
+
+#include <Plugin/training/control/LoadedMapTracker.h>
+
+namespace test
+{
+	const std::string TrackerFreeplayCommand = "load_freeplay";
+	const std::string TrackerTrainingCommand = "load_training ABC123";
+	const auto TrackerStartTime = std::chrono::steady_clock::time_point{};
+
+	TEST(LoadedMapTrackerTests, loadIsNecessary_when_targetIsLoaded_will_suppressCommand)
+	{
+		training::LoadedMapTracker tracker;
+		ASSERT_TRUE(tracker.loadIsNecessary(TrackerFreeplayCommand, TrackerStartTime));
+		tracker.handleLoadCommandIssued(TrackerFreeplayCommand, TrackerStartTime);
+		tracker.handleMapLoadStart(TrackerStartTime);
+		tracker.handleMapLoadEnd();
+
+		EXPECT_FALSE(tracker.loadIsNecessary(TrackerFreeplayCommand, TrackerStartTime));
+		EXPECT_TRUE(tracker.loadIsNecessary(TrackerTrainingCommand, TrackerStartTime));
+		EXPECT_EQ(tracker.counters().IssuedCommands, 2);
+		EXPECT_EQ(tracker.counters().SuppressedCommands, 1);
+	}
+
+	TEST(LoadedMapTrackerTests, loadIsNecessary_when_playerLoadedOtherMap_will_notSuppressCommand)
+	{
+		training::LoadedMapTracker tracker;
+		tracker.handleLoadCommandIssued(TrackerFreeplayCommand, TrackerStartTime);
+		tracker.handleMapLoadStart(TrackerStartTime);
+		tracker.handleMapLoadEnd();
+
+		tracker.handleMapLoadStart(TrackerStartTime); // Not caused by us
+		tracker.handleMapLoadEnd();
+
+		EXPECT_FALSE(tracker.currentTarget().has_value());
+		EXPECT_TRUE(tracker.loadIsNecessary(TrackerFreeplayCommand, TrackerStartTime));
+	}
+
+	TEST(LoadedMapTrackerTests, loadIsNecessary_when_trainingEnded_will_loadPackAgain)
+	{
+		training::LoadedMapTracker tracker;
+		tracker.handleLoadCommandIssued(TrackerTrainingCommand, TrackerStartTime);
+		tracker.handleMapLoadEnd();
+		tracker.handleTrainingEnd();
+
+		EXPECT_TRUE(tracker.loadIsNecessary(TrackerTrainingCommand, TrackerStartTime));
+	}
+
+	TEST(LoadedMapTrackerTests, loadIsNecessary_when_requestedLoadNeverStarted_will_forgetCommand)
+	{
+		training::LoadedMapTracker tracker;
+		tracker.handleLoadCommandIssued(TrackerFreeplayCommand, TrackerStartTime);
+		ASSERT_FALSE(tracker.loadIsNecessary(TrackerFreeplayCommand, TrackerStartTime));
+
+		auto later = TrackerStartTime + training::LoadedMapTracker::LoadStartTimeout + std::chrono::seconds(1);
+		EXPECT_TRUE(tracker.loadIsNecessary(TrackerFreeplayCommand, later));
+
+		tracker.handleMapLoadStart(later); // Not caused by us
+		tracker.handleMapLoadEnd();
+		EXPECT_FALSE(tracker.currentTarget().has_value());
+	}
+
+	TEST(LoadedMapTrackerTests, handleMapLoadEnd_when_loadTookLongerThanTimeout_will_rememberTarget)
+	{
+		training::LoadedMapTracker tracker;
+		tracker.handleLoadCommandIssued(TrackerFreeplayCommand, TrackerStartTime);
+		tracker.handleMapLoadStart(TrackerStartTime + std::chrono::seconds(1));
+		tracker.handleMapLoadEnd();
+
+		auto later = TrackerStartTime + training::LoadedMapTracker::LoadStartTimeout * 3;
+		EXPECT_FALSE(tracker.loadIsNecessary(TrackerFreeplayCommand, later));
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, activateNextTrainingProgramStep_when_nextStepUsesSamePack_will_notLoadPackAgain)
+	{
+		configuration::TrainingProgramEntry timedPackEntry;
+		timedPackEntry.Type = configuration::TrainingProgramEntryType::CustomTraining;
+		timedPackEntry.TimeMode = configuration::TrainingProgramCompletionMode::Timed;
+		timedPackEntry.TrainingPackCode = DummyTrainingPackCode;
+		timedPackEntry.Duration = std::chrono::minutes(1);
+
+		configuration::TrainingProgramData program;
+		program.Id = "SamePackTwice";
+		program.Duration = timedPackEntry.Duration * 2;
+		program.Entries = { timedPackEntry, timedPackEntry };
+		configuration::TrainingProgramListData list;
+		list.TrainingProgramData.try_emplace(program.Id, program);
+		list.TrainingProgramOrder.push_back(program.Id);
+
+		sut->receiveListData(list);
+		sut->selectTrainingProgram(program.Id);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+		startMapLoad(startTime);
+		finishMapLoad(startTime);
+		sendTimerTick(startTime + timedPackEntry.Duration);
+
+		EXPECT_EQ(sut->getCurrentExecutionData().TrainingStepNumber, 1);
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), 1);
+		EXPECT_EQ(sut->getLoadCommandCounters().IssuedCommands, 1);
+		EXPECT_EQ(sut->getLoadCommandCounters().SuppressedCommands, 1);
+	}
+}
@@ -0,0 +1,129 @@
+#include "../fixtures/TrainingProgramFlowTestFixture.h"
+
+#include <Plugin/training/control/LoadTimeEstimator.h>
+
+namespace test
+{
+	const std::string ExpectedWorkshopLoadCommand = "load_workshop \"C:\\Temp\\Workshop\\FancyMap\\FancyMap.upk\"";
+
+	TEST_F(TrainingProgramFlowTestFixture, preload_when_notEnabled_will_loadMapWhenStepStarts)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto secondStepStartTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(secondStepStartTime);
+
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(1));
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), 1); // load_freeplay only
+
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration);
+		EXPECT_EQ(_fakeCVarManager->lastCommand(), ExpectedWorkshopLoadCommand);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, preload_when_leadTimeIsReached_will_loadNextMapOnlyOnce)
+	{
+		sut->setPreloadSettings(true, std::chrono::seconds(5));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto secondStepStartTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(secondStepStartTime);
+
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(6));
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), 1);
+
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(4));
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), 2);
+		EXPECT_EQ(_fakeCVarManager->lastCommand(), ExpectedWorkshopLoadCommand);
+
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(2));
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration);
+		EXPECT_EQ(sut->getCurrentExecutionData().TrainingStepNumber, 2);
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), 2);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, preload_when_loadTimeWasMeasured_will_useMeasuredLoadTime)
+	{
+		sut->setPreloadSettings(true, std::chrono::seconds(5));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+
+		// First run: The workshop map takes ten seconds to load
+		sut->startSelectedTrainingProgram();
+		auto secondStepStartTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(secondStepStartTime);
+		auto preloadTime = secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(5);
+		sendTimerTick(preloadTime);
+		ASSERT_EQ(_fakeCVarManager->lastCommand(), ExpectedWorkshopLoadCommand);
+		startMapLoad(preloadTime);
+		finishMapLoad(preloadTime + std::chrono::seconds(10));
+		sut->stopRunningTrainingProgram();
+
+		// Second run: The load shall be started early enough
+		sut->startSelectedTrainingProgram();
+		secondStepStartTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(secondStepStartTime);
+		auto numberOfCommands = _fakeCVarManager->executedCommands().size();
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(12));
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), numberOfCommands);
+		sendTimerTick(secondStepStartTime + TwoMinuteDefaultEntry.Duration - std::chrono::seconds(10)); // Ten seconds plus the minimum safety margin
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), numberOfCommands + 1);
+		EXPECT_EQ(_fakeCVarManager->lastCommand(), ExpectedWorkshopLoadCommand);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, preload_when_nextStepRequiresCompletingPack_will_onlyAnnounceStep)
+	{
+		sut->setPreloadSettings(true, std::chrono::seconds(5));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(MixedTrainingProgramId); // Freeplay followed by a pack
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		sendTimerTick(startTime + OneMinuteFreeplayEntry.Duration - std::chrono::seconds(4));
+		EXPECT_EQ(sut->getCurrentExecutionData().NextStepPrompt, "Get ready: PackCompletionEntry");
+		EXPECT_EQ(_fakeCVarManager->lastCommand(), "load_freeplay");
+
+		sendTimerTick(startTime + OneMinuteFreeplayEntry.Duration);
+		EXPECT_TRUE(sut->getCurrentExecutionData().NextStepPrompt.empty());
+		EXPECT_EQ(_fakeCVarManager->lastCommand(), "load_training " + DummyTrainingPackCode);
+	}
+
+	const std::string EstimatorLoadCommand = "load_training ABC123";
+
+	TEST(LoadTimeEstimatorTests, estimateLeadTime_when_notMeasured_will_returnConfiguredLeadTime)
+	{
+		training::LoadTimeEstimator estimator;
+		EXPECT_EQ(estimator.estimateLeadTime(EstimatorLoadCommand, std::chrono::seconds(5)), std::chrono::seconds(5));
+	}
+
+	TEST(LoadTimeEstimatorTests, estimateLeadTime_when_loadTimesAreStable_will_addMinimumSafetyMargin)
+	{
+		training::LoadTimeEstimator estimator;
+		estimator.recordLoadTime(EstimatorLoadCommand, std::chrono::seconds(8));
+		estimator.recordLoadTime(EstimatorLoadCommand, std::chrono::seconds(8));
+
+		EXPECT_EQ(estimator.estimateLeadTime(EstimatorLoadCommand, std::chrono::seconds(5)), std::chrono::seconds(9));
+	}
+
+	TEST(LoadTimeEstimatorTests, estimateLeadTime_when_loadTimesVary_will_addLargerSafetyMargin)
+	{
+		training::LoadTimeEstimator estimator;
+		estimator.recordLoadTime(EstimatorLoadCommand, std::chrono::seconds(4));
+		estimator.recordLoadTime(EstimatorLoadCommand, std::chrono::seconds(8));
+
+		// Average 5.2s, variance 0.7 * 0.3 * 16s² = 3.36s², so the margin is two standard deviations (about 3.67s)
+		auto leadTime = estimator.estimateLeadTime(EstimatorLoadCommand, std::chrono::seconds(10));
+		EXPECT_GT(leadTime, std::chrono::milliseconds(8800));
+		EXPECT_LT(leadTime, std::chrono::milliseconds(8900));
+	}
+
+	TEST(LoadTimeEstimatorTests, estimateLeadTime_when_loadTimesVaryStrongly_will_limitSafetyMarginToConfiguredLeadTime)
+	{
+		training::LoadTimeEstimator estimator;
+		estimator.recordLoadTime(EstimatorLoadCommand, std::chrono::seconds(2));
+		estimator.recordLoadTime(EstimatorLoadCommand, std::chrono::seconds(30));
+
+		EXPECT_EQ(estimator.estimateLeadTime(EstimatorLoadCommand, std::chrono::seconds(3)), std::chrono::milliseconds(10400) + std::chrono::seconds(3));
+	}
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/diagnostics/PerformanceCounters.h>
+
+namespace test
+{
+	using diagnostics::PerformanceCounter;
+	using diagnostics::PerformanceCounters;
+
+	class PerformanceCountersTests : public ::testing::Test
+	{
+	protected:
+		void SetUp() override { PerformanceCounters::reset(); }
+		void TearDown() override { PerformanceCounters::reset(); }
+
+		static diagnostics::PerformanceCounterSnapshot snapshotOf(PerformanceCounter counter)
+		{
+			return PerformanceCounters::snapshot().at((size_t)counter);
+		}
+	};
+
+	TEST_F(PerformanceCountersTests, snapshot_when_nothingWasRecorded_will_containEmptyCounters)
+	{
+		const auto snapshots = PerformanceCounters::snapshot();
+
+		ASSERT_EQ(snapshots.size(), (size_t)PerformanceCounter::NumberOfCounters);
+		for (size_t index = 0; index < snapshots.size(); index++)
+		{
+			EXPECT_EQ(snapshots[index].Counter, (PerformanceCounter)index);
+			EXPECT_EQ(snapshots[index].Count, 0);
+			EXPECT_EQ(snapshots[index].TotalNanoseconds, 0);
+		}
+		EXPECT_TRUE(PerformanceCounters::format().empty());
+	}
+
+	TEST_F(PerformanceCountersTests, record_when_calledSeveralTimes_will_sumUpMeasurements)
+	{
+		for (uint64_t nanoseconds = 1; nanoseconds <= 100; nanoseconds++)
+		{
+			PerformanceCounters::record(PerformanceCounter::HandleTimerTick, nanoseconds);
+		}
+		PerformanceCounters::record(PerformanceCounter::HandleTimerTick, 5000);
+
+		const auto snapshot = snapshotOf(PerformanceCounter::HandleTimerTick);
+		EXPECT_EQ(snapshot.Count, 101);
+		EXPECT_EQ(snapshot.TotalNanoseconds, 5050 + 5000);
+		EXPECT_EQ(snapshot.MaximumNanoseconds, 5000);
+		EXPECT_EQ(snapshotOf(PerformanceCounter::RepositoryStore).Count, 0);
+	}
+
+	TEST_F(PerformanceCountersTests, snapshot_when_measurementsWereRecorded_will_reportPercentileUpperBounds)
+	{
+		for (int repetition = 0; repetition < 99; repetition++)
+		{
+			PerformanceCounters::record(PerformanceCounter::NotifyReceivers, 100);
+		}
+		PerformanceCounters::record(PerformanceCounter::NotifyReceivers, 1'000'000);
+
+		const auto snapshot = snapshotOf(PerformanceCounter::NotifyReceivers);
+		// 100ns has 7 significant bits, so it ends up in the bucket for [64, 127]
+		EXPECT_GE(snapshot.Percentile50Nanoseconds, 100);
+		EXPECT_LE(snapshot.Percentile50Nanoseconds, 127);
+		EXPECT_GE(snapshot.Percentile99Nanoseconds, 1'000'000);
+		EXPECT_LE(snapshot.Percentile99Nanoseconds, snapshot.MaximumNanoseconds);
+	}
+
+	TEST_F(PerformanceCountersTests, format_when_measurementsWereRecorded_will_listOnlyRecordedCounters)
+	{
+		PerformanceCounters::record(PerformanceCounter::RepositoryRestore, 2'000'000);
+
+		const auto lines = PerformanceCounters::format();
+
+		ASSERT_EQ(lines.size(), 1);
+		EXPECT_EQ(lines.front().rfind(PerformanceCounters::name(PerformanceCounter::RepositoryRestore), 0), 0);
+		EXPECT_NE(lines.front().find("1 calls"), std::string::npos);
+	}
+
+	TEST_F(PerformanceCountersTests, reset_when_measurementsWereRecorded_will_clearAllCounters)
+	{
+		PerformanceCounters::record(PerformanceCounter::InjectionParsing, 42);
+
+		PerformanceCounters::reset();
+
+		const auto snapshot = snapshotOf(PerformanceCounter::InjectionParsing);
+		EXPECT_EQ(snapshot.Count, 0);
+		EXPECT_EQ(snapshot.TotalNanoseconds, 0);
+		EXPECT_EQ(snapshot.MaximumNanoseconds, 0);
+	}
+
+#ifndef RLTT_DISABLE_PERFORMANCE_COUNTERS
+	TEST_F(PerformanceCountersTests, performanceScope_when_leavingScope_will_recordOneMeasurement)
+	{
+		{
+			RLTT_PERFORMANCE_SCOPE(PerformanceCounter::TrainingWindowRender);
+			RLTT_PERFORMANCE_SCOPE(PerformanceCounter::SettingsWindowRender);
+		}
+
+		EXPECT_EQ(snapshotOf(PerformanceCounter::TrainingWindowRender).Count, 1);
+		EXPECT_EQ(snapshotOf(PerformanceCounter::SettingsWindowRender).Count, 1);
+	}
+#endif
+}
@@ -0,0 +1,270 @@
+#include "../fixtures/TrainingProgramFlowTestFixture.h"
+#include "../fakes/FakeSessionEventReceiver.h"
+
+#include <Plugin/history/SessionHistoryWriter.h>
+#include <Plugin/history/SessionHistoryReader.h>
+#include <Plugin/history/SessionHistoryRecorder.h>
+#include <Plugin/statistics/TrainingStatistics.h>
+
+#include <fstream>
+#include <random>
+
+namespace test
+{
+	class SessionHistoryTests : public testing::Test
+	{
+	public:
+		void SetUp() override
+		{
+			HistoryFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerHistoryTest_" + std::to_string(std::random_device()()));
+			HistoryPath = HistoryFolder / "session_history.bin";
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(HistoryFolder);
+		}
+
+	protected:
+		static history::SessionRecord createRecord(uint16_t stepNumber)
+		{
+			auto record = history::SessionRecord();
+			record.Timestamp = 1000 + stepNumber;
+			record.SequenceNumber = 1 + stepNumber;
+			record.StepNumber = stepNumber;
+			record.EventType = (uint8_t)training::SessionEventType::StepStarted;
+			return record;
+		}
+
+		std::filesystem::path HistoryFolder;
+		std::filesystem::path HistoryPath;
+	};
+
+	TEST_F(SessionHistoryTests, readAll_when_recordsWereAppended_will_returnRecordsInOrder)
+	{
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			for (uint16_t stepNumber = 0; stepNumber < 100; stepNumber++)
+			{
+				writer.append(createRecord(stepNumber));
+			}
+		} // The destructor writes pending records
+
+		auto records = history::SessionHistoryReader(HistoryPath).readAll();
+
+		ASSERT_EQ(records.size(), 100);
+		EXPECT_EQ(records[0].StepNumber, 0);
+		EXPECT_EQ(records[99].StepNumber, 99);
+		EXPECT_EQ(records[99].Timestamp, 1099);
+	}
+
+	TEST_F(SessionHistoryTests, append_when_fileExceedsMaximumSize_will_rotateFiles)
+	{
+		const auto recordsPerFile = 10;
+		history::SessionHistoryWriter writer(HistoryPath, history::SessionHistoryFileMagic.size() + recordsPerFile * sizeof(history::SessionRecord), 2);
+		for (uint16_t stepNumber = 0; stepNumber < 4 * recordsPerFile; stepNumber++)
+		{
+			writer.append(createRecord(stepNumber));
+			writer.flush();
+		}
+
+		EXPECT_TRUE(std::filesystem::exists(history::rotatedHistoryPath(HistoryPath, 2)));
+		EXPECT_FALSE(std::filesystem::exists(history::rotatedHistoryPath(HistoryPath, 3)));
+
+		// The oldest file has been dropped
+		auto records = history::SessionHistoryReader(HistoryPath, 2).readAll();
+		ASSERT_EQ(records.size(), 3 * recordsPerFile);
+		EXPECT_EQ(records.front().StepNumber, recordsPerFile);
+		EXPECT_EQ(records.back().StepNumber, 4 * recordsPerFile - 1);
+	}
+
+	TEST_F(SessionHistoryTests, readFile_when_lastRecordIsIncomplete_will_ignoreIt)
+	{
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			writer.append(createRecord(1));
+			writer.append(createRecord(2));
+		}
+		std::filesystem::resize_file(HistoryPath, std::filesystem::file_size(HistoryPath) - 5);
+
+		auto records = history::SessionHistoryReader::readFile(HistoryPath);
+
+		ASSERT_EQ(records.size(), 1);
+		EXPECT_EQ(records[0].StepNumber, 1);
+	}
+
+	TEST_F(SessionHistoryTests, append_when_lastRecordIsIncomplete_will_replaceIt)
+	{
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			writer.append(createRecord(1));
+			writer.append(createRecord(2));
+		}
+		std::filesystem::resize_file(HistoryPath, std::filesystem::file_size(HistoryPath) - 5);
+
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			writer.append(createRecord(3));
+		}
+		auto records = history::SessionHistoryReader::readFile(HistoryPath);
+
+		ASSERT_EQ(records.size(), 2);
+		EXPECT_EQ(records[0].StepNumber, 1);
+		EXPECT_EQ(records[1].StepNumber, 3);
+		EXPECT_EQ(records[1].Timestamp, 1003);
+	}
+
+	TEST_F(SessionHistoryTests, readFile_when_fileIsNoSessionHistory_will_returnNothing)
+	{
+		std::filesystem::create_directories(HistoryFolder);
+		std::ofstream{ HistoryPath } << "{ \"this\": \"is json\", \"and\": \"not a history\" }";
+
+		EXPECT_TRUE(history::SessionHistoryReader::readFile(HistoryPath).empty());
+	}
+
+	TEST_F(SessionHistoryTests, append_when_fileHasOlderFormat_will_startNewFile)
+	{
+		std::filesystem::create_directories(HistoryFolder);
+		std::ofstream{ HistoryPath, std::ios::binary } << "RLTTHIS1" << std::string(24, '\0');
+
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			writer.append(createRecord(7));
+		}
+		auto records = history::SessionHistoryReader(HistoryPath).readAll();
+
+		ASSERT_EQ(records.size(), 1);
+		EXPECT_EQ(records[0].StepNumber, 7);
+		EXPECT_TRUE(std::filesystem::exists(history::rotatedHistoryPath(HistoryPath, 1)));
+	}
+
+	TEST_F(SessionHistoryTests, readAfter_when_filesWereRotated_will_returnRecordsAfterSequenceNumber)
+	{
+		const auto recordsPerFile = 10;
+		{
+			history::SessionHistoryWriter writer(HistoryPath, history::SessionHistoryFileMagic.size() + recordsPerFile * sizeof(history::SessionRecord));
+			for (uint16_t stepNumber = 0; stepNumber < 3 * recordsPerFile; stepNumber++)
+			{
+				writer.append(createRecord(stepNumber));
+				writer.flush();
+			}
+		}
+		const auto reader = history::SessionHistoryReader(HistoryPath);
+
+		auto records = reader.readAfter(15);
+
+		ASSERT_EQ(records.size(), 15);
+		EXPECT_EQ(records.front().SequenceNumber, 16);
+		EXPECT_EQ(records.back().SequenceNumber, 30);
+		ASSERT_TRUE(reader.readLastRecord().has_value());
+		EXPECT_EQ(reader.readLastRecord()->SequenceNumber, 30);
+	}
+
+	TEST_F(SessionHistoryTests, receiveSessionEvent_when_historyExists_will_continueSequenceNumbers)
+	{
+		const auto trainingProgramId = std::string("4f1c2e5a-0000-4000-8000-000000000001");
+		const auto sessionEvent = training::SessionEvent{ training::SessionEventType::StepStarted, trainingProgramId };
+		{
+			history::SessionHistoryRecorder recorder(HistoryPath);
+			recorder.receiveSessionEvent(sessionEvent);
+			recorder.receiveSessionEvent(sessionEvent);
+		}
+
+		auto trainingStatistics = std::make_shared<statistics::TrainingStatistics>(HistoryFolder / "statistics.json");
+		{
+			history::SessionHistoryRecorder recorder(HistoryPath);
+			recorder.registerSessionRecordReceiver(trainingStatistics);
+			recorder.receiveSessionEvent(sessionEvent);
+		}
+		auto records = history::SessionHistoryReader(HistoryPath).readAll();
+
+		ASSERT_EQ(records.size(), 3);
+		EXPECT_EQ(records[0].SequenceNumber, 1);
+		EXPECT_EQ(records[2].SequenceNumber, 3);
+		ASSERT_TRUE(trainingStatistics->getProgramStatistics(trainingProgramId).has_value()); // Received the same record
+		EXPECT_EQ(trainingStatistics->getProgramStatistics(trainingProgramId)->Steps[0].TimesStarted, 1);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, sessionEvents_when_programIsExecuted_will_reportEverythingThatHappened)
+	{
+		auto receiver = std::make_shared<FakeSessionEventReceiver>();
+		sut->registerSessionEventReceiver(receiver);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(10);
+		pauseGame();
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(15);
+		resumeGame();
+		sendTimerTick(startTime + OneMinuteFreeplayEntry.Duration + std::chrono::seconds(5));
+		sut->skipTrainingProgramStep();
+		sendTimerTick(_fakeTimeProvider->CurrentFakeTime + OneMinuteWorkshopEntry.Duration);
+
+		using training::SessionEventType;
+		EXPECT_EQ(receiver->ReceivedEventTypes, std::vector<SessionEventType>({
+			SessionEventType::ProgramStarted,
+			SessionEventType::StepStarted,
+			SessionEventType::PauseStarted,
+			SessionEventType::PauseEnded,
+			SessionEventType::StepEnded,
+			SessionEventType::StepStarted,
+			SessionEventType::StepSkipped,
+			SessionEventType::StepEnded,
+			SessionEventType::StepStarted,
+			SessionEventType::StepEnded,
+			SessionEventType::ProgramFinished }));
+		EXPECT_EQ(receiver->ReceivedEvents[3].Duration, std::chrono::seconds(5)); // Pause
+		EXPECT_EQ(receiver->ReceivedEvents[4].Duration, OneMinuteFreeplayEntry.Duration); // First step without the pause
+		EXPECT_EQ(receiver->ReceivedEvents[4].StepNumber, 0);
+		EXPECT_EQ(receiver->ReceivedEvents[10].StepNumber, 2);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, sessionEvents_when_mapIsLoading_will_notReportPause)
+	{
+		auto receiver = std::make_shared<FakeSessionEventReceiver>();
+		sut->registerSessionEventReceiver(receiver);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		startMapLoad(startTime);
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(2);
+		pauseGame();
+		finishMapLoad(startTime + std::chrono::seconds(5));
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(8);
+		resumeGame();
+
+		using training::SessionEventType;
+		EXPECT_EQ(receiver->ReceivedEventTypes, std::vector<SessionEventType>({
+			SessionEventType::ProgramStarted,
+			SessionEventType::StepStarted,
+			SessionEventType::MapLoadStarted,
+			SessionEventType::PauseStarted,
+			SessionEventType::MapLoadEnded,
+			SessionEventType::PauseEnded }));
+		EXPECT_EQ(receiver->ReceivedEvents[4].Duration, std::chrono::seconds(5)); // Map load
+		EXPECT_EQ(receiver->ReceivedEvents[5].Duration, std::chrono::seconds(6)); // Pause
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, sessionEvents_when_timePasses_will_useTimestampsOfTimeProvider)
+	{
+		auto receiver = std::make_shared<FakeSessionEventReceiver>();
+		sut->registerSessionEventReceiver(receiver);
+		_fakeTimeProvider->FakeDateTimeAtStart = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+		auto startTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(_fakeTimeProvider->currentDateTime().time_since_epoch()).count();
+
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(10);
+		pauseGame();
+
+		ASSERT_EQ(receiver->ReceivedEvents.size(), 3);
+		EXPECT_EQ(receiver->ReceivedEvents[0].Timestamp, startTimestamp);
+		EXPECT_EQ(receiver->ReceivedEvents[2].Timestamp, startTimestamp + 10000);
+	}
+}
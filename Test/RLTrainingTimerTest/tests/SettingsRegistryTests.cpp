@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "../fakes/FakeCVarManager.h"
+
+#include <Plugin/settings/TrainingTimerSettings.h>
+
+namespace test
+{
+	using settings::BarStyle;
+	using settings::BarStyleSetting;
+	using settings::PreloadEnabledSetting;
+	using settings::PreloadLeadTimeSetting;
+	using settings::PreStepCommandsSetting;
+
+	struct OpacitySetting
+	{
+		using ValueType = float;
+		static constexpr const char* CvarName = "RLTrainingTimerTest_opacity";
+		static constexpr const char* Description = "";
+		static constexpr float DefaultValue = 1.0f;
+		static constexpr float Minimum = 0.0f;
+		static constexpr float Maximum = 1.0f;
+	};
+
+	struct ColorSetting
+	{
+		using ValueType = settings::Color;
+		static constexpr const char* CvarName = "RLTrainingTimerTest_color";
+		static constexpr const char* Description = "";
+		static constexpr settings::Color DefaultValue = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+	using TestSettings = settings::SettingsRegistry<BarStyleSetting, PreloadEnabledSetting, PreloadLeadTimeSetting, OpacitySetting, ColorSetting>;
+
+	class SettingsRegistryTests : public testing::Test
+	{
+	protected:
+		std::shared_ptr<FakeCVarManager> CVarManager = std::make_shared<FakeCVarManager>();
+		TestSettings Settings{ CVarManager };
+	};
+
+	TEST_F(SettingsRegistryTests, get_when_nothingWasLoaded_will_returnDefaultValues)
+	{
+		EXPECT_EQ(Settings.get<BarStyleSetting>(), BarStyle::Minimal);
+		EXPECT_FALSE(Settings.get<PreloadEnabledSetting>());
+		EXPECT_EQ(Settings.get<PreloadLeadTimeSetting>(), 5);
+		EXPECT_EQ(Settings.get<OpacitySetting>(), 1.0f);
+	}
+
+	TEST_F(SettingsRegistryTests, loadFromCvars_when_cvarsContainValues_will_parseThem)
+	{
+		CVarManager->FakeCvarValues[BarStyleSetting::CvarName] = "blue bar (more visible)";
+		CVarManager->FakeCvarValues[PreloadEnabledSetting::CvarName] = "1";
+		CVarManager->FakeCvarValues[PreloadLeadTimeSetting::CvarName] = "12.000000";
+		CVarManager->FakeCvarValues[OpacitySetting::CvarName] = "0.25";
+		CVarManager->FakeCvarValues[ColorSetting::CvarName] = "#FF000080";
+
+		Settings.loadFromCvars();
+
+		EXPECT_EQ(Settings.get<BarStyleSetting>(), BarStyle::BlueBar);
+		EXPECT_TRUE(Settings.get<PreloadEnabledSetting>());
+		EXPECT_EQ(Settings.get<PreloadLeadTimeSetting>(), 12);
+		EXPECT_EQ(Settings.get<OpacitySetting>(), 0.25f);
+		EXPECT_EQ(Settings.get<ColorSetting>(), (settings::Color{ 1.0f, 0.0f, 0.0f, 128 / 255.0f }));
+	}
+
+	TEST_F(SettingsRegistryTests, receiveCvarValue_when_valueIsInvalid_will_keepCurrentValue)
+	{
+		Settings.set<BarStyleSetting>(BarStyle::Hidden);
+
+		EXPECT_FALSE(Settings.receiveCvarValue<BarStyleSetting>("minimal"));
+		EXPECT_FALSE(Settings.receiveCvarValue<PreloadLeadTimeSetting>("soon"));
+		EXPECT_FALSE(Settings.receiveCvarValue<ColorSetting>("#12345"));
+
+		EXPECT_EQ(Settings.get<BarStyleSetting>(), BarStyle::Hidden);
+		EXPECT_EQ(Settings.get<PreloadLeadTimeSetting>(), 5);
+		EXPECT_EQ(Settings.get<ColorSetting>(), ColorSetting::DefaultValue);
+	}
+
+	TEST_F(SettingsRegistryTests, receiveCvarValue_when_numberIsOutOfRange_will_clampIt)
+	{
+		EXPECT_TRUE(Settings.receiveCvarValue<PreloadLeadTimeSetting>("100"));
+		EXPECT_TRUE(Settings.receiveCvarValue<OpacitySetting>("-1"));
+
+		EXPECT_EQ(Settings.get<PreloadLeadTimeSetting>(), PreloadLeadTimeSetting::Maximum);
+		EXPECT_EQ(Settings.get<OpacitySetting>(), OpacitySetting::Minimum);
+	}
+
+	TEST_F(SettingsRegistryTests, set_when_valueChanges_will_updateCvarAndNotifySubscribers)
+	{
+		std::vector<BarStyle> notifiedValues;
+		Settings.subscribe<BarStyleSetting>([&notifiedValues](const BarStyle& barStyle) { notifiedValues.push_back(barStyle); });
+
+		Settings.set<BarStyleSetting>(BarStyle::BlueBar);
+		Settings.set<BarStyleSetting>(BarStyle::BlueBar); // No change
+		Settings.receiveCvarValue<BarStyleSetting>("blue bar (more visible)"); // The cvar notification of the change above
+
+		EXPECT_EQ(CVarManager->getCvarValue(BarStyleSetting::CvarName), "blue bar (more visible)");
+		EXPECT_EQ(notifiedValues, std::vector<BarStyle>{ BarStyle::BlueBar });
+	}
+
+	TEST_F(SettingsRegistryTests, receiveCvarValue_when_cvarWasChangedInConsole_will_notifySubscribers)
+	{
+		std::vector<int> notifiedValues;
+		Settings.subscribe<PreloadLeadTimeSetting>([&notifiedValues](const int& leadTime) { notifiedValues.push_back(leadTime); });
+
+		Settings.receiveCvarValue<PreloadLeadTimeSetting>("7");
+
+		EXPECT_EQ(notifiedValues, std::vector<int>{ 7 });
+		EXPECT_TRUE(CVarManager->FakeCvarValues.empty()); // The cvar has the value already
+	}
+
+	TEST_F(SettingsRegistryTests, receiveCvarValue_when_settingIsText_will_keepTextUnchanged)
+	{
+		auto trainingTimerSettings = settings::TrainingTimerSettings(CVarManager);
+		EXPECT_EQ(trainingTimerSettings.get<PreStepCommandsSetting>(), "");
+
+		EXPECT_TRUE(trainingTimerSettings.receiveCvarValue<PreStepCommandsSetting>(" sv_soccar_gamespeed 1; ;"));
+		EXPECT_EQ(trainingTimerSettings.get<PreStepCommandsSetting>(), " sv_soccar_gamespeed 1; ;");
+
+		trainingTimerSettings.set<PreStepCommandsSetting>("cl_goalreplay_pov 0");
+		EXPECT_EQ(CVarManager->getCvarValue(PreStepCommandsSetting::CvarName), "cl_goalreplay_pov 0");
+	}
+
+	TEST_F(SettingsRegistryTests, formatValue_when_parsedAgain_will_returnSameValue)
+	{
+		const auto color = settings::Color{ 0.2f, 0.4f, 0.6f, 1.0f };
+		const auto text = TestSettings::formatValue<ColorSetting>(color);
+		EXPECT_EQ(text, "#336699FF");
+		EXPECT_EQ(TestSettings::parseValue<ColorSetting>(text), color);
+
+		EXPECT_EQ(TestSettings::parseValue<OpacitySetting>(TestSettings::formatValue<OpacitySetting>(0.3f)), 0.3f);
+		EXPECT_EQ(TestSettings::formatValue<BarStyleSetting>(BarStyle::Hidden), "none (hide)");
+		EXPECT_EQ(TestSettings::formatValue<PreloadEnabledSetting>(true), "1");
+	}
+
+	TEST_F(SettingsRegistryTests, forEachSetting_when_called_will_visitEverySettingOnce)
+	{
+		std::vector<std::string> cvarNames;
+		TestSettings::forEachSetting([&cvarNames](auto setting) { cvarNames.push_back(decltype(setting)::CvarName); });
+
+		EXPECT_EQ(cvarNames, (std::vector<std::string>{
+			BarStyleSetting::CvarName, PreloadEnabledSetting::CvarName, PreloadLeadTimeSetting::CvarName, OpacitySetting::CvarName, ColorSetting::CvarName }));
+	}
+}
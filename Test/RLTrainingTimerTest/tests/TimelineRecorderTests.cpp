@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/diagnostics/TimelineRecorder.h>
+#include <Plugin/diagnostics/PerformanceCounters.h>
+#include <Plugin/external/nlohmann/json.hpp>
+
+#include <fstream>
+#include <random>
+#include <set>
+#include <thread>
+
+namespace test
+{
+	using diagnostics::TimelineRecorder;
+
+	class TimelineRecorderTests : public testing::Test
+	{
+	public:
+		void SetUp() override
+		{
+			TimelineFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerTimelineTest_" + std::to_string(std::random_device()()));
+			TimelinePath = TimelineFolder / "timeline.json";
+		}
+
+		void TearDown() override
+		{
+			TimelineRecorder::stop();
+			std::filesystem::remove_all(TimelineFolder);
+		}
+
+	protected:
+		/** Reads the timeline file, and retrieves all events apart from metadata. */
+		nlohmann::json readEvents() const
+		{
+			auto timeline = nlohmann::json::parse(std::ifstream{ TimelinePath });
+			auto events = nlohmann::json::array();
+			for (const auto& event : timeline)
+			{
+				if (event.at("ph") != "M") { events.push_back(event); }
+			}
+			return events;
+		}
+
+		std::filesystem::path TimelineFolder;
+		std::filesystem::path TimelinePath;
+	};
+
+	TEST_F(TimelineRecorderTests, recordSpan_when_notRecording_will_notRecordAnything)
+	{
+		{
+			RLTT_TIMELINE_SCOPE("test", "Ignored span");
+		}
+
+		TimelineRecorder::start(TimelinePath);
+		TimelineRecorder::stop();
+
+		EXPECT_FALSE(TimelineRecorder::isRecording());
+		EXPECT_TRUE(readEvents().empty());
+	}
+
+	TEST_F(TimelineRecorderTests, stop_when_spansWereRecorded_will_writeChromeTraceEvents)
+	{
+		TimelineRecorder::start(TimelinePath);
+		ASSERT_TRUE(TimelineRecorder::isRecording());
+		{
+			RLTT_TIMELINE_SCOPE("hook", "Function TAGame.Replay_TA.Tick");
+		}
+		TimelineRecorder::recordBegin("map", "Map load");
+		TimelineRecorder::recordEnd("map", "Map load");
+		TimelineRecorder::stop();
+
+		auto events = readEvents();
+		ASSERT_EQ(events.size(), 3);
+		EXPECT_EQ(events[0].at("ph"), "X");
+		EXPECT_EQ(events[0].at("cat"), "hook");
+		EXPECT_EQ(events[0].at("name"), "Function TAGame.Replay_TA.Tick");
+		EXPECT_GE(events[0].at("dur").get<double>(), 0.0);
+		EXPECT_EQ(events[1].at("ph"), "B");
+		EXPECT_EQ(events[2].at("ph"), "E");
+		EXPECT_LE(events[1].at("ts").get<double>(), events[2].at("ts").get<double>());
+		EXPECT_EQ(events[1].at("tid"), events[0].at("tid"));
+	}
+
+	TEST_F(TimelineRecorderTests, recordSpan_when_nameNeedsEscaping_will_writeValidJson)
+	{
+		const auto command = std::string("load_workshop \"C:\\Workshop\\Map.udk\"");
+		TimelineRecorder::start(TimelinePath);
+		{
+			RLTT_TIMELINE_SCOPE("command", command);
+		}
+		TimelineRecorder::stop();
+
+		auto events = readEvents();
+		ASSERT_EQ(events.size(), 1);
+		EXPECT_EQ(events[0].at("name"), command);
+	}
+
+	TEST_F(TimelineRecorderTests, recordSpan_when_recordedOnSeveralThreads_will_tagEventsWithThreadIds)
+	{
+		const size_t NumberOfThreads = 4;
+		const size_t SpansPerThread = 1000;
+
+		TimelineRecorder::start(TimelinePath);
+		std::vector<std::thread> threads;
+		for (size_t threadNumber = 0; threadNumber < NumberOfThreads; threadNumber++)
+		{
+			threads.emplace_back([SpansPerThread]() {
+				for (size_t spanNumber = 0; spanNumber < SpansPerThread; spanNumber++)
+				{
+					RLTT_TIMELINE_SCOPE("test", "Worker span");
+				}
+			});
+		}
+		for (auto& thread : threads) { thread.join(); }
+		TimelineRecorder::stop();
+
+		auto events = readEvents();
+		EXPECT_EQ(events.size() + TimelineRecorder::droppedEvents(), NumberOfThreads * SpansPerThread);
+		std::set<uint32_t> threadIds;
+		for (const auto& event : events)
+		{
+			threadIds.insert(event.at("tid").get<uint32_t>());
+		}
+		EXPECT_EQ(threadIds.size(), NumberOfThreads);
+	}
+
+	TEST_F(TimelineRecorderTests, start_when_previousRecordingHadEvents_will_onlyContainNewEvents)
+	{
+		TimelineRecorder::start(TimelinePath);
+		TimelineRecorder::recordBegin("map", "Old map load");
+		TimelineRecorder::start(TimelinePath); // Stops the first recording
+		TimelineRecorder::recordEnd("map", "Old map load");
+		TimelineRecorder::stop();
+
+		auto events = readEvents();
+		ASSERT_EQ(events.size(), 1);
+		EXPECT_EQ(events[0].at("ph"), "E");
+	}
+
+#ifndef RLTT_DISABLE_PERFORMANCE_COUNTERS
+	TEST_F(TimelineRecorderTests, performanceScope_when_recording_will_addSpanWithCounterName)
+	{
+		TimelineRecorder::start(TimelinePath);
+		{
+			RLTT_PERFORMANCE_SCOPE(diagnostics::PerformanceCounter::RepositoryStore);
+		}
+		TimelineRecorder::stop();
+
+		auto events = readEvents();
+		ASSERT_EQ(events.size(), 1);
+		EXPECT_EQ(events[0].at("cat"), "repository");
+		EXPECT_EQ(events[0].at("name"), diagnostics::PerformanceCounters::name(diagnostics::PerformanceCounter::RepositoryStore));
+	}
+#endif
+}
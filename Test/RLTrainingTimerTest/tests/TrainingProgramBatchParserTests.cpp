@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/injection/TrainingProgramBatchParser.h>
+
+namespace test
+{
+	using injection::TrainingProgramBatchParser;
+
+	static std::string createProgramJson(const std::string& id, const std::string& name)
+	{
+		return "{ \"Id\": \"" + id + "\", \"Name\": \"" + name + "\", \"Duration\": 60000, \"Entries\": [], \"ReadOnly\": false }";
+	}
+
+	TEST(TrainingProgramBatchParserTests, parse_when_batchIsArray_will_parseEveryProgram)
+	{
+		const auto batch = "[ " + createProgramJson("A", "First") + ", " + createProgramJson("B", "Second") + " ]";
+
+		const auto parsedPrograms = TrainingProgramBatchParser::parse(batch);
+
+		ASSERT_EQ(parsedPrograms.size(), 2);
+		ASSERT_TRUE(parsedPrograms[0].Data.has_value());
+		ASSERT_TRUE(parsedPrograms[1].Data.has_value());
+		EXPECT_EQ(parsedPrograms[0].Data->Name, "First");
+		EXPECT_EQ(parsedPrograms[1].Data->Name, "Second");
+		EXPECT_EQ(parsedPrograms[1].Data->Duration, std::chrono::minutes(1));
+	}
+
+	TEST(TrainingProgramBatchParserTests, parse_when_batchHasOneProgramPerLine_will_skipBlankLines)
+	{
+		const auto batch = createProgramJson("A", "First") + "\r\n\n  \t\n" + createProgramJson("B", "Second") + "\n";
+
+		const auto parsedPrograms = TrainingProgramBatchParser::parse(batch);
+
+		ASSERT_EQ(parsedPrograms.size(), 2);
+		ASSERT_TRUE(parsedPrograms[0].Data.has_value());
+		ASSERT_TRUE(parsedPrograms[1].Data.has_value());
+		EXPECT_EQ(parsedPrograms[0].Data->Id, "A");
+		EXPECT_EQ(parsedPrograms[1].Data->Id, "B");
+	}
+
+	TEST(TrainingProgramBatchParserTests, parse_when_linesAreMalformed_will_reportThemAndParseOtherLines)
+	{
+		const auto batch = createProgramJson("A", "First") + "\n"
+			+ "{ \"Id\": \"B\", \n" // Not valid JSON
+			+ "{ \"Id\": \"C\" }\n" // Valid JSON, but not a training program
+			+ createProgramJson("", "No Id") + "\n"
+			+ createProgramJson("E", "Last");
+
+		const auto parsedPrograms = TrainingProgramBatchParser::parse(batch);
+
+		ASSERT_EQ(parsedPrograms.size(), 5);
+		EXPECT_TRUE(parsedPrograms[0].Data.has_value());
+		for (size_t index = 1; index < 4; index++)
+		{
+			EXPECT_FALSE(parsedPrograms[index].Data.has_value());
+			EXPECT_FALSE(parsedPrograms[index].SupersededBy.has_value());
+		}
+		EXPECT_EQ(parsedPrograms[1].Error.rfind("could not be parsed", 0), 0);
+		EXPECT_EQ(parsedPrograms[2].Error.rfind("does not match training program structure", 0), 0);
+		EXPECT_EQ(parsedPrograms[3].Error, "has no Id");
+		EXPECT_TRUE(parsedPrograms[4].Data.has_value());
+	}
+
+	TEST(TrainingProgramBatchParserTests, parse_when_arrayIsMalformed_will_throw)
+	{
+		const auto batch = "[ " + createProgramJson("A", "First") + ", ";
+
+		EXPECT_ANY_THROW(TrainingProgramBatchParser::parse(batch));
+	}
+
+	TEST(TrainingProgramBatchParserTests, parse_when_idIsContainedSeveralTimes_will_supersedeEarlierPrograms)
+	{
+		const auto batch = createProgramJson("A", "First") + "\n" + createProgramJson("B", "Other") + "\n" + createProgramJson("A", "Second");
+
+		const auto parsedPrograms = TrainingProgramBatchParser::parse(batch);
+
+		ASSERT_EQ(parsedPrograms.size(), 3);
+		EXPECT_FALSE(parsedPrograms[0].Data.has_value());
+		EXPECT_EQ(parsedPrograms[0].SupersededBy, 2);
+		EXPECT_TRUE(parsedPrograms[0].Error.empty()); // Superseding is not a failure
+		EXPECT_TRUE(parsedPrograms[1].Data.has_value());
+		ASSERT_TRUE(parsedPrograms[2].Data.has_value());
+		EXPECT_EQ(parsedPrograms[2].Data->Name, "Second");
+	}
+}
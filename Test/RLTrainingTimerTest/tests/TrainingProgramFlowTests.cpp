@@ -329,6 +329,38 @@ namespace test
 		EXPECT_FALSE(_fakeGameWrapper->ExecuteWasCalled);
 	}
 
+	TEST_F(TrainingProgramFlowTestFixture, receiveListData_when_otherProgramChanged_will_keepRunningProgram)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto changedList = FullTrainingProgramList;
+		changedList.TrainingProgramData.at(UntimedTrainingProgramId).Name = "Renamed by a sync tool";
+		std::swap(changedList.TrainingProgramOrder[0], changedList.TrainingProgramOrder[1]);
+
+		sut->receiveListData(changedList);
+
+		auto flowData = sut->getCurrentFlowData();
+		EXPECT_TRUE(flowData.StoppingIsPossible);
+		EXPECT_EQ(flowData.SelectedTrainingProgramIndex, 0);
+		EXPECT_EQ(flowData.TrainingPrograms[3].Title, "Renamed by a sync tool");
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, receiveListData_when_runningProgramChanged_will_stopRunningProgram)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto changedList = FullTrainingProgramList;
+		changedList.TrainingProgramData.at(FullyTimedTrainingProgramId).Entries.pop_back();
+
+		sut->receiveListData(changedList);
+
+		auto flowData = sut->getCurrentFlowData();
+		EXPECT_FALSE(flowData.StoppingIsPossible);
+		EXPECT_TRUE(flowData.StartingIsPossible);
+	}
+
 	TEST_F(TrainingProgramFlowTestFixture, handleTimerTick_when_firstTrainingStepIsFinished_will_activateSecondTrainingStep)
 	{
 		sut->receiveListData(FullTrainingProgramList);
@@ -476,4 +508,142 @@ namespace test
 
 		EXPECT_EQ(executionDataBefore.TrainingStepNumber + 1, executionDataAfter.TrainingStepNumber);
 	}
-}
\ No newline at end of file
+
+	TEST_F(TrainingProgramFlowTestFixture, selectTrainingProgram_when_workshopMapDoesNotExist_will_reportMissingMap)
+	{
+		sut->setWorkshopMapCheck([](const std::string&) { return false; });
+		sut->receiveListData(FullTrainingProgramList);
+
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+
+		auto flowData = sut->getCurrentFlowData();
+		ASSERT_EQ(flowData.MissingWorkshopMaps.size(), 1);
+		EXPECT_EQ(flowData.MissingWorkshopMaps[0], DummyWorkshopSubPath);
+		EXPECT_TRUE(flowData.StartingIsPossible); // The user might still want to start the program
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, refreshMissingWorkshopMaps_when_mapIsMissingAfterScan_will_reportMissingMap)
+	{
+		auto scanHasFinished = false;
+		sut->setWorkshopMapCheck([&scanHasFinished](const std::string&) { return !scanHasFinished; }); // Like the index, which assumes maps exist until it knows better
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		ASSERT_TRUE(sut->getCurrentFlowData().MissingWorkshopMaps.empty());
+
+		scanHasFinished = true;
+		sut->refreshMissingWorkshopMaps();
+
+		auto flowData = sut->getCurrentFlowData();
+		ASSERT_EQ(flowData.MissingWorkshopMaps.size(), 1);
+		EXPECT_EQ(flowData.MissingWorkshopMaps[0], DummyWorkshopSubPath);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, handleTimerTick_when_mapWasLoaded_will_notCountLoadingTime)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+		const auto loadingTime = std::chrono::seconds(10);
+
+		startMapLoad(startTime);
+		finishMapLoad(startTime + loadingTime);
+		sendTimerTick(startTime + OneMinuteFreeplayEntry.Duration);
+
+		auto executionData = sut->getCurrentExecutionData();
+		EXPECT_EQ(executionData.TrainingStepNumber, 0);
+		EXPECT_EQ(executionData.TimeLeftInCurrentTrainingStep, loadingTime);
+
+		sendTimerTick(startTime + OneMinuteFreeplayEntry.Duration + loadingTime);
+		EXPECT_EQ(sut->getCurrentExecutionData().TrainingStepNumber, 1);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, handleTimerTick_when_mapIsPreloadedForNextStep_will_notExtendCurrentStep)
+	{
+		sut->setPreloadSettings(true, std::chrono::seconds(5));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto secondStepStartTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(secondStepStartTime);
+		auto thirdStepStartTime = secondStepStartTime + TwoMinuteDefaultEntry.Duration;
+
+		// Preload the workshop map for the third step
+		sendTimerTick(thirdStepStartTime - std::chrono::seconds(4));
+		startMapLoad(thirdStepStartTime - std::chrono::seconds(4));
+		sendTimerTick(thirdStepStartTime);
+		EXPECT_EQ(sut->getCurrentExecutionData().TrainingStepNumber, 2);
+
+		// The load took three seconds longer than the second step lasted, which must not be taken from the third step
+		finishMapLoad(thirdStepStartTime + std::chrono::seconds(3));
+		sendTimerTick(thirdStepStartTime + std::chrono::seconds(4));
+		EXPECT_EQ(sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStep, OneMinuteWorkshopEntry.Duration - std::chrono::seconds(1));
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, handleTimerTick_when_mapIsLoadingAndGameIsPaused_will_countTimeOnlyOnceBothEnded)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		startMapLoad(startTime);
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(2);
+		pauseGame();
+		finishMapLoad(startTime + std::chrono::seconds(5));
+		_fakeTimeProvider->CurrentFakeTime = startTime + std::chrono::seconds(8);
+		resumeGame();
+		sendTimerTick(startTime + std::chrono::seconds(10));
+
+		EXPECT_EQ(sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStep, OneMinuteFreeplayEntry.Duration - std::chrono::seconds(2));
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, executionData_when_mapIsLoading_will_forwardPausedState)
+	{
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		startMapLoad(startTime);
+		EXPECT_TRUE(sut->getCurrentExecutionData().TrainingIsPaused);
+
+		finishMapLoad(startTime + std::chrono::seconds(5));
+		EXPECT_FALSE(sut->getCurrentExecutionData().TrainingIsPaused);
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, handleMapLoadStart_when_preloadCommandWasRejected_will_freezeCurrentStep)
+	{
+		sut->setPreloadSettings(true, std::chrono::seconds(30));
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(FullyTimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto secondStepStartTime = _fakeTimeProvider->CurrentFakeTime + OneMinuteFreeplayEntry.Duration;
+		sendTimerTick(secondStepStartTime);
+		auto thirdStepStartTime = secondStepStartTime + TwoMinuteDefaultEntry.Duration;
+
+		// The preload command for the third step never leads to a map load, but the player loads something on their own later on
+		sendTimerTick(thirdStepStartTime - std::chrono::seconds(30));
+		startMapLoad(thirdStepStartTime - std::chrono::seconds(10));
+		finishMapLoad(thirdStepStartTime - std::chrono::seconds(5));
+		sendTimerTick(thirdStepStartTime);
+
+		auto executionData = sut->getCurrentExecutionData();
+		EXPECT_EQ(executionData.TrainingStepNumber, 1);
+		EXPECT_EQ(executionData.TimeLeftInCurrentTrainingStep, std::chrono::seconds(5));
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, activateNextTrainingProgramStep_when_preStepCommandsAreSet_will_executeEverythingInOneBatch)
+	{
+		sut->setPreStepCommands({ "sv_soccar_gamespeed 1", "cl_goalreplay_pov 0" });
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(MixedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		sut->activateNextTrainingProgramStep();
+
+		const auto& batches = _fakeCVarManager->executedBatches();
+		ASSERT_EQ(batches.size(), 2);
+		EXPECT_EQ(batches[0], std::vector<std::string>({ "sv_soccar_gamespeed 1", "cl_goalreplay_pov 0", "load_freeplay" }));
+		EXPECT_EQ(batches[1], std::vector<std::string>({ "sv_soccar_gamespeed 1", "cl_goalreplay_pov 0", "load_training " + DummyTrainingPackCode }));
+	}
+}
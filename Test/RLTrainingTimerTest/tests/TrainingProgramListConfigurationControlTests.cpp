@@ -1,5 +1,6 @@
 #include <gmock/gmock.h>
 #include <Plugin/configuration/control/TrainingProgramListConfigurationControl.h>
+#include <Plugin/configuration/control/TrainingProgramConfigurationControl.h>
 #include "../mocks/ITrainingProgramRepositoryMock.h"
 #include <Plugin/external/fmt/include/fmt/format.h>
 TEST(TEMP, ensureUniqueIds)
@@ -19,4 +20,153 @@ TEST(TEMP, ensureUniqueIds)
 			knownUuids.emplace(uuid);
 		}
 	}
-}
\ No newline at end of file
+}
+namespace test
+{
+	TEST(TrainingProgramListConfigurationControlTests, importTrainingProgramBundle_when_bundleContainsSeveralPrograms_will_injectAllAndStoreOnce)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+
+		auto bundle = std::vector<configuration::TrainingProgramData>(3);
+		bundle[0].Id = "{First}";
+		bundle[1].Id = "{Second}";
+		bundle[2].Id = "{Third}";
+		ON_CALL(*repository, importTrainingProgramBundle(::testing::_)).WillByDefault(::testing::Return(bundle));
+		EXPECT_CALL(*repository, storeData(::testing::_)).Times(1);
+
+		sut->importTrainingProgramBundle("bundle.rlttbundle");
+
+		auto order = sut->getTrainingProgramList().TrainingProgramOrder;
+		ASSERT_EQ(order.size(), 3);
+		EXPECT_EQ(order[0], "{First}");
+		EXPECT_EQ(order[1], "{Second}");
+		EXPECT_EQ(order[2], "{Third}");
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, exportTrainingPrograms_when_called_will_passProgramsInRequestedOrder)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+		auto firstId = sut->addTrainingProgram();
+		auto secondId = sut->addTrainingProgram();
+
+		std::vector<configuration::TrainingProgramData> exportedPrograms;
+		EXPECT_CALL(*repository, exportTrainingPrograms(::testing::_, "bundle.rlttbundle", configuration::BulkExportFormat::Bundle))
+			.WillOnce(::testing::SaveArg<0>(&exportedPrograms));
+
+		sut->exportTrainingPrograms({ secondId, firstId }, "bundle.rlttbundle", configuration::BulkExportFormat::Bundle);
+
+		ASSERT_EQ(exportedPrograms.size(), 2);
+		EXPECT_EQ(exportedPrograms[0].Id, secondId);
+		EXPECT_EQ(exportedPrograms[1].Id, firstId);
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, injectTrainingProgram_when_programIsUnchanged_will_notStoreAgain)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+
+		configuration::TrainingProgramData program;
+		program.Id = "{Injected}";
+		program.Name = "Injected";
+		configuration::TrainingProgramEntry entry;
+		entry.Name = "First";
+		entry.Duration = std::chrono::milliseconds(60000);
+		program.Entries.push_back(entry);
+		EXPECT_CALL(*repository, storeData(::testing::_)).Times(1);
+
+		sut->injectTrainingProgram(program);
+		sut->injectTrainingProgram(program);
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, injectTrainingPrograms_when_batchContainsNewChangedAndUnchangedPrograms_will_reportEachAndStoreOnce)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+		auto batch = std::vector<configuration::TrainingProgramData>(3);
+		batch[0].Id = "{Unchanged}";
+		batch[1].Id = "{Changed}";
+		batch[2].Id = "{New}";
+		sut->injectTrainingPrograms({ batch[0], batch[1] });
+		batch[1].Name = "Changed";
+		EXPECT_CALL(*repository, storeData(::testing::_)).Times(1);
+
+		auto results = sut->injectTrainingPrograms(batch);
+
+		ASSERT_EQ(results.size(), 3);
+		EXPECT_EQ(results[0], configuration::InjectionResult::Unchanged);
+		EXPECT_EQ(results[1], configuration::InjectionResult::Replaced);
+		EXPECT_EQ(results[2], configuration::InjectionResult::Added);
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, renameProgram_when_nameIsUnchanged_will_notNotify)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto listControl = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+		auto notificationCount = 0;
+		auto sut = std::make_unique<configuration::TrainingProgramConfigurationControl>(trainingProgramData, [&notificationCount]() { notificationCount++; });
+		auto id = listControl->addTrainingProgram();
+
+		sut->renameProgram(id, "Renamed");
+		sut->renameProgram(id, "Renamed");
+
+		EXPECT_EQ(notificationCount, 1);
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, changeWorkshopFolderLocation_when_locationIsUnchanged_will_notStoreAgain)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+		EXPECT_CALL(*repository, storeData(::testing::_)).Times(1);
+
+		sut->changeWorkshopFolderLocation("C:\\Workshop");
+		sut->changeWorkshopFolderLocation("C:\\Workshop");
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, mergeExternalChanges_when_oneProgramChanged_will_replaceOnlyThatProgramAndNotStore)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+		auto unchangedId = sut->addTrainingProgram();
+		auto changedId = sut->addTrainingProgram();
+		auto removedId = sut->addTrainingProgram();
+		const auto* unchangedProgramAddress = &trainingProgramData->at(unchangedId);
+
+		auto externalData = sut->getTrainingProgramList();
+		externalData.TrainingProgramData.at(changedId).Name = "Changed externally";
+		externalData.TrainingProgramData.erase(removedId);
+		externalData.TrainingProgramOrder.erase(std::find(externalData.TrainingProgramOrder.begin(), externalData.TrainingProgramOrder.end(), removedId));
+		ON_CALL(*repository, restoreDataIfChangedExternally()).WillByDefault(::testing::Return(externalData));
+		EXPECT_CALL(*repository, storeData(::testing::_)).Times(0);
+
+		sut->mergeExternalChanges();
+
+		EXPECT_EQ(trainingProgramData->size(), 2);
+		EXPECT_EQ(&trainingProgramData->at(unchangedId), unchangedProgramAddress);
+		EXPECT_EQ(trainingProgramData->at(changedId).Name, "Changed externally");
+		EXPECT_FALSE(sut->hasTrainingProgram(removedId));
+	}
+
+	TEST(TrainingProgramListConfigurationControlTests, restoreWholeTrainingProgramList_when_fileCannotBeRestored_will_keepCurrentPrograms)
+	{
+		auto trainingProgramData = std::make_shared<std::map<std::string, configuration::TrainingProgramData>>();
+		auto repository = std::make_shared<::testing::NiceMock<ITrainingProgramRepositoryMock>>();
+		auto sut = std::make_unique<configuration::TrainingProgramListConfigurationControl>(trainingProgramData, repository);
+		auto trainingProgramId = sut->addTrainingProgram();
+		ON_CALL(*repository, restoreData("corrupt.json")).WillByDefault(::testing::Throw(std::runtime_error("corrupt.json is not valid")));
+		EXPECT_CALL(*repository, storeData(::testing::_)).Times(0);
+
+		sut->restoreWholeTrainingProgramList("corrupt.json");
+
+		EXPECT_TRUE(sut->hasTrainingProgram(trainingProgramId));
+		EXPECT_EQ(sut->getTrainingProgramList().TrainingProgramOrder, std::vector<std::string>{ trainingProgramId });
+	}
+}
@@ -0,0 +1,208 @@
+#include "../fixtures/TrainingProgramRepositoryTestFixture.h"
+#include <Plugin/configuration/control/TrainingProgramListConfigurationControl.h>
+#include <Plugin/diagnostics/PerformanceCounters.h>
+
+namespace test
+{
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_dataWasStored_will_restoreSameData)
+	{
+		sut->storeData(createList("First"));
+
+		auto restoredData = sut->restoreData();
+
+		EXPECT_EQ(firstName(restoredData), "First");
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_fileWasTorn_will_restoreNewestBackup)
+	{
+		sut->storeData(createList("First"));
+		sut->flush();
+		restartSession();
+		sut->storeData(createList("Second"));
+		sut->flush();
+		tearFile(StoragePath, 10);
+
+		auto restoredData = sut->restoreData();
+
+		EXPECT_EQ(firstName(restoredData), "First"); // The backup contains what the last write replaced
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_newestBackupWasTornAsWell_will_restoreOlderBackup)
+	{
+		sut->storeData(createList("First"));
+		sut->flush();
+		restartSession();
+		sut->storeData(createList("Second"));
+		sut->flush();
+		restartSession();
+		sut->storeData(createList("Third"));
+		sut->flush();
+		tearFile(StoragePath, 10);
+		auto newestBackupPath = StoragePath;
+		newestBackupPath += ".bak1";
+		tearFile(newestBackupPath, std::filesystem::file_size(newestBackupPath) - 5);
+
+		auto restoredData = sut->restoreData();
+
+		EXPECT_EQ(firstName(restoredData), "First");
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_backupChecksumDoesNotMatch_will_skipBackup)
+	{
+		sut->storeData(createList("First"));
+		sut->flush();
+		restartSession();
+		sut->storeData(createList("Second"));
+		sut->flush();
+		restartSession();
+		sut->storeData(createList("Third"));
+		sut->flush();
+		tearFile(StoragePath, 0);
+		auto newestBackupPath = StoragePath;
+		newestBackupPath += ".bak1";
+		auto backup = std::string();
+		{
+			std::ifstream is{ newestBackupPath, std::ios::binary };
+			backup.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+		}
+		backup.replace(backup.find("Second"), 6, "Secone"); // Still valid JSON, but not what was written
+		writeFile(newestBackupPath, backup);
+
+		auto restoredData = sut->restoreData();
+
+		EXPECT_EQ(firstName(restoredData), "First");
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_writeWasInterruptedBeforeReplacingTheFile_will_restorePreviousData)
+	{
+		sut->storeData(createList("First"));
+		sut->flush();
+		auto temporaryPath = StoragePath;
+		temporaryPath += ".tmp";
+		writeFile(temporaryPath, "{ \"Version\": ");
+
+		auto restoredData = sut->restoreData();
+
+		EXPECT_EQ(firstName(restoredData), "First");
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_nothingIsValid_will_keepDamagedFile)
+	{
+		writeFile(StoragePath, "{ \"Version\": ");
+
+		auto restoredData = sut->restoreData();
+
+		EXPECT_TRUE(restoredData.TrainingProgramOrder.empty());
+		auto brokenFilePath = StoragePath;
+		brokenFilePath += ".broken";
+		EXPECT_TRUE(std::filesystem::exists(brokenFilePath));
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, restoreData_when_fileAtLocationIsInvalid_will_throw)
+	{
+		const auto importPath = StorageFolder / "import.json";
+		writeFile(importPath, "{ \"Version\": ");
+
+		EXPECT_THROW(sut->restoreData(importPath.string()), std::runtime_error);
+		EXPECT_THROW(sut->restoreData((StorageFolder / "missing.json").string()), std::runtime_error);
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, storeData_when_calledInManySessions_will_keepLimitedNumberOfBackups)
+	{
+		for (auto index = 0; index < 10; index++)
+		{
+			restartSession();
+			sut->storeData(createList(std::to_string(index)));
+			sut->flush();
+		}
+
+		auto oldestBackupPath = StoragePath;
+		oldestBackupPath += ".bak5";
+		auto tooOldBackupPath = StoragePath;
+		tooOldBackupPath += ".bak6";
+		EXPECT_TRUE(std::filesystem::exists(oldestBackupPath));
+		EXPECT_FALSE(std::filesystem::exists(tooOldBackupPath));
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, storeData_when_calledRepeatedlyInOneSession_will_onlyCreateOneBackup)
+	{
+		sut->storeData(createList("Initial"));
+		sut->flush();
+		restartSession();
+		for (auto index = 0; index < 10; index++)
+		{
+			sut->storeData(createList(std::to_string(index)));
+			sut->flush();
+		}
+		tearFile(StoragePath, 0);
+
+		auto secondBackupPath = StoragePath;
+		secondBackupPath += ".bak2";
+		EXPECT_FALSE(std::filesystem::exists(secondBackupPath));
+		EXPECT_EQ(firstName(sut->restoreData()), "Initial"); // The state at the start of the session
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, storeData_when_dataWasWritten_will_measureWrite)
+	{
+		const auto storeCounter = (size_t)diagnostics::PerformanceCounter::RepositoryStore;
+		const auto measurementsBefore = diagnostics::PerformanceCounters::snapshot().at(storeCounter).Count;
+
+		sut->storeData(createList("First"));
+		sut->flush();
+
+		EXPECT_EQ(diagnostics::PerformanceCounters::snapshot().at(storeCounter).Count, measurementsBefore + 1);
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, importTrainingProgramBundle_when_bundleWasExported_will_restoreAllProgramsInOrder)
+	{
+		auto programs = std::vector<configuration::TrainingProgramData>(3);
+		for (size_t index = 0; index < programs.size(); index++)
+		{
+			programs[index].Id = "{Program" + std::to_string(index) + "}";
+			programs[index].Name = "Program \"" + std::to_string(index) + "\"\n"; // Must survive escaping
+			configuration::TrainingProgramEntry entry;
+			entry.Name = "Step";
+			entry.Duration = std::chrono::milliseconds(1000 * (index + 1));
+			entry.TrainingPackCode = "A503-264C-A7EB-D8A9";
+			programs[index].Entries.push_back(entry);
+		}
+		const auto bundlePath = (StorageFolder / "export.rlttbundle").string();
+		sut->exportTrainingPrograms(programs, bundlePath, configuration::BulkExportFormat::Bundle);
+
+		auto importedPrograms = sut->importTrainingProgramBundle(bundlePath);
+
+		ASSERT_EQ(importedPrograms.size(), programs.size());
+		for (size_t index = 0; index < programs.size(); index++)
+		{
+			EXPECT_EQ(importedPrograms[index].Id, programs[index].Id);
+			EXPECT_EQ(importedPrograms[index].Name, programs[index].Name);
+			ASSERT_EQ(importedPrograms[index].Entries.size(), 1);
+			EXPECT_EQ(importedPrograms[index].Entries[0].Duration, programs[index].Entries[0].Duration);
+			EXPECT_EQ(importedPrograms[index].Entries[0].TrainingPackCode, programs[index].Entries[0].TrainingPackCode);
+		}
+	}
+
+	TEST_F(TrainingProgramRepositoryTestFixture, importTrainingProgramBundle_when_programIdsAlreadyExist_will_replaceRatherThanDuplicate)
+	{
+		auto repository = std::shared_ptr<configuration::TrainingProgramRepository>(std::move(sut));
+		auto listControl = std::make_unique<configuration::TrainingProgramListConfigurationControl>(
+			std::make_shared<std::map<std::string, configuration::TrainingProgramData>>(), repository);
+		auto existingId = listControl->addTrainingProgram();
+		listControl->addTrainingProgram();
+		auto exportedPrograms = std::vector<configuration::TrainingProgramData>(2);
+		exportedPrograms[0].Id = existingId;
+		exportedPrograms[0].Name = "Exported elsewhere";
+		exportedPrograms[1].Id = "{New}";
+		exportedPrograms[1].Name = "New";
+		const auto bundlePath = (StorageFolder / "export.rlttbundle").string();
+		repository->exportTrainingPrograms(exportedPrograms, bundlePath, configuration::BulkExportFormat::Bundle);
+
+		listControl->importTrainingProgramBundle(bundlePath);
+
+		auto list = listControl->getTrainingProgramList();
+		EXPECT_EQ(list.TrainingProgramOrder.size(), 3);
+		EXPECT_EQ(list.TrainingProgramData.size(), 3);
+		EXPECT_EQ(list.TrainingProgramData.at(existingId).Name, "Exported elsewhere");
+		EXPECT_EQ(list.TrainingProgramData.at("{New}").Name, "New");
+	}
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/statistics/TrainingStatistics.h>
+#include <Plugin/history/SessionHistoryWriter.h>
+#include <Plugin/training/data/SessionEvent.h>
+#include <Plugin/configuration/control/TrainingProgramHasher.h>
+
+#include <random>
+
+namespace test
+{
+	using training::SessionEventType;
+
+	class TrainingStatisticsTests : public testing::Test
+	{
+	public:
+		void SetUp() override
+		{
+			StatisticsFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerStatisticsTest_" + std::to_string(std::random_device()()));
+			std::filesystem::create_directories(StatisticsFolder);
+			RollupPath = StatisticsFolder / "statistics.json";
+			HistoryPath = StatisticsFolder / "session_history.bin";
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(StatisticsFolder);
+		}
+
+	protected:
+		static constexpr int64_t OneDay = 24 * 60 * 60 * 1000;
+		const std::string TrainingProgramId = "4f1c2e5a-0000-4000-8000-000000000001";
+
+		history::SessionRecord createRecord(SessionEventType eventType, uint16_t stepNumber = 0, uint32_t duration = 0, int64_t timestamp = 0)
+		{
+			auto record = history::SessionRecord();
+			record.Timestamp = timestamp;
+			record.SequenceNumber = ++LastSequenceNumber;
+			record.TrainingProgramIdHash = configuration::TrainingProgramHasher::hashText(TrainingProgramId);
+			record.DurationInMilliseconds = duration;
+			record.StepNumber = stepNumber;
+			record.EventType = (uint8_t)eventType;
+			return record;
+		}
+
+		/** Creates the records of a session with a single step which requires completing a pack. */
+		std::vector<history::SessionRecord> createPackSession(uint32_t packCompletionTime, int64_t timestamp = 0)
+		{
+			return {
+				createRecord(SessionEventType::ProgramStarted, 0, 0, timestamp),
+				createRecord(SessionEventType::StepStarted),
+				createRecord(SessionEventType::PackCompleted),
+				createRecord(SessionEventType::StepEnded, 0, packCompletionTime),
+				createRecord(SessionEventType::ProgramFinished),
+			};
+		}
+
+		uint64_t LastSequenceNumber = 0; // Like the history recorder, every record gets the next number
+		std::filesystem::path StatisticsFolder;
+		std::filesystem::path RollupPath;
+		std::filesystem::path HistoryPath;
+	};
+
+	TEST(QuantileSketchTests, quantile_when_valuesWereAdded_will_beWithinRelativeAccuracy)
+	{
+		statistics::QuantileSketch sketch;
+		for (auto value = 1; value <= 10000; value++)
+		{
+			sketch.add(value);
+		}
+
+		EXPECT_EQ(sketch.count(), 10000);
+		EXPECT_NEAR(sketch.quantile(0.5), 5000.0, 5000.0 * statistics::QuantileSketch::RelativeAccuracy);
+		EXPECT_NEAR(sketch.quantile(0.9), 9000.0, 9000.0 * statistics::QuantileSketch::RelativeAccuracy);
+		EXPECT_LT(sketch.bucketCounts().size(), 500); // Much less than the number of values
+	}
+
+	TEST(QuantileSketchTests, merge_when_sketchesWereFilledSeparately_will_matchSingleSketch)
+	{
+		statistics::QuantileSketch evenValues, oddValues, allValues;
+		for (auto value = 1; value <= 1000; value++)
+		{
+			(value % 2 == 0 ? evenValues : oddValues).add(value);
+			allValues.add(value);
+		}
+
+		evenValues.merge(oddValues);
+
+		EXPECT_EQ(evenValues.count(), allValues.count());
+		EXPECT_EQ(evenValues.bucketCounts(), allValues.bucketCounts());
+		EXPECT_DOUBLE_EQ(evenValues.quantile(0.5), allValues.quantile(0.5));
+	}
+
+	TEST_F(TrainingStatisticsTests, apply_when_sessionsWereRecorded_will_aggregatePerStep)
+	{
+		statistics::TrainingStatistics sut(RollupPath);
+		for (auto packCompletionTime : { 60000u, 90000u, 120000u })
+		{
+			for (const auto& record : createPackSession(packCompletionTime))
+			{
+				sut.apply(record);
+			}
+		}
+		// A stopped session where the pack was skipped
+		sut.apply(createRecord(SessionEventType::ProgramStarted));
+		sut.apply(createRecord(SessionEventType::StepStarted));
+		sut.apply(createRecord(SessionEventType::StepSkipped));
+		sut.apply(createRecord(SessionEventType::StepEnded, 0, 30000));
+		sut.apply(createRecord(SessionEventType::ProgramStopped));
+
+		auto programStatistics = sut.getProgramStatistics(TrainingProgramId);
+
+		ASSERT_TRUE(programStatistics.has_value());
+		EXPECT_EQ(programStatistics->SessionsStarted, 4);
+		EXPECT_EQ(programStatistics->SessionsFinished, 3);
+		EXPECT_EQ(programStatistics->SessionsStopped, 1);
+		EXPECT_DOUBLE_EQ(programStatistics->completionRate(), 0.75);
+		EXPECT_EQ(programStatistics->TimeTrainedInMilliseconds, 300000);
+		ASSERT_EQ(programStatistics->Steps.size(), 1);
+		const auto& stepStatistics = programStatistics->Steps[0];
+		EXPECT_EQ(stepStatistics.PacksCompleted, 3); // The skipped step does not count
+		EXPECT_DOUBLE_EQ(stepStatistics.averagePackCompletionTime(), 90000.0);
+		EXPECT_NEAR(stepStatistics.medianPackCompletionTime(), 90000.0, 90000.0 * statistics::QuantileSketch::RelativeAccuracy);
+		EXPECT_DOUBLE_EQ(stepStatistics.skipFrequency(), 0.25);
+	}
+
+	TEST_F(TrainingStatisticsTests, apply_when_programIsStartedOnConsecutiveDays_will_countStreak)
+	{
+		statistics::TrainingStatistics sut(RollupPath);
+		for (auto day : { 100, 101, 101, 102, 110, 111 })
+		{
+			sut.apply(createRecord(SessionEventType::ProgramStarted, 0, 0, day * OneDay + 1000));
+		}
+
+		auto programStatistics = sut.getProgramStatistics(TrainingProgramId);
+
+		ASSERT_TRUE(programStatistics.has_value());
+		EXPECT_EQ(programStatistics->LongestStreakInDays, 3);
+		EXPECT_EQ(programStatistics->currentStreakInDays(112), 2);
+		EXPECT_EQ(programStatistics->currentStreakInDays(113), 0);
+	}
+
+	TEST_F(TrainingStatisticsTests, constructor_when_rollupWasSaved_will_restoreStatistics)
+	{
+		{
+			statistics::TrainingStatistics sut(RollupPath);
+			for (const auto& record : createPackSession(75000))
+			{
+				sut.apply(record);
+			}
+			sut.save();
+		}
+
+		statistics::TrainingStatistics restoredStatistics(RollupPath, HistoryPath);
+		auto programStatistics = restoredStatistics.getProgramStatistics(TrainingProgramId);
+
+		ASSERT_TRUE(programStatistics.has_value());
+		EXPECT_EQ(programStatistics->SessionsFinished, 1);
+		ASSERT_EQ(programStatistics->Steps.size(), 1);
+		EXPECT_EQ(programStatistics->Steps[0].PackCompletionTimes.count(), 1);
+		EXPECT_NEAR(programStatistics->Steps[0].medianPackCompletionTime(), 75000.0, 75000.0 * statistics::QuantileSketch::RelativeAccuracy);
+	}
+
+	TEST_F(TrainingStatisticsTests, constructor_when_onlyHistoryExists_will_buildStatisticsFromHistory)
+	{
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			for (const auto& record : createPackSession(75000))
+			{
+				writer.append(record);
+			}
+		}
+
+		statistics::TrainingStatistics sut(RollupPath, HistoryPath);
+		sut.flush();
+		auto programStatistics = sut.getProgramStatistics(TrainingProgramId);
+
+		ASSERT_TRUE(programStatistics.has_value());
+		EXPECT_EQ(programStatistics->Steps[0].PacksCompleted, 1);
+		EXPECT_TRUE(std::filesystem::exists(RollupPath)); // The history does not need to be read again next time
+	}
+
+	TEST_F(TrainingStatisticsTests, constructor_when_historyIsNewerThanRollup_will_onlyApplyNewerEvents)
+	{
+		// All events happen within the same millisecond, so only the sequence numbers can tell them apart
+		const int64_t sessionTime = 100 * OneDay;
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			statistics::TrainingStatistics sut(RollupPath);
+			for (const auto& record : createPackSession(60000, sessionTime))
+			{
+				writer.append(record);
+				sut.apply(record);
+			}
+			sut.save();
+			// The game crashes before the second session gets stored in the rollup
+			for (const auto& record : createPackSession(90000, sessionTime))
+			{
+				writer.append(record);
+			}
+		}
+
+		statistics::TrainingStatistics restoredStatistics(RollupPath, HistoryPath);
+		auto programStatistics = restoredStatistics.getProgramStatistics(TrainingProgramId);
+
+		ASSERT_TRUE(programStatistics.has_value());
+		EXPECT_EQ(programStatistics->SessionsFinished, 2);
+		EXPECT_EQ(programStatistics->Steps[0].PacksCompleted, 2);
+		EXPECT_EQ(programStatistics->Steps[0].PackCompletionTimeSumInMilliseconds, 150000);
+	}
+
+	TEST_F(TrainingStatisticsTests, constructor_when_historyWasReplaced_will_applyEventsRecordedFromNowOn)
+	{
+		{
+			statistics::TrainingStatistics sut(RollupPath);
+			for (const auto& record : createPackSession(60000))
+			{
+				sut.apply(record);
+			}
+			sut.save();
+		}
+		// The history got deleted, so the recorder starts counting from the beginning
+		LastSequenceNumber = 0;
+		{
+			history::SessionHistoryWriter writer(HistoryPath);
+			writer.append(createRecord(SessionEventType::ProgramStarted));
+		}
+
+		statistics::TrainingStatistics restoredStatistics(RollupPath, HistoryPath);
+		for (const auto& record : createPackSession(90000))
+		{
+			restoredStatistics.apply(record);
+		}
+		auto programStatistics = restoredStatistics.getProgramStatistics(TrainingProgramId);
+
+		ASSERT_TRUE(programStatistics.has_value());
+		EXPECT_EQ(programStatistics->SessionsFinished, 2);
+		EXPECT_EQ(programStatistics->Steps[0].PackCompletionTimeSumInMilliseconds, 150000);
+	}
+
+	TEST_F(TrainingStatisticsTests, apply_when_recordWasAppliedBefore_will_ignoreIt)
+	{
+		statistics::TrainingStatistics sut(RollupPath);
+		const auto record = createRecord(SessionEventType::ProgramStarted);
+
+		sut.apply(record);
+		sut.apply(record);
+
+		EXPECT_EQ(sut.getProgramStatistics(TrainingProgramId)->SessionsStarted, 1);
+	}
+
+	TEST_F(TrainingStatisticsTests, estimateCompletionTime_when_packWasCompleted_will_returnMedianCompletionTime)
+	{
+		statistics::TrainingStatistics sut(RollupPath);
+		for (auto packCompletionTime : { 60000u, 90000u, 600000u }) // The last session took unusually long
+		{
+			for (const auto& record : createPackSession(packCompletionTime))
+			{
+				sut.apply(record);
+			}
+		}
+
+		auto estimate = sut.estimateCompletionTime(TrainingProgramId, 0);
+
+		ASSERT_TRUE(estimate.has_value());
+		EXPECT_NEAR((double)estimate->count(), 90000.0, 90000.0 * statistics::QuantileSketch::RelativeAccuracy);
+		EXPECT_FALSE(sut.estimateCompletionTime(TrainingProgramId, 1).has_value());
+		EXPECT_FALSE(sut.estimateCompletionTime("unknown", 0).has_value());
+	}
+
+	TEST_F(TrainingStatisticsTests, revision_when_eventWasApplied_will_change)
+	{
+		statistics::TrainingStatistics sut(RollupPath);
+		const auto initialRevision = sut.revision();
+
+		sut.apply(createRecord(SessionEventType::ProgramStarted));
+
+		EXPECT_NE(sut.revision(), initialRevision);
+	}
+}
@@ -1,9 +1,39 @@
 #include "../fixtures/TrainingProgramFlowTestFixture.h"
+#include "../fakes/FakeCompletionTimeEstimator.h"
+
+#include <Plugin/history/SessionHistoryRecorder.h>
+#include <Plugin/statistics/TrainingStatistics.h>
+
+#include <random>
 
 namespace test
 {
-	// Just to get some separation in the test explorer
-	class UntimedTrainingProgramFlowTestFixture : public TrainingProgramFlowTestFixture	{ };
+	class UntimedTrainingProgramFlowTestFixture : public TrainingProgramFlowTestFixture
+	{
+	public:
+		void TearDown() override
+		{
+			sut.reset(); // Writes the pending history records
+			if (!StatisticsFolder.empty())
+			{
+				std::filesystem::remove_all(StatisticsFolder);
+			}
+		}
+
+	protected:
+		/** Estimates completion times the way the plugin does: The flow control feeds the history recorder, which feeds the statistics. */
+		void useTrainingStatistics()
+		{
+			StatisticsFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerCompletionTimeTest_" + std::to_string(std::random_device()()));
+			auto trainingStatistics = std::make_shared<statistics::TrainingStatistics>(StatisticsFolder / "statistics.json");
+			auto sessionHistoryRecorder = std::make_shared<history::SessionHistoryRecorder>(StatisticsFolder / "session_history.bin");
+			sessionHistoryRecorder->registerSessionRecordReceiver(trainingStatistics);
+			sut->registerSessionEventReceiver(sessionHistoryRecorder);
+			sut->setCompletionTimeEstimator(trainingStatistics);
+		}
+
+		std::filesystem::path StatisticsFolder;
+	};
 
 	TEST_F(UntimedTrainingProgramFlowTestFixture, startUntimedTrainingProgram_when_validProgramIsStarted_will_populateTrainingExecutionData)
 	{
@@ -12,7 +42,7 @@ namespace test
 		sut->startSelectedTrainingProgram();
 
 		// Send one timer tick for every program entry, to make sure the program is still active and did not transition to the next steps
-		for (auto index = 0; index < UntimedTrainingProgram.Entries.size(); index++)
+		for (size_t index = 0; index < UntimedTrainingProgram.Entries.size(); index++)
 		{
 			sendTimerTick(_fakeTimeProvider->CurrentFakeTime + std::chrono::milliseconds(1));
 		}
@@ -33,7 +63,7 @@ namespace test
 		sut->startSelectedTrainingProgram();
 
 		// Send one timer tick for every program entry, to make sure the program is still active and did not transition to the next steps
-		for (auto index = 0; index < UntimedTrainingProgram.Entries.size(); index++)
+		for (size_t index = 0; index < UntimedTrainingProgram.Entries.size(); index++)
 		{
 			sendTimerTick(_fakeTimeProvider->CurrentFakeTime + std::chrono::milliseconds(1));
 		}
@@ -62,4 +92,48 @@ namespace test
 
 		EXPECT_EQ(sut->getCurrentExecutionData().ProgramHasUntimedSteps, false);
 	}
+
+	TEST_F(UntimedTrainingProgramFlowTestFixture, untimedStep_when_packWasCompletedBefore_will_estimateRemainingStepTime)
+	{
+		useTrainingStatistics();
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(UntimedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		EXPECT_FALSE(sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStepIsEstimated);
+
+		completePack(_fakeTimeProvider->CurrentFakeTime + std::chrono::seconds(90));
+		sut->stopRunningTrainingProgram();
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		// The statistics only store an approximation of the completion times
+		const auto maximumDeviation = 90000.0 * statistics::QuantileSketch::RelativeAccuracy;
+		EXPECT_TRUE(sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStepIsEstimated);
+		EXPECT_NEAR((double)sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStep.count(), 90000.0, maximumDeviation);
+
+		sendTimerTick(startTime + std::chrono::seconds(30));
+
+		EXPECT_NEAR((double)sut->getCurrentExecutionData().TimeLeftInCurrentTrainingStep.count(), 60000.0, maximumDeviation);
+		EXPECT_EQ(sut->getCurrentExecutionData().TrainingStepNumber, 0); // Running out of estimated time must not end the step
+	}
+
+	TEST_F(UntimedTrainingProgramFlowTestFixture, mixedProgram_when_allUntimedStepsCanBeEstimated_will_estimateRemainingProgramTime)
+	{
+		auto completionTimeEstimator = std::make_shared<FakeCompletionTimeEstimator>();
+		completionTimeEstimator->FakeCompletionTimes[{ MixedTrainingProgramId, 1 }] = std::chrono::seconds(90);
+		sut->setCompletionTimeEstimator(completionTimeEstimator);
+		sut->receiveListData(FullTrainingProgramList);
+		sut->selectTrainingProgram(MixedTrainingProgramId);
+		sut->startSelectedTrainingProgram();
+		auto startTime = _fakeTimeProvider->CurrentFakeTime;
+
+		auto expectedPackTime = std::chrono::seconds(90);
+		auto expectedProgramTime = OneMinuteFreeplayEntry.Duration + expectedPackTime + OneMinuteWorkshopEntry.Duration + TwoMinuteDefaultEntry.Duration;
+		EXPECT_TRUE(sut->getCurrentExecutionData().TimeLeftInProgramIsEstimated);
+		EXPECT_EQ(sut->getCurrentExecutionData().TimeLeftInProgram, expectedProgramTime);
+
+		sendTimerTick(startTime + std::chrono::seconds(10));
+
+		EXPECT_EQ(sut->getCurrentExecutionData().TimeLeftInProgram, expectedProgramTime - std::chrono::seconds(10));
+	}
 }
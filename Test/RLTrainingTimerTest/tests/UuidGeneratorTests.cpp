@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <Plugin/configuration/control/uuid_generator.h>
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace test
+{
+	TEST(UuidGeneratorTests, generate_when_called_will_createVersion4Uuid)
+	{
+		for (int repetition = 0; repetition < 100; repetition++)
+		{
+			const auto id = uuid_generator::generate();
+			EXPECT_EQ(id.version(), uuids::uuid_version::random_number_based);
+			EXPECT_EQ(id.variant(), uuids::uuid_variant::rfc);
+		}
+	}
+
+	TEST(UuidGeneratorTests, generateUUID_when_called_will_formatUuidAsString)
+	{
+		const auto text = uuid_generator::generateUUID();
+
+		ASSERT_EQ(text.size(), 36);
+		const auto parsedId = uuids::uuid::from_string(text);
+		ASSERT_TRUE(parsedId.has_value());
+		EXPECT_EQ(uuids::to_string(parsedId.value()), text);
+	}
+
+	TEST(UuidGeneratorTests, generate_when_generatingInBulk_will_createUniqueIds)
+	{
+		const size_t NumberOfIds = 10000;
+
+		const auto ids = uuid_generator::generate(NumberOfIds);
+
+		ASSERT_EQ(ids.size(), NumberOfIds);
+		EXPECT_EQ(std::set<uuids::uuid>(ids.begin(), ids.end()).size(), NumberOfIds);
+	}
+
+	TEST(UuidGeneratorTests, generate_when_calledOnSeveralThreads_will_createUniqueIds)
+	{
+		const size_t NumberOfThreads = 4;
+		const size_t IdsPerThread = 2500;
+
+		std::mutex idsMutex;
+		std::set<uuids::uuid> ids;
+		std::vector<std::thread> threads;
+		for (size_t threadNumber = 0; threadNumber < NumberOfThreads; threadNumber++)
+		{
+			threads.emplace_back([&]() {
+				auto threadIds = std::vector<uuids::uuid>();
+				for (size_t idNumber = 0; idNumber < IdsPerThread; idNumber++)
+				{
+					threadIds.push_back(uuid_generator::generate());
+				}
+				std::lock_guard<std::mutex> lock(idsMutex);
+				ids.insert(threadIds.begin(), threadIds.end());
+			});
+		}
+		for (auto& thread : threads) { thread.join(); }
+
+		EXPECT_EQ(ids.size(), NumberOfThreads * IdsPerThread);
+	}
+}
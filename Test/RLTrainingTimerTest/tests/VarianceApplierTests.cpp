@@ -0,0 +1,99 @@
+#include "../fixtures/TrainingProgramFlowTestFixture.h"
+
+#include <Plugin/training/control/VarianceApplier.h>
+
+namespace test
+{
+	configuration::VarianceSettings createVarianceSettings(const std::string& varSpeed, const std::string& shuffle)
+	{
+		configuration::VarianceSettings settings;
+		settings.UseDefaultSettings = false;
+		settings.VarSpeed = varSpeed;
+		settings.Shuffle = shuffle;
+		return settings;
+	}
+
+	std::string readFakeCvar(const std::string& cvarName)
+	{
+		return cvarName + "_original";
+	}
+
+	TEST(VarianceApplierTests, parse_when_valuesAreSet_will_defineOnlyValidValues)
+	{
+		auto settings = createVarianceSettings("12.5", "true");
+		settings.PlayerVelocity = "(500, 1500)";
+		settings.VarLoc = "not a number";
+
+		auto variance = training::VarianceApplier::parse(settings);
+
+		EXPECT_TRUE(variance.isDefined(training::VarianceSetting::VarSpeed));
+		EXPECT_EQ(variance.Values[(size_t)training::VarianceSetting::VarSpeed], 12.5f);
+		EXPECT_EQ(variance.Values[(size_t)training::VarianceSetting::Shuffle], 1.0f);
+		EXPECT_EQ(variance.Values[(size_t)training::VarianceSetting::PlayerVelocity], 500.0f);
+		EXPECT_EQ(variance.PlayerVelocityMax, 1500.0f);
+		EXPECT_FALSE(variance.isDefined(training::VarianceSetting::VarLoc));
+		EXPECT_FALSE(variance.isDefined(training::VarianceSetting::EnableTraining));
+	}
+
+	TEST(VarianceApplierTests, parse_when_defaultSettingsAreUsed_will_defineNothing)
+	{
+		auto settings = createVarianceSettings("12.5", "1");
+		settings.UseDefaultSettings = true;
+
+		EXPECT_EQ(training::VarianceApplier::parse(settings).DefinedSettings, 0);
+	}
+
+	TEST(VarianceApplierTests, createCommands_when_onlyOneValueChanges_will_createOneCommand)
+	{
+		training::VarianceApplier applier;
+		auto firstCommands = applier.createCommands(training::VarianceApplier::parse(createVarianceSettings("10", "1")), readFakeCvar);
+		auto secondCommands = applier.createCommands(training::VarianceApplier::parse(createVarianceSettings("20", "1")), readFakeCvar);
+
+		EXPECT_EQ(firstCommands.size(), 2);
+		ASSERT_EQ(secondCommands.size(), 1);
+		EXPECT_EQ(secondCommands[0], "sv_training_var_speed 20");
+	}
+
+	TEST(VarianceApplierTests, createRestoreCommands_when_valuesWereChanged_will_restoreOriginalValues)
+	{
+		training::VarianceApplier applier;
+		applier.createCommands(training::VarianceApplier::parse(createVarianceSettings("10", "")), readFakeCvar);
+		applier.createCommands(training::VarianceApplier::parse(createVarianceSettings("20", "")), readFakeCvar);
+
+		auto restoreCommands = applier.createRestoreCommands();
+
+		ASSERT_EQ(restoreCommands.size(), 1);
+		EXPECT_EQ(restoreCommands[0], "sv_training_var_speed \"sv_training_var_speed_original\"");
+		EXPECT_TRUE(applier.createRestoreCommands().empty());
+	}
+
+	TEST_F(TrainingProgramFlowTestFixture, activateNextTrainingProgramStep_when_stepHasVariance_will_applyItWithTheLoadCommand)
+	{
+		auto packEntry = PackCompletionEntry;
+		packEntry.Variance = createVarianceSettings("15", "1");
+		configuration::TrainingProgramData program;
+		program.Id = "VarianceProgram";
+		program.Entries = { packEntry, OneMinuteFreeplayEntry };
+		configuration::TrainingProgramListData list;
+		list.TrainingProgramData.try_emplace(program.Id, program);
+		list.TrainingProgramOrder.push_back(program.Id);
+		_fakeCVarManager->FakeCvarValues["sv_training_var_speed"] = "0";
+		_fakeCVarManager->FakeCvarValues["sv_training_shuffle"] = "0";
+
+		sut->receiveListData(list);
+		sut->selectTrainingProgram(program.Id);
+		sut->startSelectedTrainingProgram();
+		EXPECT_EQ(_fakeCVarManager->executedCommands(), std::vector<std::string>({
+			"sv_training_var_speed 15",
+			"sv_training_shuffle 1",
+			"load_training " + DummyTrainingPackCode }));
+
+		sut->activateNextTrainingProgramStep(); // The freeplay step does not define variance
+		sut->stopRunningTrainingProgram();
+
+		EXPECT_EQ(_fakeCVarManager->executedCommands().size(), 6);
+		EXPECT_EQ(_fakeCVarManager->executedCommands()[3], "sv_training_var_speed \"0\"");
+		EXPECT_EQ(_fakeCVarManager->executedCommands()[4], "sv_training_shuffle \"0\"");
+		EXPECT_EQ(_fakeCVarManager->executedCommands()[5], "load_freeplay");
+	}
+}
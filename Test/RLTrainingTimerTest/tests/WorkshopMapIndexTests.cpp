@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <Plugin/configuration/control/WorkshopMapIndex.h>
+
+#include <fstream>
+#include <random>
+
+namespace test
+{
+	class WorkshopMapIndexTests : public testing::Test
+	{
+	public:
+		void SetUp() override
+		{
+			WorkshopFolder = std::filesystem::temp_directory_path() / ("RLTrainingTimerWorkshopTest_" + std::to_string(std::random_device()()));
+			createFile("Lethamyr/LethamyrRings.udk");
+			createFile("Lethamyr/Preview.jpg");
+			createFile("Obstacles/ObstacleCourse.UPK");
+			createFile("Dribbling/Nested/DribbleChallenge.udk");
+			sut = std::make_unique<configuration::WorkshopMapIndex>();
+		}
+
+		void TearDown() override
+		{
+			sut.reset();
+			std::filesystem::remove_all(WorkshopFolder);
+		}
+
+	protected:
+		void createFile(const std::string& relativePath)
+		{
+			auto path = WorkshopFolder / std::filesystem::path(relativePath);
+			std::filesystem::create_directories(path.parent_path());
+			std::ofstream{ path } << "map";
+		}
+
+		void scan()
+		{
+			sut->requestScan(WorkshopFolder.string());
+			sut->waitForScans();
+		}
+
+		static std::string nativePath(const std::string& relativePath)
+		{
+			return std::filesystem::path(relativePath).make_preferred().string();
+		}
+
+		std::filesystem::path WorkshopFolder;
+		std::unique_ptr<configuration::WorkshopMapIndex> sut;
+	};
+
+	TEST_F(WorkshopMapIndexTests, containsMap_when_noScanHasFinished_will_returnNothing)
+	{
+		EXPECT_FALSE(sut->containsMap("Lethamyr/LethamyrRings.udk").has_value());
+	}
+
+	TEST_F(WorkshopMapIndexTests, scan_when_folderContainsMapsAndOtherFiles_will_onlyIndexMaps)
+	{
+		scan();
+
+		EXPECT_EQ(sut->numberOfMaps(), 3);
+		EXPECT_EQ(sut->containsMap("Lethamyr\\LethamyrRings.udk"), true);
+		EXPECT_EQ(sut->containsMap("obstacles/obstaclecourse.upk"), true);
+		EXPECT_EQ(sut->containsMap("Dribbling/Nested/DribbleChallenge.udk"), true);
+		EXPECT_EQ(sut->containsMap("Lethamyr/Preview.jpg"), false);
+	}
+
+	TEST_F(WorkshopMapIndexTests, rescan_when_mapsWereAddedAndRemoved_will_updateIndex)
+	{
+		scan();
+		createFile("Lethamyr/LethamyrTunnel.udk");
+		std::filesystem::remove_all(WorkshopFolder / "Obstacles");
+
+		sut->requestRescan();
+		sut->waitForScans();
+
+		EXPECT_EQ(sut->containsMap("Lethamyr/LethamyrTunnel.udk"), true);
+		EXPECT_EQ(sut->containsMap("Obstacles/ObstacleCourse.UPK"), false);
+		EXPECT_EQ(sut->numberOfMaps(), 3);
+		EXPECT_EQ(sut->numberOfCompletedScans(), 2);
+	}
+
+	TEST_F(WorkshopMapIndexTests, findMatches_when_textIsAbbreviated_will_rankBestMatchFirst)
+	{
+		scan();
+
+		auto matches = sut->findMatches("lethrings", 5);
+
+		ASSERT_EQ(matches.size(), 1);
+		EXPECT_EQ(matches[0], nativePath("Lethamyr/LethamyrRings.udk"));
+	}
+
+	TEST_F(WorkshopMapIndexTests, findMatches_when_textIsEmpty_will_returnAllMapsUpToLimit)
+	{
+		scan();
+
+		auto matches = sut->findMatches("", 2);
+
+		EXPECT_EQ(matches.size(), 2);
+	}
+}